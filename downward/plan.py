@@ -2,9 +2,14 @@
 
 from __future__ import print_function
 
+import os
 import subprocess
 import sys
 
+from task_cache import TaskCache, source_files
+
+TRANSLATE_OPTIONS = []
+
 
 def main():
     def run(*args, **kwargs):
@@ -21,14 +26,25 @@ def main():
 
     config, domain, problem, result_name = sys.argv[1:]
 
-    # run translator
-    run("translate/translate.py", domain, problem)
-
-    # run preprocessing
-    run("preprocess/preprocess", input="output.sas")
-
-    # run search
-    run("search/search", config, "p", result_name, input="output")
+    # translated tasks are cached if TFD_CACHE_DIR is set
+    cache = TaskCache.from_environment()
+    cached_files = ["output.sas"]
+    if cache:
+        planner_dir = os.path.dirname(os.path.abspath(__file__))
+        planner_files = source_files(os.path.join(planner_dir, "translate"))
+        key = cache.key([domain, problem], TRANSLATE_OPTIONS, planner_files)
+
+    if cache and cache.fetch(key, cached_files):
+        print("Using cached task %s" % key)
+    else:
+        # run translator
+        run("translate/translate.py", domain, problem, *TRANSLATE_OPTIONS)
+
+        if cache:
+            cache.store(key, cached_files)
+
+    # run preprocessing and search in one process
+    run("search/tfd", "-i", "output.sas", config, "p", result_name)
 
 
 if __name__ == "__main__":
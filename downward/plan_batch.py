@@ -0,0 +1,263 @@
+#! /usr/bin/env python
+"""Solve many problems of one domain in parallel.
+
+Usage: plan_batch.py [options] <domain> <problem or directory>...
+
+The domain is parsed once and the translator is imported once in the
+driver process. Every problem is solved in a process forked from it, so
+the translator starts warm and its global state (which is modified during
+translation) never leaks from one problem to the next. Preprocessing and
+search run in one child process (tfd) of that worker.
+
+For every problem a directory <output dir>/<problem name> is created with
+the translated task, the planner output (log) and the plans. The results
+of all problems are written to <output dir>/results.csv.
+"""
+
+from __future__ import print_function
+
+import csv
+import glob
+import multiprocessing
+import optparse
+import os
+import resource
+import signal
+import subprocess
+import sys
+import time
+
+PLANNER_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(PLANNER_DIR, "translate"))
+
+from pddl import pddl_file
+from pddl import tasks
+import translate
+
+DEFAULT_CONFIG = "y+Y+a+e+r+O+1+C+1+b"
+RESULT_FIELDS = ["problem", "status", "exit_code", "makespan", "plan_length",
+                 "expansions", "time", "memory_mb"]
+# seconds granted after the time limit before the search is killed
+KILL_GRACE_SECONDS = 5
+
+# set in the driver process before the workers are forked
+DOMAIN = None
+OPTIONS = None
+
+
+class Timeout(Exception):
+    pass
+
+
+def _raise_timeout(signum, frame):
+    raise Timeout()
+
+
+def main():
+    global DOMAIN, OPTIONS
+    parser = optparse.OptionParser(
+        usage="%prog [options] <domain> <problem or directory>...")
+    parser.add_option("-j", "--workers", type="int", default=1,
+                      help="number of problems solved in parallel [%default]")
+    parser.add_option("-c", "--config", default=DEFAULT_CONFIG,
+                      help="search options separated by '+' [%default]")
+    parser.add_option("-o", "--output-dir", default="batch",
+                      help="directory for plans and results [%default]")
+    parser.add_option("-t", "--time-limit", type="int", default=0,
+                      help="wall clock seconds per problem, 0 for none")
+    parser.add_option("-m", "--memory-limit", type="int", default=0,
+                      help="address space MB per problem, 0 for none")
+    OPTIONS, args = parser.parse_args()
+    if len(args) < 2 or OPTIONS.workers < 1:
+        parser.error("need a domain, at least one problem and at least one worker")
+    domain_file = os.path.abspath(args[0])
+    problems = find_problems(args[1:], domain_file)
+    if not problems:
+        parser.error("no problem files found")
+    check_unique_names(problems)
+    OPTIONS.output_dir = os.path.abspath(OPTIONS.output_dir)
+    if not os.path.isdir(OPTIONS.output_dir):
+        os.makedirs(OPTIONS.output_dir)
+
+    import builtins
+    builtins.containsQuantifiedConditions = False
+    DOMAIN = tuple(tasks.parse_domain(
+        pddl_file.parse_pddl_file("domain", domain_file)))
+
+    # fork a fresh worker for every problem (maxtasksperchild=1), the
+    # workers inherit the parsed domain
+    pool = multiprocessing.get_context("fork").Pool(OPTIONS.workers, maxtasksperchild=1)
+    results = {}
+    try:
+        for result in pool.imap_unordered(solve, problems):
+            results[result["problem"]] = result
+            print("%(problem)s: %(status)s, makespan %(makespan)s, "
+                  "%(time)s s, %(memory_mb)s MB" % result)
+    except KeyboardInterrupt:
+        pool.terminate()
+        raise
+    pool.close()
+    pool.join()
+
+    results_file = os.path.join(OPTIONS.output_dir, "results.csv")
+    with open(results_file, "w") as output:
+        writer = csv.DictWriter(output, RESULT_FIELDS)
+        writer.writerow(dict((field, field) for field in RESULT_FIELDS))
+        for problem in problems:
+            writer.writerow(results[problem_name(problem)])
+    solved = sum(1 for result in results.values() if result["status"] == "solved")
+    print("Solved %d of %d problems, results in %s." % (solved, len(problems), results_file))
+
+
+def find_problems(paths, domain_file):
+    """Problem files given directly or found (*.pddl) in the given directories."""
+    problems = []
+    for path in paths:
+        if os.path.isdir(path):
+            for name in sorted(glob.glob(os.path.join(path, "*.pddl"))):
+                name = os.path.abspath(name)
+                if name != domain_file and "domain" not in os.path.basename(name):
+                    problems.append(name)
+        else:
+            problems.append(os.path.abspath(path))
+    return problems
+
+
+def problem_name(problem):
+    return os.path.splitext(os.path.basename(problem))[0]
+
+
+def check_unique_names(problems):
+    names = set()
+    for problem in problems:
+        if problem_name(problem) in names:
+            raise SystemExit("Error: problem name %s is not unique." % problem_name(problem))
+        names.add(problem_name(problem))
+
+
+def solve(problem):
+    """Solve the problem in its directory (runs in a worker process)."""
+    name = problem_name(problem)
+    directory = os.path.join(OPTIONS.output_dir, name)
+    if not os.path.isdir(directory):
+        os.makedirs(directory)
+    os.chdir(directory)
+    for old_plan in glob.glob("plan*"):
+        os.remove(old_plan)
+
+    # all output of the translator and the planner goes to the log
+    sys.stdout.flush()
+    sys.stderr.flush()
+    log = os.open("log", os.O_WRONLY | os.O_CREAT | os.O_TRUNC, 0o644)
+    os.dup2(log, 1)
+    os.dup2(log, 2)
+    os.close(log)
+
+    if OPTIONS.memory_limit:
+        limit = OPTIONS.memory_limit * 1024 * 1024
+        resource.setrlimit(resource.RLIMIT_AS, (limit, limit))
+    signal.signal(signal.SIGALRM, _raise_timeout)
+    if OPTIONS.time_limit:
+        signal.alarm(OPTIONS.time_limit + KILL_GRACE_SECONDS)
+
+    start = time.time()
+    status, exit_code = "error", None
+    try:
+        status, exit_code = run_planner(problem, start)
+    except Timeout:
+        status = "timeout"
+    except MemoryError:
+        status = "memout"
+    except (Exception, SystemExit) as e:
+        print("Error: %s" % e)
+    signal.alarm(0)
+    elapsed = time.time() - start
+
+    plan_files = find_plan_files()
+    makespan, plan_length = "", ""
+    if plan_files:
+        makespan, plan_length = read_plan(plan_files[-1])
+        status = "solved"
+    memory_kb = max(resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+                    resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss)
+    sys.stdout.flush()
+    return {"problem": name, "status": status,
+            "exit_code": "" if exit_code is None else exit_code,
+            "makespan": makespan, "plan_length": plan_length,
+            "expansions": read_expansions("log"),
+            "time": "%.2f" % elapsed, "memory_mb": "%.1f" % (memory_kb / 1024.0)}
+
+
+def run_planner(problem, start):
+    """Translate, preprocess and search. Returns status and exit code of the search."""
+    print("Parsing...")
+    task = tasks.Task.from_domain(DOMAIN, pddl_file.parse_pddl_file("task", problem))
+    translate.translate(task)
+    sys.stdout.flush()
+
+    search_options = OPTIONS.config.split("+")
+    if OPTIONS.time_limit:
+        # let the search stop by itself and keep its best plan
+        remaining = str(max(1, int(OPTIONS.time_limit - (time.time() - start))))
+        search_options += ["t", remaining, "T", remaining]
+    exit_code = run([os.path.join(PLANNER_DIR, "search", "tfd")] + search_options
+                    + ["p", "plan"], "output.sas")
+    if exit_code == 0:
+        return "solved", exit_code
+    elif exit_code == 1:
+        return "unsolved", exit_code
+    elif exit_code == 137 or exit_code == -signal.SIGXCPU:
+        return "timeout", exit_code
+    elif exit_code == -signal.SIGABRT and OPTIONS.memory_limit:
+        return "memout", exit_code      # std::bad_alloc
+    return "error", exit_code
+
+
+def run(command, input_file):
+    process = subprocess.Popen(command, stdin=open(input_file))
+    try:
+        return process.wait()
+    except Timeout:
+        process.kill()
+        process.wait()
+        raise
+
+
+def find_plan_files():
+    """Plan files written for plan name "plan", the best plan is the last."""
+    numbered = []
+    for name in os.listdir("."):
+        if name == "plan":
+            numbered.append((0, name))
+        elif name.startswith("plan.") and name[5:].isdigit():
+            numbered.append((int(name[5:]), name))
+    return [name for number, name in sorted(numbered)]
+
+
+def read_plan(plan_file):
+    """Makespan and number of steps of the plan."""
+    makespan = 0.0
+    steps = 0
+    with open(plan_file) as plan:
+        for line in plan:
+            line = line.partition(";")[0].strip()
+            if not line:
+                continue
+            start, _, rest = line.partition(":")
+            duration = rest.rpartition("[")[2].rstrip("]")
+            makespan = max(makespan, float(start) + float(duration))
+            steps += 1
+    return "%.8f" % makespan, steps
+
+
+def read_expansions(log_file):
+    expansions = ""
+    with open(log_file) as log:
+        for line in log:
+            if line.startswith("Expanded nodes:"):
+                expansions = line.split()[2]
+    return expansions
+
+
+if __name__ == "__main__":
+    main()
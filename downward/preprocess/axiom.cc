@@ -1,5 +1,6 @@
 #include "helper_functions.h"
 #include "axiom.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <iostream>
@@ -7,7 +8,9 @@
 #include <cassert>
 using namespace std;
 
-Axiom_relational::Axiom_relational(istream &in,
+namespace preprocess {
+
+Axiom_relational::Axiom_relational(Tokenizer &in,
     const vector<Variable *> &variables) {
   check_magic(in, "begin_rule");
   int count; // number of conditions
@@ -65,21 +68,21 @@ void Axiom_relational::dump() const {
   cout << endl;
 }
 
-void Axiom_relational::generate_cpp_input(ofstream &outfile) const {
+void Axiom_relational::generate_cpp_input(TaskWriter &outfile) const {
   assert(effect_var->get_level() != -1);
-  outfile << "begin_rule" << endl;
-  outfile << conditions.size() << endl;
+  outfile << "begin_rule" << '\n';
+  outfile << conditions.size() << '\n';
   for(int i = 0; i < conditions.size(); i++) {
     assert(conditions[i].var->get_level() != -1);
     outfile << conditions[i].var->get_level() << " "<< conditions[i].cond
-	<< endl;
+	<< '\n';
   }
   outfile << effect_var->get_level() << " " << old_val << " " << effect_val
-      << endl;
-  outfile << "end_rule" << endl;
+      << '\n';
+  outfile << "end_rule" << '\n';
 }
 
-Axiom_functional::Axiom_functional(istream &in,
+Axiom_functional::Axiom_functional(Tokenizer &in,
     const vector<Variable *> &variables, bool comparison) {
   this->comparison = false;
   int varNo, varNo1, varNo2;
@@ -125,7 +128,7 @@ void Axiom_functional::dump() const {
   cout << endl;
 }
 
-void Axiom_functional::generate_cpp_input(ofstream &outfile) const {
+void Axiom_functional::generate_cpp_input(TaskWriter &outfile) const {
   assert(effect_var->get_level() != -1);
   outfile << effect_var->get_level() << " ";
   if(is_comparison()) {
@@ -133,5 +136,7 @@ void Axiom_functional::generate_cpp_input(ofstream &outfile) const {
   } else {
       outfile << fop;
   }
-  outfile << " " << left_var->get_level() << " " << right_var->get_level() << endl;
+  outfile << " " << left_var->get_level() << " " << right_var->get_level() << '\n';
+}
+
 }
@@ -5,9 +5,14 @@
 #include <fstream>
 #include <string>
 #include <vector>
+
+#include "tokenizer.h"
 using namespace std;
 
+namespace preprocess {
+
 class Variable;
+class TaskWriter;
 
 struct Condition {
   Variable *var;
@@ -26,11 +31,11 @@ private:
   int effect_val;
   vector<Condition> conditions; // var, val
 public:
-  Axiom_relational(istream &in, const vector<Variable *> &variables);
+  Axiom_relational(Tokenizer &in, const vector<Variable *> &variables);
 
   bool is_redundant() const;
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
   const vector<Condition> &get_conditions() const {
     return conditions;
   }
@@ -56,13 +61,13 @@ private:
 public:
   foperator fop;
   compoperator cop;
-      Axiom_functional(istream &in, const vector<Variable *> &variables,
+      Axiom_functional(Tokenizer &in, const vector<Variable *> &variables,
 	  bool comparison);
 
   bool is_redundant() const;
 
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
   Variable* get_effect_var() const {
     return effect_var;
   }
@@ -90,4 +95,6 @@ extern void strip_Axiom_relationals(vector<Axiom_relational> &axioms_rel);
 
 extern void strip_Axiom_functionals(vector<Axiom_functional> &axioms_func);
 
+}
+
 #endif
@@ -23,6 +23,7 @@
  */
 
 #include "causal_graph.h"
+#include "task_writer.h"
 #include "max_dag.h"
 #include "operator.h"
 #include "axiom.h"
@@ -33,6 +34,8 @@
 #include <cassert>
 using namespace std;
 
+namespace preprocess {
+
 bool g_do_not_prune_variables = false;
 
 void CausalGraph::weigh_graph_from_ops(const vector<Variable *> &,
@@ -402,7 +405,7 @@ void CausalGraph::dump() const {
 	  << endl;
   }
 }
-void CausalGraph::generate_cpp_input(ofstream &outfile,
+void CausalGraph::generate_cpp_input(TaskWriter &outfile,
     const vector<Variable *> & ordered_vars) const {
   //TODO: use const iterator!
   vector<WeightedSuccessors *> succs; // will be ordered like ordered_vars
@@ -430,7 +433,7 @@ void CausalGraph::generate_cpp_input(ofstream &outfile,
   for(int i = 0; i < ordered_vars.size(); i++) {
     WeightedSuccessors *curr = succs[i];
     // print number of variables influenced by variable i
-    outfile << number_of_succ[i] << endl;
+    outfile << number_of_succ[i] << '\n';
     for(WeightedSuccessors::const_iterator it = curr->begin(); it
 	!= curr->end(); ++it) {
       if(it->first->get_level() != -1
@@ -438,8 +441,9 @@ void CausalGraph::generate_cpp_input(ofstream &outfile,
       )
 	// the variable it->first is important and influenced by variable i
 	// print level
-	outfile << it->first->get_level() << endl;
+	outfile << it->first->get_level() << '\n';
     }
   }
 }
 
+}
@@ -6,10 +6,13 @@
 #include <map>
 using namespace std;
 
+namespace preprocess {
+
 class Operator;
 class Axiom_relational;
 class Axiom_functional;
 class Variable;
+class TaskWriter;
 
 class CausalGraph {
   const vector<Variable *> &variables;
@@ -57,10 +60,12 @@ public:
   const vector<Variable *> &get_variable_ordering() const;
   bool is_acyclic() const;
   void dump() const;
-  void generate_cpp_input(ofstream &outfile,
+  void generate_cpp_input(TaskWriter &outfile,
       const vector<Variable *> & ordered_vars) const;
 };
 
 extern bool g_do_not_prune_variables;
 
+}
+
 #endif
@@ -11,6 +11,8 @@
 #include <iostream>
 using namespace std;
 
+namespace preprocess {
+
 void build_DTGs(const vector<Variable *> &var_order,
     const vector<Operator> &operators,
     const vector<Axiom_relational> &axioms_rel,
@@ -179,3 +181,5 @@ bool are_DTGs_strongly_connected(
       connected = false;
   return connected;
 }
+
+}
@@ -7,8 +7,11 @@
 
 using namespace std;
 
+namespace preprocess {
+
 class Axiom_relational;
 class Variable;
+class TaskWriter;
 
 class DomainTransitionGraph {
 public:
@@ -38,7 +41,7 @@ public:
       int ax_index) = 0;
   virtual void finalize() = 0;
   virtual void dump() const = 0;
-  virtual void generate_cpp_input(ofstream &outfile) const = 0;
+  virtual void generate_cpp_input(TaskWriter &outfile) const = 0;
   virtual bool is_strongly_connected() const = 0;
 
 };
@@ -50,4 +53,6 @@ extern void build_DTGs(const vector<Variable *> &varOrder,
 extern bool are_DTGs_strongly_connected(
     const vector<DomainTransitionGraph*> &transition_graphs);
 
+}
+
 #endif
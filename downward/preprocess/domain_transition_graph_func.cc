@@ -3,12 +3,15 @@
 #include "axiom.h"
 #include "variable.h"
 #include "scc.h"
+#include "task_writer.h"
 
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 using namespace std;
 
+namespace preprocess {
+
 DomainTransitionGraphFunc::DomainTransitionGraphFunc(const Variable &var) {
   //cout << "creating functional DTG for " << var.get_name() << endl;
   transitions.clear();
@@ -140,20 +143,22 @@ void DomainTransitionGraphFunc::dump() const {
   }
 }
 
-void DomainTransitionGraphFunc::generate_cpp_input(ofstream &outfile) const {
-  outfile << transitions.size() << endl;
+void DomainTransitionGraphFunc::generate_cpp_input(TaskWriter &outfile) const {
+  outfile << transitions.size() << '\n';
   for(int i = 0; i < transitions.size(); i++) {
     const Transition &trans = transitions[i];
-    outfile << trans.op << endl; // operator doing the transition
-    outfile << trans.type << endl; //type of transition
-    outfile << trans.fop << " " << trans.right_var->get_level() << endl;
+    outfile << trans.op << '\n'; // operator doing the transition
+    outfile << trans.type << '\n'; //type of transition
+    outfile << trans.fop << " " << trans.right_var->get_level() << '\n';
     //duration
     outfile << trans.duration.op << " " << trans.duration.var->get_level()
-	<< endl;
+	<< '\n';
     //conditions
-    outfile << trans.condition.size() << endl;
+    outfile << trans.condition.size() << '\n';
     for(int k = 0; k < trans.condition.size(); k++)
       outfile << std::tr1::get<0>(trans.condition[k])->get_level() << " "
-	  << std::tr1::get<1>(trans.condition[k]) << " " << std::tr1::get<2>(trans.condition[k]) << endl;
+	  << std::tr1::get<1>(trans.condition[k]) << " " << std::tr1::get<2>(trans.condition[k]) << '\n';
   }
 }
+
+}
@@ -5,6 +5,8 @@
 #include "domain_transition_graph.h"
 using namespace std;
 
+namespace preprocess {
+
 class Axiom_relational;
 class Variable;
 
@@ -33,8 +35,10 @@ public:
       int ax_index);
   void finalize();
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
   bool is_strongly_connected() const;
 };
 
+}
+
 #endif
@@ -4,12 +4,15 @@
 #include "variable.h"
 #include "scc.h"
 #include "helper_functions.h"
+#include "task_writer.h"
 
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 using namespace std;
 
+namespace preprocess {
+
 DomainTransitionGraphSubterm::DomainTransitionGraphSubterm(const Variable &var) {
  // cout << "creating subterm DTG for " << var.get_name() << endl;
   level = var.get_level();
@@ -69,17 +72,18 @@ void DomainTransitionGraphSubterm::dump() const {
   cout << " " << right_var->get_name() << endl;
 }
 
-void DomainTransitionGraphSubterm::generate_cpp_input(ofstream &outfile) const {
+void DomainTransitionGraphSubterm::generate_cpp_input(TaskWriter &outfile) const {
   if(!is_comparison) {
     outfile << left_var->get_level() << " " << fop << " "
-	<< right_var->get_level() << endl;
+	<< right_var->get_level() << '\n';
   } else {
-    outfile << "1" << endl;
+    outfile << "1" << '\n';
     outfile << left_var->get_level() << " " << get_inverse_op(cop) << " "
-	<< right_var->get_level() << endl;
-    outfile << "0" << endl;
+	<< right_var->get_level() << '\n';
+    outfile << "0" << '\n';
     outfile << left_var->get_level() << " " << cop << " "
-	<< right_var->get_level() << endl;
+	<< right_var->get_level() << '\n';
   }
 }
 
+}
@@ -13,12 +13,15 @@
 #include "axiom.h"
 #include "variable.h"
 #include "scc.h"
+#include "task_writer.h"
 
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 using namespace std;
 
+namespace preprocess {
+
 DomainTransitionGraphSymb::DomainTransitionGraphSymb(const Variable &var) {
   //cout << "creating symbolical DTG for " << var.get_name() << endl;
   int range = var.get_range();
@@ -210,8 +213,8 @@ void DomainTransitionGraphSymb::finalize() {
 	  assert(other_trans.target >= trans.target);
 	  if(other_trans.target != trans.target)
 	    break; // transition and all after it have different targets
-	  if(other_trans.duration.var->get_level()
-	      != trans.duration.var->get_level())
+	  // axiom transitions have no duration variable
+	  if(other_trans.duration.var != trans.duration.var)
 	    break; // transition and all after it have different durations
 	  else { //domination possible
 	    if(other_trans.condition.size() < cond.size()) {
@@ -306,39 +309,40 @@ void DomainTransitionGraphSymb::dump() const {
   }
 }
 
-void DomainTransitionGraphSymb::generate_cpp_input(ofstream &outfile) const {
-  //outfile << vertices.size() << endl; // the variable's range
+void DomainTransitionGraphSymb::generate_cpp_input(TaskWriter &outfile) const {
+  //outfile << vertices.size() << '\n'; // the variable's range
   for(int i = 0; i < vertices.size(); i++) {
-    outfile << vertices[i].size() << endl; // number of transitions from this value
+    outfile << vertices[i].size() << '\n'; // number of transitions from this value
     for(int j = 0; j < vertices[i].size(); j++) {
       const Transition &trans = vertices[i][j];
-      outfile << trans.target << endl; // target of transition
-      outfile << trans.op << endl; // operator doing the transition
+      outfile << trans.target << '\n'; // target of transition
+      outfile << trans.op << '\n'; // operator doing the transition
       //duration:
       if(trans.type==compressed)
-          outfile << "c" << endl;
+          outfile << "c" << '\n';
       else if(trans.type ==start)
-	outfile << "s" << endl;
+	outfile << "s" << '\n';
       else if(trans.type==end)
-	outfile << "e" << endl;
+	outfile << "e" << '\n';
       else {
         assert(trans.type==ax_rel);
-	outfile << "a" << endl;
+	outfile << "a" << '\n';
       }
       if(trans.type == start || trans.type == end || trans.type == compressed)
 	outfile << trans.duration.op << " " << trans.duration.var->get_level()
-	    << endl;
+	    << '\n';
       // calculate number of important prevail conditions
       int number = 0;
       for(int k = 0; k < trans.condition.size(); k++)
 	if(std::tr1::get<0>(trans.condition[k])->get_level() != -1)
 	  number++;
-      outfile << number << endl;
+      outfile << number << '\n';
       for(int k = 0; k < trans.condition.size(); k++)
 	if(std::tr1::get<0>(trans.condition[k])->get_level() != -1)
 	  outfile << std::tr1::get<0>(trans.condition[k])->get_level() << " "
-	      << std::tr1::get<1>(trans.condition[k]) << " " << std::tr1::get<2>(trans.condition[k]) << endl; // condition: var, val
+	      << std::tr1::get<1>(trans.condition[k]) << " " << std::tr1::get<2>(trans.condition[k]) << '\n'; // condition: var, val
     }
   }
 }
 
+}
@@ -7,6 +7,8 @@
 #include "operator.h"
 using namespace std;
 
+namespace preprocess {
+
 class Axiom_relational;
 class Variable;
 
@@ -42,8 +44,10 @@ public:
       int ax_index);
   void finalize();
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
   bool is_strongly_connected() const;
 };
 
+}
+
 #endif
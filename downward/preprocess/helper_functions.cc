@@ -14,8 +14,11 @@ using namespace std;
 #include "variable.h"
 #include "successor_generator.h"
 #include "domain_transition_graph.h"
+#include "task_writer.h"
 
-void check_magic(istream &in, string magic) {
+namespace preprocess {
+
+void check_magic(Tokenizer &in, string magic) {
   string word;
   in >> word;
   if(word != magic) {
@@ -25,7 +28,7 @@ void check_magic(istream &in, string magic) {
   }
 }
 
-void read_variables(istream &in, vector<Variable> &internal_variables,
+void read_variables(Tokenizer &in, vector<Variable> &internal_variables,
     vector<Variable *> &variables) {
   check_magic(in, "begin_variables");
   int count;
@@ -39,7 +42,7 @@ void read_variables(istream &in, vector<Variable> &internal_variables,
   check_magic(in, "end_variables");
 }
 
-void read_goal(istream &in, const vector<Variable *> &variables,
+void read_goal(Tokenizer &in, const vector<Variable *> &variables,
     vector<pair<Variable*, int> > &goals) {
   check_magic(in, "begin_goal");
   int count;
@@ -59,7 +62,7 @@ void dump_goal(const vector<pair<Variable*, int> > &goals) {
 	<< endl;
 }
 
-void read_operators(istream &in, const vector<Variable *> &variables,
+void read_operators(Tokenizer &in, const vector<Variable *> &variables,
     vector<Operator> &operators) {
   int count;
   in >> count;
@@ -67,7 +70,7 @@ void read_operators(istream &in, const vector<Variable *> &variables,
     operators.push_back(Operator(in, variables));
 }
 
-void read_axioms_rel(istream &in, const vector<Variable *> &variables,
+void read_axioms_rel(Tokenizer &in, const vector<Variable *> &variables,
     vector<Axiom_relational> &axioms_rel) {
   int count;
   in >> count;
@@ -75,7 +78,7 @@ void read_axioms_rel(istream &in, const vector<Variable *> &variables,
     axioms_rel.push_back(Axiom_relational(in, variables));
 }
 
-void read_axioms_comp(istream &in, const vector<Variable *> &variables,
+void read_axioms_comp(Tokenizer &in, const vector<Variable *> &variables,
     vector<Axiom_functional> &axioms_func) {
   int count;
   in >> count;
@@ -83,7 +86,7 @@ void read_axioms_comp(istream &in, const vector<Variable *> &variables,
     axioms_func.push_back(Axiom_functional(in, variables, true));
 }
 
-void read_axioms_func(istream &in, const vector<Variable *> &variables,
+void read_axioms_func(Tokenizer &in, const vector<Variable *> &variables,
     vector<Axiom_functional> &axioms_func) {
   int count;
   in >> count;
@@ -91,11 +94,12 @@ void read_axioms_func(istream &in, const vector<Variable *> &variables,
     axioms_func.push_back(Axiom_functional(in, variables, false));
 }
 
-void read_contains_quantified_conditions(istream &in, bool& contains_quantified_conditions) {
-  in >> contains_quantified_conditions;
+void read_contains_quantified_conditions(Tokenizer &in, bool& contains_quantified_conditions) {
+  if(!in.at_end())  // missing in old translator output
+    in >> contains_quantified_conditions;
 }
 
-void read_preprocessed_problem_description(istream &in,
+void read_preprocessed_problem_description(Tokenizer &in,
     vector<Variable> &internal_variables, vector<Variable *> &variables,
     State &initial_state, vector<pair<Variable*, int> > &goals,
     vector<Operator> &operators, vector<Axiom_relational> &axioms_rel,
@@ -141,7 +145,7 @@ void dump_DTGs(const vector<Variable *> &ordering,
   }
 }
 
-void generate_cpp_input(bool solveable_in_poly_time,
+void generate_cpp_input(TaskWriter &outfile, bool solveable_in_poly_time,
     const vector<Variable *> & ordered_vars, const State &initial_state,
     const vector<pair<Variable*, int> > &goals,
     const vector<Operator> & operators,
@@ -150,21 +154,19 @@ void generate_cpp_input(bool solveable_in_poly_time,
     const vector<DomainTransitionGraph*> transition_graphs,
     const CausalGraph &cg,
     bool contains_quantified_conditions) {
-  ofstream outfile;
-  outfile.open("output", ios::out);
-  outfile << solveable_in_poly_time << endl; // 1 if true, else 0
+  outfile << solveable_in_poly_time << '\n'; // 1 if true, else 0
   int var_count = ordered_vars.size();
-  outfile << "begin_variables" << endl;
-  outfile << var_count << endl;
+  outfile << "begin_variables" << '\n';
+  outfile << var_count << '\n';
   for(int i = 0; i < var_count; i++)
     outfile << ordered_vars[i]->get_name() << " "
 	<< ordered_vars[i]->get_range() << " " << ordered_vars[i]->get_layer()
-	<< endl;
-  outfile << "end_variables" << endl;
-  outfile << "begin_state" << endl;
+	<< '\n';
+  outfile << "end_variables" << '\n';
+  outfile << "begin_state" << '\n';
   for(int i = 0; i < var_count; i++)
-    outfile << initial_state[ordered_vars[i]] << endl; // for axioms default value
-  outfile << "end_state" << endl;
+    outfile << initial_state[ordered_vars[i]] << '\n'; // for axioms default value
+  outfile << "end_state" << '\n';
 
   vector<int> ordered_goal_values;
   ordered_goal_values.resize(var_count, -1);
@@ -172,44 +174,42 @@ void generate_cpp_input(bool solveable_in_poly_time,
     int var_index = goals[i].first->get_level();
     ordered_goal_values[var_index] = goals[i].second;
   }
-  outfile << "begin_goal" << endl;
-  outfile << goals.size() << endl;
+  outfile << "begin_goal" << '\n';
+  outfile << goals.size() << '\n';
   for(int i = 0; i < var_count; i++)
     if(ordered_goal_values[i] != -1)
-      outfile << i << " " << ordered_goal_values[i] << endl;
-  outfile << "end_goal" << endl;
+      outfile << i << " " << ordered_goal_values[i] << '\n';
+  outfile << "end_goal" << '\n';
 
-  outfile << operators.size() << endl;
+  outfile << operators.size() << '\n';
   for(int i = 0; i < operators.size(); i++)
     operators[i].generate_cpp_input(outfile);
 
-  outfile << axioms_rel.size() << endl;
+  outfile << axioms_rel.size() << '\n';
   for(int i = 0; i < axioms_rel.size(); i++)
     axioms_rel[i].generate_cpp_input(outfile);
 
-  outfile << axioms_func.size() << endl;
+  outfile << axioms_func.size() << '\n';
   for(int i = 0; i < axioms_func.size(); i++)
     axioms_func[i].generate_cpp_input(outfile);
 
-  outfile << "begin_SG" << endl;
+  outfile << "begin_SG" << '\n';
   cout << "printing SG " << endl;
   sg.generate_cpp_input(outfile);
-  outfile << "end_SG" << endl;
+  outfile << "end_SG" << '\n';
 
-  outfile << "begin_CG" << endl;
+  outfile << "begin_CG" << '\n';
   cg.generate_cpp_input(outfile, ordered_vars);
-  outfile << "end_CG" << endl;
+  outfile << "end_CG" << '\n';
 
   cout <<  var_count << endl;
   for(int i = 0; i < var_count; i++) {
-    outfile << "begin_DTG" << endl;
+    outfile << "begin_DTG" << '\n';
     transition_graphs[i]->generate_cpp_input(outfile);
-    outfile << "end_DTG" << endl;
+    outfile << "end_DTG" << '\n';
   }
 
-  outfile << contains_quantified_conditions << endl;
-
-  outfile.close();
+  outfile << contains_quantified_conditions << '\n';
 }
 
 compoperator get_inverse_op(compoperator op) {
@@ -239,7 +239,7 @@ compoperator get_inverse_op(compoperator op) {
   }
 }
 
-istream& operator>>(istream &is, foperator &fop) {
+Tokenizer &operator>>(Tokenizer &is, foperator &fop) {
   string strVal;
   is >> strVal;
   if(!strVal.compare("="))
@@ -281,7 +281,7 @@ ostream& operator<<(ostream &os, const foperator &fop) {
   return os;
 }
 
-istream& operator>>(istream &is, compoperator &fop) {
+Tokenizer &operator>>(Tokenizer &is, compoperator &fop) {
   string strVal;
   is >> strVal;
   if(!strVal.compare("<"))
@@ -328,7 +328,7 @@ ostream& operator<<(ostream &os, const compoperator &fop) {
   return os;
 }
 
-istream& operator>>(istream &is, trans_type &tt) {
+Tokenizer &operator>>(Tokenizer &is, trans_type &tt) {
     string strVal;
     is >> strVal;
     if(!strVal.compare("s"))
@@ -367,7 +367,7 @@ ostream& operator<<(ostream &os, const trans_type &tt) {
     return os;
 }
 
-istream& operator>>(istream &is, condition_type &ct) {
+Tokenizer &operator>>(Tokenizer &is, condition_type &ct) {
   string strVal;
   is >> strVal;
   if(!strVal.compare("s"))
@@ -402,3 +402,5 @@ ostream& operator<<(ostream &os, const condition_type &ct) {
   }
   return os;
 }
+
+}
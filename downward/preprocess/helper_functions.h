@@ -2,6 +2,7 @@
 #define HELPERS_H
 
 #include "state.h"
+#include "tokenizer.h"
 #include "variable.h"
 #include "successor_generator.h"
 #include "causal_graph.h"
@@ -12,6 +13,8 @@
 
 using namespace std;
 
+namespace preprocess {
+
 class State;
 class Operator;
 class Axiom_relational;
@@ -19,7 +22,7 @@ class Axiom_functional;
 class DomainTransitionGraph;
 
 //void read_everything
-void read_preprocessed_problem_description(istream &in,
+void read_preprocessed_problem_description(Tokenizer &in,
     vector<Variable> &internal_variables, vector<Variable *> &variables,
     State &initial_state, vector<pair<Variable*, int> > &goals,
     vector<Operator> &operators, vector<Axiom_relational> &axioms_rel,
@@ -35,7 +38,7 @@ void dump_preprocessed_problem_description(const vector<Variable *> &variables,
 void dump_DTGs(const vector<Variable *> &ordering,
     vector<DomainTransitionGraph*> &transition_graphs);
 
-void generate_cpp_input(bool causal_graph_acyclic,
+void generate_cpp_input(TaskWriter &outfile, bool causal_graph_acyclic,
     const vector<Variable *> & ordered_var, const State &initial_state,
     const vector<pair<Variable*, int> > &goals,
     const vector<Operator> & operators,
@@ -46,28 +49,28 @@ void generate_cpp_input(bool causal_graph_acyclic,
     const CausalGraph &cg,
     bool contains_quantified_conditions);
 
-void check_magic(istream &in, string magic);
+void check_magic(Tokenizer &in, string magic);
 
 enum foperator {assign=0, scale_up=1, scale_down=2, increase=3, decrease=4};
 enum compoperator {lt=0, le=1, eq=2, ge=3, gt=4, ue=5};
 
-istream& operator>>(istream &is, foperator &fop);
+Tokenizer &operator>>(Tokenizer &is, foperator &fop);
 
 ostream& operator<<(ostream &os, const foperator &fop);
 
-istream& operator>>(istream &is, compoperator &fop);
+Tokenizer &operator>>(Tokenizer &is, compoperator &fop);
 
 ostream& operator<<(ostream &os, const compoperator &fop);
 
 enum condition_type {start_cond = 0, overall_cond = 1, end_cond = 2, ax_cond};
 
-istream& operator>>(istream &is, condition_type &fop);
+Tokenizer &operator>>(Tokenizer &is, condition_type &fop);
 
 ostream& operator<<(ostream &os, const condition_type &fop);
 
 enum trans_type {start = 0, end = 1, compressed = 2, ax_rel = 3};
 
-istream& operator>>(istream &is, trans_type &fop);
+Tokenizer &operator>>(Tokenizer &is, trans_type &fop);
 
 ostream& operator<<(ostream &os, const trans_type &fop);
 
@@ -79,7 +82,7 @@ struct DurationCond {
   DurationCond(compoperator o, Variable *v) :
     op(o), var(v) {
   }
-  DurationCond() {}
+  DurationCond() : op(eq), var(0) {}
 };
 
 template<typename T> vector<T> append(vector<T> &first, vector<T> &sec) {
@@ -89,4 +92,6 @@ template<typename T> vector<T> append(vector<T> &first, vector<T> &sec) {
   return first;
 }
 
+}
+
 #endif
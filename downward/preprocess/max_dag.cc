@@ -4,6 +4,8 @@
 #include <iostream>
 using namespace std;
 
+namespace preprocess {
+
 vector<int> MaxDAG::get_result() {
   if(debug){
     for(int i = 0; i < weighted_graph.size(); i++) {
@@ -107,3 +109,5 @@ int main() {
   cout << endl;
 }
 */
+
+}
@@ -7,6 +7,8 @@
 #include <vector>
 using namespace std;
 
+namespace preprocess {
+
 class MaxDAG {
   const vector<vector<pair<int, int> > > &weighted_graph;
   bool debug;
@@ -15,4 +17,6 @@ public:
     debug(false) {}
   vector<int> get_result();
 };
+}
+
 #endif
@@ -1,5 +1,6 @@
 #include "helper_functions.h"
 #include "operator.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <cassert>
@@ -7,10 +8,11 @@
 #include <fstream>
 using namespace std;
 
-Operator::Operator(istream &in, const vector<Variable *> &variables) {
+namespace preprocess {
+
+Operator::Operator(Tokenizer &in, const vector<Variable *> &variables) {
     check_magic(in, "begin_operator");
-    in >> ws;
-    getline(in, name);
+    name = in.read_line();
     int varNo;
     compoperator cop;
     in >> cop >> varNo;
@@ -315,54 +317,54 @@ void strip_operators(vector<Operator> &operators) {
     cout << operators.size() << " of " << old_count << " operators necessary."
 	    << endl;
 }
-void Operator::write_prevails(ofstream &outfile, const vector<Prevail> &prevails) const {
-  outfile << prevails.size() << endl;
+void Operator::write_prevails(TaskWriter &outfile, const vector<Prevail> &prevails) const {
+  outfile << prevails.size() << '\n';
   for(int i = 0; i < prevails.size(); i++) {
     assert(prevails[i].var->get_level() != -1);
     if(prevails[i].var->get_level() != -1)
       outfile << prevails[i].var->get_level() << " "
-      << prevails[i].prev << endl;
+      << prevails[i].prev << '\n';
   }
 }
 
-void Operator::write_effect_conds(ofstream &outfile, const vector<EffCond> &conds) const {
-  outfile << conds.size() << endl;
+void Operator::write_effect_conds(TaskWriter &outfile, const vector<EffCond> &conds) const {
+  outfile << conds.size() << '\n';
   for (int j = 0; j < conds.size(); j++)
-    outfile << conds[j].var->get_level() << " " << conds[j].cond << endl;
+    outfile << conds[j].var->get_level() << " " << conds[j].cond << '\n';
 }
 
-void Operator::write_pre_posts(ofstream &outfile, const vector<PrePost> &pre_posts) const {
-  outfile << pre_posts.size() << endl;
+void Operator::write_pre_posts(TaskWriter &outfile, const vector<PrePost> &pre_posts) const {
+  outfile << pre_posts.size() << '\n';
   for (int i = 0; i < pre_posts.size(); i++) {
     assert(pre_posts[i].var->get_level() != -1);
     write_effect_conds(outfile, pre_posts[i].effect_conds_start);
     write_effect_conds(outfile, pre_posts[i].effect_conds_overall);
     write_effect_conds(outfile, pre_posts[i].effect_conds_end);
     outfile << pre_posts[i].var->get_level() << " " << pre_posts[i].pre << " "
-        << pre_posts[i].post << endl;
+        << pre_posts[i].post << '\n';
   }
 }
 
-void Operator::write_num_effect(ofstream &outfile, const
+void Operator::write_num_effect(TaskWriter &outfile, const
     vector<NumericalEffect> &num_effs) const {
-  outfile << num_effs.size() << endl;
+  outfile << num_effs.size() << '\n';
   for (int i = 0; i < num_effs.size(); i++) {
     assert(num_effs[i].var->get_level() != -1);
     write_effect_conds(outfile, num_effs[i].effect_conds_start);
     write_effect_conds(outfile, num_effs[i].effect_conds_overall);
     write_effect_conds(outfile, num_effs[i].effect_conds_end);
     outfile << num_effs[i].var->get_level() << " " << num_effs[i].fop
-        << " " << num_effs[i].foperand->get_level() << endl;
+        << " " << num_effs[i].foperand->get_level() << '\n';
   }
 }
 
-void Operator::generate_cpp_input(ofstream &outfile) const {
+void Operator::generate_cpp_input(TaskWriter &outfile) const {
     //TODO: beim Einlesen in search feststellen, ob leerer Operator
-    outfile << "begin_operator" << endl;
-    outfile << name << endl;
+    outfile << "begin_operator" << '\n';
+    outfile.write_line(name);
     //duration
     outfile << duration_cond.op << " " << duration_cond.var->get_level()
-	    << endl;
+	    << '\n';
     write_prevails(outfile, prevail_start);
     write_prevails(outfile, prevail_overall);
     write_prevails(outfile, prevail_end);
@@ -373,5 +375,7 @@ void Operator::generate_cpp_input(ofstream &outfile) const {
     write_num_effect(outfile, numerical_effs_start);
     write_num_effect(outfile, numerical_effs_end);
 
-    outfile << "end_operator" << endl;
+    outfile << "end_operator" << '\n';
+}
+
 }
@@ -8,7 +8,10 @@
 #include "helper_functions.h"
 using namespace std;
 
+namespace preprocess {
+
 class Variable;
+class TaskWriter;
 
 class Operator {
 public:
@@ -76,17 +79,17 @@ private:
   vector<NumericalEffect> numerical_effs_end; // comp, first-op, sec-op
   DurationCond duration_cond;
 public:
-  Operator(istream &in, const vector<Variable *> &variables);
+  Operator(Tokenizer &in, const vector<Variable *> &variables);
 
   void strip_unimportant_effects();
   bool is_redundant() const;
 
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
-  void write_prevails(ofstream &outfile, const vector<Prevail> &prevails) const;
-  void write_effect_conds(ofstream &outfile, const vector<EffCond> &conds) const;
-  void write_pre_posts(ofstream &outfile, const vector<PrePost> &pre_posts) const;
-  void write_num_effect(ofstream &outfile, const vector<NumericalEffect> &num_effs) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
+  void write_prevails(TaskWriter &outfile, const vector<Prevail> &prevails) const;
+  void write_effect_conds(TaskWriter &outfile, const vector<EffCond> &conds) const;
+  void write_pre_posts(TaskWriter &outfile, const vector<PrePost> &pre_posts) const;
+  void write_num_effect(TaskWriter &outfile, const vector<NumericalEffect> &num_effs) const;
   string get_name() const {
     return name;
   }
@@ -125,4 +128,6 @@ public:
 
 extern void strip_operators(vector<Operator> &operators);
 
+}
+
 #endif
@@ -0,0 +1,24 @@
+#ifndef PREPROCESSOR_H
+#define PREPROCESSOR_H
+
+#include <iostream>
+using namespace std;
+
+namespace preprocess {
+
+class TaskWriter;
+
+// Keep all variables instead of only those relevant for the goal.
+extern bool g_do_not_prune_variables;
+
+// Preprocess the translated task (output.sas format) from in and write the
+// result for the search to out. Set g_do_not_prune_variables before to skip
+// the relevance analysis. If in reads the regular file input_fd, the file is
+// mapped into memory instead of being read through in.
+void preprocess_task(istream &in, TaskWriter &out, int input_fd = -1);
+// The same, writing the classic text format ("output" file).
+void preprocess_task(istream &in, ostream &out, int input_fd = -1);
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include <vector>
 using namespace std;
 
+namespace preprocess {
+
 vector<vector<int> > SCC::get_result() {
   int node_count = graph.size();
   dfs_numbers.resize(node_count, -1);
@@ -91,3 +93,5 @@ int main() {
   }
 }
 */
+
+}
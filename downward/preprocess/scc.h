@@ -21,6 +21,8 @@
 #include <vector>
 using namespace std;
 
+namespace preprocess {
+
 class SCC {
   const vector<vector<int> > &graph;
 
@@ -39,4 +41,6 @@ public:
   SCC(const vector<vector<int> > &theGraph) : graph(theGraph) {}
   vector<vector<int> > get_result();
 };
+}
+
 #endif
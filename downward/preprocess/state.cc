@@ -1,13 +1,15 @@
 #include "state.h"
 #include "helper_functions.h"
 
+namespace preprocess {
+
 class Variable;
 
-State::State(istream &in, const vector<Variable *> &variables) {
+State::State(Tokenizer &in, const vector<Variable *> &variables) {
   check_magic(in, "begin_state");
   for(int i = 0; i < variables.size(); i++) {
     double value;
-    cin >> value; //for axioms, this is default value
+    in >> value; //for axioms, this is default value
     values[variables[i]] = value;
   }
   check_magic(in, "end_state");
@@ -22,3 +24,5 @@ void State::dump() const {
       it != values.end(); ++it)
     cout << "  " << it->first->get_name() << ": " << it->second << endl;
 }
+
+}
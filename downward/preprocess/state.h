@@ -4,18 +4,24 @@
 #include <iostream>
 #include <map>
 #include <vector>
+
+#include "tokenizer.h"
 using namespace std;
 
+namespace preprocess {
+
 class Variable;
 
 class State {
   map<Variable *, double> values;
 public:
   State() {} // TODO: Entfernen (erfordert kleines Redesign)
-  State(istream &in, const vector<Variable *> &variables);
+  State(Tokenizer &in, const vector<Variable *> &variables);
 
   const double operator[](Variable *var) const;
   void dump() const;
 };
 
+}
+
 #endif
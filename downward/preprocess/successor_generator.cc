@@ -1,5 +1,6 @@
 #include "operator.h"
 #include "successor_generator.h"
+#include "task_writer.h"
 #include "variable.h"
 
 #include <functional>
@@ -9,6 +10,8 @@
 #include <cassert>
 using namespace std;
 
+namespace preprocess {
+
 /* NOTE on possible optimizations:
 
  * Sharing "GeneratorEmpty" instances might help quite a bit with
@@ -30,7 +33,7 @@ public:
   virtual ~GeneratorBase() {
   }
   virtual void dump(string indent) const = 0;
-  virtual void generate_cpp_input(ofstream &outfile) const = 0;
+  virtual void generate_cpp_input(TaskWriter &outfile) const = 0;
 };
 
 class GeneratorSwitch : public GeneratorBase {
@@ -43,7 +46,7 @@ public:
   GeneratorSwitch(Variable *switch_variable, list<int> &operators,
       const vector<GeneratorBase *> &gen_for_val, GeneratorBase *default_gen);
   virtual void dump(string indent) const;
-  virtual void generate_cpp_input(ofstream &outfile) const;
+  virtual void generate_cpp_input(TaskWriter &outfile) const;
 };
 
 class GeneratorLeaf : public GeneratorBase {
@@ -51,13 +54,13 @@ class GeneratorLeaf : public GeneratorBase {
 public:
   GeneratorLeaf(list<int> &operators);
   virtual void dump(string indent) const;
-  virtual void generate_cpp_input(ofstream &outfile) const;
+  virtual void generate_cpp_input(TaskWriter &outfile) const;
 };
 
 class GeneratorEmpty : public GeneratorBase {
 public:
   virtual void dump(string indent) const;
-  virtual void generate_cpp_input(ofstream &outfile) const;
+  virtual void generate_cpp_input(TaskWriter &outfile) const;
 };
 
 GeneratorSwitch::GeneratorSwitch(Variable *switch_variable,
@@ -88,20 +91,20 @@ void GeneratorSwitch::dump(string indent) const {
   default_generator->dump(indent + "  ");
 }
 
-void GeneratorSwitch::generate_cpp_input(ofstream &outfile) const {
+void GeneratorSwitch::generate_cpp_input(TaskWriter &outfile) const {
   int level = switch_var->get_level();
   assert(level != -1);
-  outfile << "switch " << level << endl;
-  outfile << "check " << immediate_ops_indices.size() << endl;
+  outfile << "switch " << level << '\n';
+  outfile << "check " << immediate_ops_indices.size() << '\n';
   for(list<int>::const_iterator op_iter = immediate_ops_indices.begin(); op_iter
       != immediate_ops_indices.end(); ++op_iter)
-    outfile << *op_iter << endl;
+    outfile << *op_iter << '\n';
   for(int i = 0; i < switch_var->get_range(); i++) {
     //cout << "case "<<switch_var->get_name()<<" (Level " <<switch_var->get_level() <<
-    //  ") has value " << i << ":" << endl;
+    //  ") has value " << i << ":" << '\n';
     generator_for_value[i]->generate_cpp_input(outfile);
   }
-  //cout << "always:" << endl; 
+  //cout << "always:" << '\n'; 
   default_generator->generate_cpp_input(outfile);
 }
 
@@ -115,19 +118,19 @@ void GeneratorLeaf::dump(string indent) const {
     cout << indent << *op_iter << endl;
 }
 
-void GeneratorLeaf::generate_cpp_input(ofstream &outfile) const {
-  outfile << "check " << applicable_ops_indices.size() << endl;
+void GeneratorLeaf::generate_cpp_input(TaskWriter &outfile) const {
+  outfile << "check " << applicable_ops_indices.size() << '\n';
   for(list<int>::const_iterator op_iter = applicable_ops_indices.begin(); op_iter
       != applicable_ops_indices.end(); ++op_iter)
-    outfile << *op_iter << endl;
+    outfile << *op_iter << '\n';
 }
 
 void GeneratorEmpty::dump(string indent) const {
   cout << indent << "<empty>" << endl;
 }
 
-void GeneratorEmpty::generate_cpp_input(ofstream &outfile) const {
-  outfile << "check 0" << endl;
+void GeneratorEmpty::generate_cpp_input(TaskWriter &outfile) const {
+  outfile << "check 0" << '\n';
 }
 
 SuccessorGenerator::SuccessorGenerator(const vector<Variable *> &variables,
@@ -248,6 +251,8 @@ void SuccessorGenerator::dump() const {
   cout << "Successor Generator:" << endl;
   root->dump("  ");
 }
-void SuccessorGenerator::generate_cpp_input(ofstream &outfile) const {
+void SuccessorGenerator::generate_cpp_input(TaskWriter &outfile) const {
   root->generate_cpp_input(outfile);
 }
+
+}
@@ -8,9 +8,12 @@
 #include <algorithm>
 using namespace std;
 
+namespace preprocess {
+
 class GeneratorBase;
 class Operator;
 class Variable;
+class TaskWriter;
 
 class SuccessorGenerator {
   GeneratorBase *root;
@@ -31,7 +34,9 @@ public:
 		     const vector<Operator> &operators);
   ~SuccessorGenerator();
   void dump() const;
-  void generate_cpp_input(ofstream &outfile) const;
+  void generate_cpp_input(TaskWriter &outfile) const;
 };
 
+}
+
 #endif
@@ -0,0 +1,40 @@
+#include "task_writer.h"
+
+namespace preprocess {
+
+void TextTaskWriter::write_int(int value) {
+  out << value;
+}
+
+void TextTaskWriter::write_double(double value) {
+  out << value;
+}
+
+void TextTaskWriter::write_string(const string &str) {
+  out << str;
+}
+
+void TextTaskWriter::write_line(const string &line) {
+  out << line << '\n';
+}
+
+void MemoryTaskWriter::write_int(int value) {
+  tokens.push_back(TaskToken(value));
+}
+
+void MemoryTaskWriter::write_double(double value) {
+  tokens.push_back(TaskToken(value));
+}
+
+void MemoryTaskWriter::write_string(const string &str) {
+  istringstream words(str);
+  string word;
+  while(words >> word)
+    tokens.push_back(TaskToken(TaskToken::WORD, word));
+}
+
+void MemoryTaskWriter::write_line(const string &line) {
+  tokens.push_back(TaskToken(TaskToken::LINE, line));
+}
+
+}
@@ -0,0 +1,78 @@
+#ifndef TASK_WRITER_H
+#define TASK_WRITER_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace preprocess {
+
+// Output of the preprocessed task ("output" file) for the search in the
+// classic whitespace separated text format.
+class TaskWriter {
+public:
+  virtual ~TaskWriter() {}
+  virtual void write_int(int value) = 0;
+  virtual void write_double(double value) = 0;
+  virtual void write_string(const string &str) = 0;
+  // A whole line that may contain spaces (operator names).
+  virtual void write_line(const string &line) = 0;
+
+  TaskWriter &operator<<(int value) {write_int(value); return *this;}
+  TaskWriter &operator<<(unsigned int value) {write_int(value); return *this;}
+  TaskWriter &operator<<(long value) {write_int(value); return *this;}
+  TaskWriter &operator<<(unsigned long value) {write_int(value); return *this;}
+  TaskWriter &operator<<(bool value) {write_int(value); return *this;}
+  TaskWriter &operator<<(double value) {write_double(value); return *this;}
+  TaskWriter &operator<<(char value) {write_string(string(1, value)); return *this;}
+  TaskWriter &operator<<(const char *str) {write_string(str); return *this;}
+  TaskWriter &operator<<(const string &str) {write_string(str); return *this;}
+  // enums and everything else that has a textual representation
+  template<class T>
+  TaskWriter &operator<<(const T &value) {
+    ostringstream os;
+    os << value;
+    write_string(os.str());
+    return *this;
+  }
+};
+
+class TextTaskWriter : public TaskWriter {
+  ostream &out;
+public:
+  TextTaskWriter(ostream &o) : out(o) {}
+  virtual void write_int(int value);
+  virtual void write_double(double value);
+  virtual void write_string(const string &str);
+  virtual void write_line(const string &line);
+};
+
+// One value written for the search, kept in memory by MemoryTaskWriter.
+struct TaskToken {
+  enum Kind {NUMBER, WORD, LINE};
+  Kind kind;
+  double number; // ints are exact
+  string word;
+  TaskToken(double n) : kind(NUMBER), number(n) {}
+  TaskToken(Kind k, const string &w) : kind(k), number(0), word(w) {}
+};
+
+// Keeps the written values in memory (tfd driver), so that the search gets
+// the numbers and words as they are instead of formatting and parsing text.
+// Strings are split into words like the text format is read, line breaks
+// and separators are dropped.
+class MemoryTaskWriter : public TaskWriter {
+  vector<TaskToken> &tokens;
+public:
+  MemoryTaskWriter(vector<TaskToken> &t) : tokens(t) {}
+  virtual void write_int(int value);
+  virtual void write_double(double value);
+  virtual void write_string(const string &str);
+  virtual void write_line(const string &line);
+};
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace preprocess {
+
+// Input of the translated task (output.sas).
+//
+// The whole input is held in memory: a regular file is mapped, any other
+// stream is read in large blocks. Words are found without copying and
+// numbers are parsed by hand, which is much faster than istream >> with
+// its locale handling and per-character virtual calls. The accepted
+// format is the same whitespace separated text.
+class Tokenizer {
+  const char *data;
+  size_t size;
+  size_t pos;
+  bool mapped;
+  vector<char> buffer;
+
+  void skip_whitespace();
+  // Next word, exits at the end of the input.
+  void next_word(const char *&word, size_t &length);
+  void syntax_error(const char *expected, const char *word, size_t length);
+public:
+  // Maps the regular file fd if possible, reads everything from in otherwise.
+  Tokenizer(istream &in, int fd = -1);
+  ~Tokenizer();
+
+  int read_int();
+  double read_double();
+  string read_string();
+  // Rest of the current line (operator names contain spaces).
+  string read_line();
+  // Only whitespace left.
+  bool at_end();
+
+  Tokenizer &operator>>(int &value) {value = read_int(); return *this;}
+  Tokenizer &operator>>(double &value) {value = read_double(); return *this;}
+  Tokenizer &operator>>(bool &value) {value = read_int() != 0; return *this;}
+  Tokenizer &operator>>(string &value) {value = read_string(); return *this;}
+};
+
+// Hand-written number parsing of the word [begin, end). Return false if
+// the word is not a number. parse_double is exact: words it cannot convert
+// exactly with double arithmetic are left to strtod.
+bool parse_int(const char *begin, const char *end, int &value);
+bool parse_double(const char *begin, const char *end, double &value);
+
+}
+
+#endif
@@ -3,7 +3,9 @@
 #include <cassert>
 using namespace std;
 
-Variable::Variable(istream &in) {
+namespace preprocess {
+
+Variable::Variable(Tokenizer &in) {
   in >> name >> range >> layer;
   level = -1;
   necessary = false;
@@ -78,3 +80,5 @@ void Variable::dump() const {
     cout << "; derived; layer: "<< layer;
   cout << "]" << endl;
 }
+
+}
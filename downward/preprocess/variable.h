@@ -2,8 +2,12 @@
 #define VARIABLE_H
 
 #include <iostream>
+
+#include "tokenizer.h"
 using namespace std;
 
+namespace preprocess {
+
 class Variable {
   int range;
   string name;
@@ -15,7 +19,7 @@ class Variable {
   bool comparison;
   bool used_in_duration_condition;
 public:
-  Variable(istream &in);
+  Variable(Tokenizer &in);
   void set_level(int level);
   void set_necessary(); 
   int get_level() const;
@@ -34,4 +38,6 @@ public:
   void dump() const;
 };
 
+}
+
 #endif
@@ -1,13 +1,19 @@
 #include "axioms.h"
 #include "globals.h"
+#include "instrumentation.h"
 #include "operator.h"
 #include "state.h"
+#include "task_reader.h"
 
+#include <algorithm>
+#include <ctime>
 #include <deque>
+#include <functional>
+#include <queue>
 #include <iostream>
 using namespace std;
 
-LogicAxiom::LogicAxiom(istream &in)
+LogicAxiom::LogicAxiom(TaskReader &in)
 {
     check_magic(in, "begin_rule");
     int cond_count;
@@ -18,16 +24,53 @@ LogicAxiom::LogicAxiom(istream &in)
     check_magic(in, "end_rule");
 }
 
-NumericAxiom::NumericAxiom(istream &in)
+NumericAxiom::NumericAxiom(TaskReader &in, Task &task)
 {
     in >> affected_variable >> op >> var_lhs >> var_rhs;
     if(op == lt || op == eq || op == gt || op == ge || op == le || op == ue)
-        g_variable_types[affected_variable] = comparison;
+        task.variable_types[affected_variable] = comparison;
     else
-        g_variable_types[affected_variable] = subterm_functional;
+        task.variable_types[affected_variable] = subterm_functional;
 }
 
-AxiomEvaluator::AxiomEvaluator()
+/// Value of a numeric axiom with operator op, comparisons are 0 if they hold.
+static inline double apply_binary_op(binary_op op, double left, double right)
+{
+    switch(op) {
+        case add:
+            return left + right;
+        case subtract:
+            return left - right;
+        case mult:
+            return left * right;
+        case divis:
+            return left / right;
+        case lt:
+            return (left < right) ? 0.0 : 1.0;
+        case le:
+            return (left <= right) ? 0.0 : 1.0;
+        case eq:
+            return double_equals(left, right) ? 0.0 : 1.0;
+        case ge:
+            return (left >= right) ? 0.0 : 1.0;
+        case gt:
+            return (left > right) ? 0.0 : 1.0;
+        case ue:
+            return !double_equals(left, right) ? 0.0 : 1.0;
+        default:
+            cout << "Error: unknown numeric axiom operator " << op << "." << endl;
+            assert(false);
+            return 0.0;
+    }
+}
+
+double NumericAxiom::compute(const TimeStampedState &state) const
+{
+    return apply_binary_op(op, state[var_lhs], state[var_rhs]);
+}
+
+AxiomEvaluator::AxiomEvaluator(Task &task) :
+    task(task)
 {
     // Handle axioms in the following order:
     // 1) Arithmetic axioms (layers 0 through k-1)
@@ -36,56 +79,56 @@ AxiomEvaluator::AxiomEvaluator()
 
     // determine layer where arithmetic axioms end and comparison
     // axioms and logic axioms start 	
-    g_last_arithmetic_axiom_layer = -1;
-    g_comparison_axiom_layer = -1;
-    g_first_logic_axiom_layer = -1;
-    g_last_logic_axiom_layer = -1;
-    for(int i = 0; i < g_axiom_layers.size(); i++) {
-        int layer = g_axiom_layers[i];
+    task.last_arithmetic_axiom_layer = -1;
+    task.comparison_axiom_layer = -1;
+    task.first_logic_axiom_layer = -1;
+    task.last_logic_axiom_layer = -1;
+    for(int i = 0; i < task.axiom_layers.size(); i++) {
+        int layer = task.axiom_layers[i];
         if(layer == -1)
             continue;
-        if(g_variable_types[i] == logical) {
-            g_last_logic_axiom_layer = max(g_last_logic_axiom_layer, layer);
-            if(layer < g_first_logic_axiom_layer || g_first_logic_axiom_layer == -1)
-                g_first_logic_axiom_layer = layer;
-        } else if(g_variable_types[i] == comparison) {
-            assert(g_comparison_axiom_layer == -1 || g_comparison_axiom_layer == layer);
-            g_comparison_axiom_layer = layer;
+        if(task.variable_types[i] == logical) {
+            task.last_logic_axiom_layer = max(task.last_logic_axiom_layer, layer);
+            if(layer < task.first_logic_axiom_layer || task.first_logic_axiom_layer == -1)
+                task.first_logic_axiom_layer = layer;
+        } else if(task.variable_types[i] == comparison) {
+            assert(task.comparison_axiom_layer == -1 || task.comparison_axiom_layer == layer);
+            task.comparison_axiom_layer = layer;
         } else { //if(is_functional(i))
-            g_last_arithmetic_axiom_layer = max(g_last_arithmetic_axiom_layer,
+            task.last_arithmetic_axiom_layer = max(task.last_arithmetic_axiom_layer,
                     layer);
         }
     }
 
-    int max_axiom_layer = max(g_last_logic_axiom_layer, g_comparison_axiom_layer);
-    max_axiom_layer = max(max_axiom_layer, g_last_arithmetic_axiom_layer);
-    assert(g_last_arithmetic_axiom_layer < g_comparison_axiom_layer || g_comparison_axiom_layer == -1);
-    assert(g_comparison_axiom_layer < g_first_logic_axiom_layer || g_first_logic_axiom_layer == -1);
-    assert(g_last_arithmetic_axiom_layer < g_first_logic_axiom_layer || g_first_logic_axiom_layer == -1);
-    assert(g_first_logic_axiom_layer <= g_last_logic_axiom_layer);
-    assert(g_first_logic_axiom_layer > -1 || g_last_logic_axiom_layer == -1);
-    assert(g_first_logic_axiom_layer == -1 || g_last_logic_axiom_layer > -1);
+    int max_axiom_layer = max(task.last_logic_axiom_layer, task.comparison_axiom_layer);
+    max_axiom_layer = max(max_axiom_layer, task.last_arithmetic_axiom_layer);
+    assert(task.last_arithmetic_axiom_layer < task.comparison_axiom_layer || task.comparison_axiom_layer == -1);
+    assert(task.comparison_axiom_layer < task.first_logic_axiom_layer || task.first_logic_axiom_layer == -1);
+    assert(task.last_arithmetic_axiom_layer < task.first_logic_axiom_layer || task.first_logic_axiom_layer == -1);
+    assert(task.first_logic_axiom_layer <= task.last_logic_axiom_layer);
+    assert(task.first_logic_axiom_layer > -1 || task.last_logic_axiom_layer == -1);
+    assert(task.first_logic_axiom_layer == -1 || task.last_logic_axiom_layer > -1);
 
     // Initialize axioms by layer
-    axioms_by_layer.resize(g_last_logic_axiom_layer + 2);
+    axioms_by_layer.resize(task.last_logic_axiom_layer + 2);
     for(int i = 0; i < max_axiom_layer + 2; i++)
         axioms_by_layer.push_back(vector<Axiom*>());
 
-    for(int i = 0; i < g_axioms.size(); i++) {
-        int layer = g_axiom_layers[g_axioms[i]->affected_variable];
-        axioms_by_layer[layer].push_back(g_axioms[i]);
+    for(int i = 0; i < task.axioms.size(); i++) {
+        int layer = task.axiom_layers[task.axioms[i]->affected_variable];
+        axioms_by_layer[layer].push_back(task.axioms[i]);
     }
 
     // Initialize literals
-    for(int i = 0; i < g_variable_domain.size(); i++)
+    for(int i = 0; i < task.variable_domain.size(); i++)
         axiom_literals.push_back(vector<LogicAxiomLiteral>(
-            max(g_variable_domain[i], 0))
+            max(task.variable_domain[i], 0))
         );
 
     // Initialize rules
-    if(g_first_logic_axiom_layer != -1) {
-        for(int layer = g_first_logic_axiom_layer; 
-            layer <= g_last_logic_axiom_layer; layer++) {
+    if(task.first_logic_axiom_layer != -1) {
+        for(int layer = task.first_logic_axiom_layer; 
+            layer <= task.last_logic_axiom_layer; layer++) {
             for(int i = 0; i < axioms_by_layer[layer].size(); i++) {
                 LogicAxiom *axiom =
                     static_cast<LogicAxiom*>(axioms_by_layer[layer][i]);
@@ -94,14 +137,14 @@ AxiomEvaluator::AxiomEvaluator()
                 int eff_val = static_cast<int>(axiom->new_value);
                 LogicAxiomLiteral *eff_literal =
                     &axiom_literals[eff_var][eff_val];
-                rules.push_back(LogicAxiomRule(cond_count, eff_var, eff_val, eff_literal));
+                rules.push_back(LogicAxiomRule(cond_count, eff_var, eff_val, eff_literal, axiom));
             }
         }
 
         // Cross-reference rules and literals
         int sum_of_indices = 0;
-        for(int layer = g_first_logic_axiom_layer; 
-            layer <= g_last_logic_axiom_layer; layer++) {
+        for(int layer = task.first_logic_axiom_layer; 
+            layer <= task.last_logic_axiom_layer; layer++) {
             for(int i = 0; i < axioms_by_layer[layer].size(); i++, sum_of_indices++) {
                 LogicAxiom *axiom =
                     static_cast<LogicAxiom*>(axioms_by_layer[layer][i]);
@@ -118,114 +161,162 @@ AxiomEvaluator::AxiomEvaluator()
     // Initialize negation-by-failure information
     nbf_info_by_layer.resize(max_axiom_layer + 2);
 
-    for(int var_no = 0; var_no < g_axiom_layers.size(); var_no++) {
-        int layer = g_axiom_layers[var_no];
-        if(layer > -1 && layer >= g_first_logic_axiom_layer &&
-            layer <= g_last_logic_axiom_layer) {
-            int nbf_value = static_cast<int>(g_default_axiom_values[var_no]);
+    for(int var_no = 0; var_no < task.axiom_layers.size(); var_no++) {
+        int layer = task.axiom_layers[var_no];
+        if(layer > -1 && layer >= task.first_logic_axiom_layer &&
+            layer <= task.last_logic_axiom_layer) {
+            int nbf_value = static_cast<int>(task.default_axiom_values[var_no]);
             LogicAxiomLiteral *nbf_literal = &axiom_literals[var_no][nbf_value];
             NegationByFailureInfo nbf_info(var_no, nbf_literal);
             nbf_info_by_layer[layer].push_back(nbf_info);
         }
     }
 
-}
+    compile_numeric_axioms();
 
-void AxiomEvaluator::evaluate(TimeStampedState &state)
-{
-    evaluate_arithmetic_axioms(state);
-    evaluate_comparison_axioms(state);
-    evaluate_logic_axioms(state);
-    // state.dump();
+    // Dependency indexes for the incremental evaluation
+    int num_vars = task.variable_domain.size();
+    numeric_axioms_reading.resize(num_vars);
+    for(int i = 0; i < numeric_program.size(); i++) {
+        const NumericInstruction &instruction = numeric_program[i];
+        numeric_axioms_reading[instruction.lhs].push_back(i);
+        if(instruction.rhs != instruction.lhs)
+            numeric_axioms_reading[instruction.rhs].push_back(i);
+    }
+    numeric_axiom_queued.resize(numeric_program.size(), false);
+
+    logic_dependents.resize(num_vars);
+    rules_by_effect_var.resize(num_vars);
+    for(int i = 0; i < rules.size(); i++) {
+        int eff_var = rules[i].effect_var;
+        rules_by_effect_var[eff_var].push_back(&rules[i]);
+        const vector<Prevail> &conditions = rules[i].axiom->prevail;
+        for(int j = 0; j < conditions.size(); j++)
+            logic_dependents[conditions[j].var].push_back(eff_var);
+    }
+    for(int var = 0; var < num_vars; var++) {
+        vector<int> &dependents = logic_dependents[var];
+        sort(dependents.begin(), dependents.end());
+        dependents.erase(unique(dependents.begin(), dependents.end()), dependents.end());
+    }
+    var_mark.resize(num_vars, 0);
+    mark_epoch = 0;
+    pending_vars_by_layer.resize(axioms_by_layer.size());
 }
 
-void AxiomEvaluator::evaluate_arithmetic_axioms(TimeStampedState &state)
+void AxiomEvaluator::compile_numeric_axioms()
 {
-    for(int layer_no = 0; layer_no <= g_last_arithmetic_axiom_layer; layer_no++) {
-        for(int i = 0; i < axioms_by_layer[layer_no].size(); i++) {
-            NumericAxiom* ax =
-                static_cast<NumericAxiom*>(axioms_by_layer[layer_no][i]);
-
-            int var = ax->affected_variable;
-            int lhs = ax->var_lhs;
-            int rhs = ax->var_rhs;
-
-            switch(ax->op) {
-                case add:
-                    state[var] = state[lhs] + state[rhs];
-                    break;
-                case subtract:
-                    state[var] = state[lhs] - state[rhs];
-                    break;
-                case mult:
-                    state[var] = state[lhs] * state[rhs];
-                    break;
-                case divis:
-                    state[var] = state[lhs] / state[rhs];
-                    break;
-                default:
-                    cout << "Error: No comparison operators are allowed here." << endl;
-                    assert(false);
-                    break;
-            }
+    // The depth of a variable is 0 if it is not computed by a numeric axiom
+    // and one more than the depth of its deeper operand otherwise. Axioms
+    // are stored in layers (arithmetic axioms, then all comparison axioms
+    // in one layer), so the operands are known before the axioms reading
+    // them.
+    vector<int> depth(task.variable_domain.size(), 0);
+    vector<NumericAxiom *> axioms;
+    vector<pair<pair<int, int>, int> > order;   // ((depth, op), index into axioms)
+    int last_numeric_layer = max(task.last_arithmetic_axiom_layer, task.comparison_axiom_layer);
+    for(int layer = 0; layer <= last_numeric_layer; layer++) {
+        for(int i = 0; i < axioms_by_layer[layer].size(); i++) {
+            NumericAxiom *axiom = static_cast<NumericAxiom*>(axioms_by_layer[layer][i]);
+            int axiom_depth = max(depth[axiom->var_lhs], depth[axiom->var_rhs]) + 1;
+            depth[axiom->affected_variable] = axiom_depth;
+            order.push_back(make_pair(make_pair(axiom_depth, static_cast<int>(axiom->op)),
+                        static_cast<int>(axioms.size())));
+            axioms.push_back(axiom);
+        }
+    }
+    sort(order.begin(), order.end());
 
+    // Instructions of one block have the same depth, so they do not read
+    // each other's results and can be evaluated in any order.
+    for(int i = 0; i < order.size(); i++) {
+        const NumericAxiom *axiom = axioms[order[i].second];
+        NumericInstruction instruction;
+        instruction.target = axiom->affected_variable;
+        instruction.lhs = axiom->var_lhs;
+        instruction.rhs = axiom->var_rhs;
+        numeric_program.push_back(instruction);
+        numeric_program_ops.push_back(axiom->op);
+        if(i == 0 || order[i].first != order[i - 1].first) {
+            NumericInstructionBlock block;
+            block.op = axiom->op;
+            block.begin = i;
+            numeric_blocks.push_back(block);
         }
+        numeric_blocks.back().end = i + 1;
     }
 }
 
-void AxiomEvaluator::evaluate_comparison_axioms(TimeStampedState &state)
+/// Evaluate the instructions [instruction, end) with the operator op.
+template<binary_op op>
+static void run_numeric_block(const NumericInstruction *instruction,
+        const NumericInstruction *end, double *values)
 {
-    // There must be exactly one axiom layer containing all the 
-    // comparison axioms. This is the one between the layers containing
-    // numeric axioms and logic axioms.
-    if(g_comparison_axiom_layer == -1)
-        return;
-    for(int i = 0; i < axioms_by_layer[g_comparison_axiom_layer].size(); i++) {
-        NumericAxiom* ax =
-            static_cast<NumericAxiom*>(axioms_by_layer[g_comparison_axiom_layer][i]);
-
-        // ax->dump();
+    for(; instruction != end; ++instruction)
+        values[instruction->target] =
+            apply_binary_op(op, values[instruction->lhs], values[instruction->rhs]);
+}
 
-        int var = ax->affected_variable;
-        int lhs = ax->var_lhs;
-        int rhs = ax->var_rhs;
-        switch(ax->op) {
+void AxiomEvaluator::run_numeric_program(vector<double> &values) const
+{
+    if(numeric_program.empty())
+        return;
+    const NumericInstruction *program = &numeric_program[0];
+    double *data = &values[0];
+    for(int i = 0; i < numeric_blocks.size(); i++) {
+        const NumericInstruction *begin = program + numeric_blocks[i].begin;
+        const NumericInstruction *end = program + numeric_blocks[i].end;
+        switch(numeric_blocks[i].op) {
+            case add:
+                run_numeric_block<add>(begin, end, data);
+                break;
+            case subtract:
+                run_numeric_block<subtract>(begin, end, data);
+                break;
+            case mult:
+                run_numeric_block<mult>(begin, end, data);
+                break;
+            case divis:
+                run_numeric_block<divis>(begin, end, data);
+                break;
             case lt:
-                state[var] = (state[lhs] < state[rhs]) ? 0.0 : 1.0;
+                run_numeric_block<lt>(begin, end, data);
                 break;
             case le:
-                state[var] = (state[lhs] <= state[rhs]) ? 0.0 : 1.0;
+                run_numeric_block<le>(begin, end, data);
                 break;
             case eq:
-                state[var] = double_equals(state[lhs], state[rhs]) ? 0.0 : 1.0;
+                run_numeric_block<eq>(begin, end, data);
                 break;
             case ge:
-                state[var] = (state[lhs] >= state[rhs]) ? 0.0 : 1.0;
+                run_numeric_block<ge>(begin, end, data);
                 break;
             case gt:
-                state[var] = (state[lhs] > state[rhs]) ? 0.0 : 1.0;
+                run_numeric_block<gt>(begin, end, data);
                 break;
             case ue:
-                state[var] = !double_equals(state[lhs], state[rhs]) ? 0.0 : 1.0;
-                break;
-            default:
-                cout << "Error: ax->op is " << ax->op << "." << endl;
-                cout << "Error: No arithmetic operators are allowed here." << endl;
-                assert(false);
+                run_numeric_block<ue>(begin, end, data);
                 break;
         }
-
     }
 }
 
+void AxiomEvaluator::evaluate(TimeStampedState &state)
+{
+    INSTRUMENT_PHASE(state.get_context().instrumentation, phase_axiom_evaluation);
+    run_numeric_program(state.state);
+    evaluate_logic_axioms(state);
+    // state.dump();
+}
+
 void AxiomEvaluator::evaluate_logic_axioms(TimeStampedState &state)
 {
     // cout << "Evaluating axioms..." << endl;
     deque<LogicAxiomLiteral *> queue;
-    for(int i = 0; i < g_axiom_layers.size(); i++) {
-        if(g_axiom_layers[i] == -1) {
+    for(int i = 0; i < task.axiom_layers.size(); i++) {
+        if(task.axiom_layers[i] == -1) {
             // non-derived variable
-            const variable_type& vt = g_variable_types[i];
+            const variable_type& vt = task.variable_types[i];
             if (vt != comparison && vt != logical) {
                 // variable is functional
                 // do nothing (should have been handled by
@@ -234,16 +325,16 @@ void AxiomEvaluator::evaluate_logic_axioms(TimeStampedState &state)
                 // variable is a logic variable
                 queue.push_back(&axiom_literals[i][static_cast<int>(state[i])]);
             }
-        } else if(g_axiom_layers[i] <= g_last_arithmetic_axiom_layer) {
+        } else if(task.axiom_layers[i] <= task.last_arithmetic_axiom_layer) {
             // derived variable corresponding to an arithmetic (sub)term.
             // do nothing (should have been handled by arithmetic/comparison axioms)
-        } else if(g_axiom_layers[i] == g_comparison_axiom_layer) {
+        } else if(task.axiom_layers[i] == task.comparison_axiom_layer) {
             // derived variable corresponding to a comparison.
             // can be handled like a non-derived discrete variable
             queue.push_back(&axiom_literals[i][static_cast<int>(state[i])]);
-        } else if(g_axiom_layers[i] >= g_first_logic_axiom_layer) {
+        } else if(task.axiom_layers[i] >= task.first_logic_axiom_layer) {
             // derived discrete variable -> use default value first
-            state[i] = g_default_axiom_values[i];
+            state[i] = task.default_axiom_values[i];
         } else {
             // cannot happen
             cout << "Error: Encountered a variable with an axiom layer exceeding " 
@@ -273,9 +364,9 @@ void AxiomEvaluator::evaluate_logic_axioms(TimeStampedState &state)
         }
     }
 
-    if(g_first_logic_axiom_layer != -1) {
-        for(int layer_no = g_first_logic_axiom_layer;
-            layer_no < g_last_logic_axiom_layer + 1; layer_no++) {
+    if(task.first_logic_axiom_layer != -1) {
+        for(int layer_no = task.first_logic_axiom_layer;
+            layer_no < task.last_logic_axiom_layer + 1; layer_no++) {
             // Apply Horn rules.
             while(!queue.empty()) {
                 LogicAxiomLiteral *curr_literal = queue.front();
@@ -298,9 +389,196 @@ void AxiomEvaluator::evaluate_logic_axioms(TimeStampedState &state)
             const vector<NegationByFailureInfo> &nbf_info = nbf_info_by_layer[layer_no];
             for(int i = 0; i < nbf_info.size(); i++) {
                 int var_no = nbf_info[i].var_no;
-                if(double_equals(state[var_no], g_default_axiom_values[var_no]))
+                if(double_equals(state[var_no], task.default_axiom_values[var_no]))
                     queue.push_back(nbf_info[i].literal);
             }
         }
     }
 }
+
+void AxiomEvaluator::evaluate(TimeStampedState &state, const vector<int> &changed_vars)
+{
+    if(changed_vars.empty())
+        return;
+    INSTRUMENT_PHASE(state.get_context().instrumentation, phase_axiom_evaluation);
+    changed_scratch = changed_vars;
+    evaluate_numeric_axioms(state, changed_scratch);
+    evaluate_logic_axioms(state, changed_scratch);
+}
+
+void AxiomEvaluator::evaluate_numeric_axioms(TimeStampedState &state, vector<int> &changed_vars)
+{
+    // Axioms only read variables computed by axioms with a smaller index,
+    // so taking the smallest queued index first computes every axiom after
+    // all its inputs and at most once.
+    priority_queue<int, vector<int>, greater<int> > queue;
+    for(int i = 0; i < changed_vars.size(); i++) {
+        const vector<int> &readers = numeric_axioms_reading[changed_vars[i]];
+        for(int j = 0; j < readers.size(); j++) {
+            if(!numeric_axiom_queued[readers[j]]) {
+                numeric_axiom_queued[readers[j]] = true;
+                queue.push(readers[j]);
+            }
+        }
+    }
+    while(!queue.empty()) {
+        int index = queue.top();
+        queue.pop();
+        numeric_axiom_queued[index] = false;
+        const NumericInstruction &instruction = numeric_program[index];
+        int var = instruction.target;
+        double value = apply_binary_op(numeric_program_ops[index],
+                state[instruction.lhs], state[instruction.rhs]);
+        if(value == state[var])
+            continue;
+        state[var] = value;
+        changed_vars.push_back(var);
+        const vector<int> &readers = numeric_axioms_reading[var];
+        for(int j = 0; j < readers.size(); j++) {
+            assert(readers[j] > index);
+            if(!numeric_axiom_queued[readers[j]]) {
+                numeric_axiom_queued[readers[j]] = true;
+                queue.push(readers[j]);
+            }
+        }
+    }
+}
+
+void AxiomEvaluator::evaluate_logic_axioms(TimeStampedState &state, const vector<int> &changed_vars)
+{
+    if(task.first_logic_axiom_layer == -1)
+        return;
+
+    // The derived variables that can depend on a changed variable are
+    // re-derived, all others keep their (still valid) values.
+    mark_epoch++;
+    if(mark_epoch == 0) {
+        fill(var_mark.begin(), var_mark.end(), 0);
+        mark_epoch = 1;
+    }
+    pending_vars.clear();
+    for(int i = 0; i < changed_vars.size(); i++) {
+        const vector<int> &dependents = logic_dependents[changed_vars[i]];
+        for(int j = 0; j < dependents.size(); j++) {
+            if(var_mark[dependents[j]] != mark_epoch) {
+                var_mark[dependents[j]] = mark_epoch;
+                pending_vars.push_back(dependents[j]);
+            }
+        }
+    }
+    for(int i = 0; i < pending_vars.size(); i++) {
+        const vector<int> &dependents = logic_dependents[pending_vars[i]];
+        for(int j = 0; j < dependents.size(); j++) {
+            if(var_mark[dependents[j]] != mark_epoch) {
+                var_mark[dependents[j]] = mark_epoch;
+                pending_vars.push_back(dependents[j]);
+            }
+        }
+    }
+    if(pending_vars.empty())
+        return;
+
+    for(int i = 0; i < pending_vars.size(); i++) {
+        int var_no = pending_vars[i];
+        state[var_no] = task.default_axiom_values[var_no];
+        pending_vars_by_layer[task.axiom_layers[var_no]].push_back(var_no);
+    }
+
+    // Only the literals of re-derived variables are propagated, conditions
+    // on all other variables are checked once. Rules with a violated
+    // condition on another variable keep more unsatisfied conditions than
+    // they can get literals for.
+    deque<LogicAxiomLiteral *> queue;
+    for(int i = 0; i < pending_vars.size(); i++) {
+        const vector<LogicAxiomRule *> &var_rules = rules_by_effect_var[pending_vars[i]];
+        for(int j = 0; j < var_rules.size(); j++) {
+            LogicAxiomRule *rule = var_rules[j];
+            const vector<Prevail> &conditions = rule->axiom->prevail;
+            rule->unsatisfied_conditions = 0;
+            for(int k = 0; k < conditions.size(); k++) {
+                const Prevail &cond = conditions[k];
+                if(var_mark[cond.var] == mark_epoch)
+                    rule->unsatisfied_conditions++;
+                else if(!double_equals(state[cond.var], cond.prev))
+                    rule->unsatisfied_conditions += rule->condition_count + 1;
+            }
+            if(rule->unsatisfied_conditions == 0) {
+                int var_no = rule->effect_var;
+                int val = rule->effect_val;
+                if(!double_equals(state[var_no], val)) {
+                    state[var_no] = val;
+                    queue.push_back(rule->effect_literal);
+                }
+            }
+        }
+    }
+
+    for(int layer_no = task.first_logic_axiom_layer;
+        layer_no < task.last_logic_axiom_layer + 1; layer_no++) {
+        // Apply Horn rules.
+        while(!queue.empty()) {
+            LogicAxiomLiteral *curr_literal = queue.front();
+            queue.pop_front();
+            for(int i = 0; i < curr_literal->condition_of.size(); i++) {
+                LogicAxiomRule *rule = curr_literal->condition_of[i];
+                assert(var_mark[rule->effect_var] == mark_epoch);
+                if(--(rule->unsatisfied_conditions) == 0) {
+                    int var_no = rule->effect_var;
+                    int val = rule->effect_val;
+                    if(!double_equals(state[var_no], val)) {
+                        state[var_no] = val;
+                        queue.push_back(rule->effect_literal);
+                    }
+                }
+            }
+        }
+
+        // Apply negation by failure rules.
+        vector<int> &layer_vars = pending_vars_by_layer[layer_no];
+        for(int i = 0; i < layer_vars.size(); i++) {
+            int var_no = layer_vars[i];
+            if(double_equals(state[var_no], task.default_axiom_values[var_no]))
+                queue.push_back(&axiom_literals[var_no][static_cast<int>(task.default_axiom_values[var_no])]);
+        }
+        layer_vars.clear();
+    }
+}
+
+void AxiomEvaluator::benchmark_numeric_axioms(const TimeStampedState &state, int runs) const
+{
+    cout << "Numeric axioms: " << numeric_program.size() << " in "
+        << numeric_blocks.size() << " blocks" << endl;
+
+    // evaluation axiom by axiom, as before the compilation
+    TimeStampedState by_axiom(state);
+    int last_numeric_layer = max(task.last_arithmetic_axiom_layer, task.comparison_axiom_layer);
+    clock_t start = clock();
+    for(int run = 0; run < runs; run++) {
+        for(int layer = 0; layer <= last_numeric_layer; layer++) {
+            for(int i = 0; i < axioms_by_layer[layer].size(); i++) {
+                const NumericAxiom *ax = static_cast<const NumericAxiom*>(axioms_by_layer[layer][i]);
+                by_axiom[ax->affected_variable] = ax->compute(by_axiom);
+            }
+        }
+    }
+    double by_axiom_time = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+    vector<double> compiled(state.state);
+    start = clock();
+    for(int run = 0; run < runs; run++)
+        run_numeric_program(compiled);
+    double compiled_time = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+    int differences = 0;
+    for(int var = 0; var < compiled.size(); var++) {
+        bool both_nan = compiled[var] != compiled[var] && by_axiom[var] != by_axiom[var];
+        if(compiled[var] != by_axiom[var] && !both_nan)
+            differences++;
+    }
+    cout << "Axiom by axiom: " << by_axiom_time << " seconds, "
+        << 1e6 * by_axiom_time / runs << " us per evaluation" << endl;
+    cout << "Compiled program: " << compiled_time << " seconds, "
+        << 1e6 * compiled_time / runs << " us per evaluation" << endl;
+    if(differences > 0)
+        cout << "Error: results differ in " << differences << " variables." << endl;
+}
@@ -17,6 +17,9 @@ class Axiom
 {
     public:
         int affected_variable;
+        virtual ~Axiom()
+        {
+        }
 };
 
 class LogicAxiom : public Axiom
@@ -25,18 +28,18 @@ class LogicAxiom : public Axiom
         std::vector<Prevail> prevail; // var, val
         double old_value, new_value;
 
-        LogicAxiom(std::istream &in);
+        LogicAxiom(TaskReader &in);
 
-        void dump()
+        void dump(const Task &task)
         {
             for (int i = 0; i < prevail.size(); i++) {
                 cout << "[";
-                prevail[i].dump();
+                prevail[i].dump(task);
                 cout << "]";
             }
-            cout << "[" << g_variable_name[affected_variable] << ": "
+            cout << "[" << task.variable_name[affected_variable] << ": "
                 << old_value << "]";
-            cout << " => " << g_variable_name[affected_variable] << ": "
+            cout << " => " << task.variable_name[affected_variable] << ": "
                 << new_value << endl;
         }
 
@@ -56,17 +59,29 @@ class NumericAxiom : public Axiom
         int var_rhs;
         binary_op op;
 
-        NumericAxiom(std::istream &in);
+        /// Read the axiom, setting the type of the affected variable in task.
+        NumericAxiom(TaskReader &in, Task &task);
+
+        /// Value of the affected variable for the values of var_lhs and var_rhs in state.
+        double compute(const TimeStampedState &state) const;
 
-        void dump()
+        void dump(const Task &task)
         {
-            cout << g_variable_name[affected_variable] << " = ("
-                << g_variable_name[var_lhs];
+            cout << task.variable_name[affected_variable] << " = ("
+                << task.variable_name[var_lhs];
             cout << " " << op << " ";
-            cout << g_variable_name[var_rhs] << ")" << endl;
+            cout << task.variable_name[var_rhs] << ")" << endl;
         }
 };
 
+/// Numeric axiom compiled by AxiomEvaluator: values[target] = values[lhs] op values[rhs].
+struct NumericInstruction
+{
+    int target;
+    int lhs;
+    int rhs;
+};
+
 class AxiomEvaluator
 {
         struct LogicAxiomRule;
@@ -81,14 +96,22 @@ class AxiomEvaluator
             int effect_var;
             int effect_val;
             LogicAxiomLiteral *effect_literal;
+            const LogicAxiom *axiom;
             LogicAxiomRule(int cond_count, int eff_var, int eff_val,
-                    LogicAxiomLiteral *eff_literal) :
+                    LogicAxiomLiteral *eff_literal, const LogicAxiom *ax) :
                 condition_count(cond_count), unsatisfied_conditions(cond_count),
                 effect_var(eff_var), effect_val(eff_val),
-                effect_literal(eff_literal)
+                effect_literal(eff_literal), axiom(ax)
                 {
                 }
         };
+        /// Consecutive instructions [begin, end) of the numeric program with the same operator.
+        struct NumericInstructionBlock
+        {
+            binary_op op;
+            int begin;
+            int end;
+        };
         struct NegationByFailureInfo
         {
             int var_no;
@@ -99,19 +122,65 @@ class AxiomEvaluator
                 }
         };
 
+        const Task &task;
         std::vector<std::vector<LogicAxiomLiteral> > axiom_literals;
         std::vector<LogicAxiomRule> rules;
         std::vector<std::vector<NegationByFailureInfo> > nbf_info_by_layer;
         std::vector<std::vector<Axiom*> > axioms_by_layer;
 
+        // The arithmetic and comparison axioms compiled to a flat program.
+        // Instructions are ordered by their depth in the axiom DAG and then
+        // by operator, so each instruction only reads variables that are not
+        // computed by an instruction after it and each block of one operator
+        // runs as a single loop.
+        std::vector<NumericInstruction> numeric_program;
+        std::vector<binary_op> numeric_program_ops;     ///< operator of each instruction
+        std::vector<NumericInstructionBlock> numeric_blocks;
+
+        // Dependency indexes of the incremental evaluation
+        std::vector<std::vector<int> > numeric_axioms_reading;  ///< var -> indices into numeric_program
+        std::vector<std::vector<int> > logic_dependents;  ///< var -> derived logic vars with a rule conditioned on it
+        std::vector<std::vector<LogicAxiomRule *> > rules_by_effect_var;
+
+        // Scratch space of the incremental evaluation
+        std::vector<bool> numeric_axiom_queued;
+        std::vector<unsigned int> var_mark;     ///< == mark_epoch: var is re-derived in this call
+        unsigned int mark_epoch;
+        std::vector<int> changed_scratch;
+        std::vector<int> pending_vars;
+        std::vector<std::vector<int> > pending_vars_by_layer;
+
     private:
-        void evaluate_arithmetic_axioms(TimeStampedState &state);
-        void evaluate_comparison_axioms(TimeStampedState &state);
+        void compile_numeric_axioms();
+        /// Evaluate all arithmetic and comparison axioms (the numeric program) on values.
+        void run_numeric_program(std::vector<double> &values) const;
         void evaluate_logic_axioms(TimeStampedState &state);
+        /// Recompute the numeric axioms depending on changed_vars, appending changed results to it.
+        void evaluate_numeric_axioms(TimeStampedState &state, std::vector<int> &changed_vars);
+        /// Re-derive the logic variables depending on changed_vars.
+        void evaluate_logic_axioms(TimeStampedState &state, const std::vector<int> &changed_vars);
 
     public:
-        AxiomEvaluator();
+        /// Compile the axioms of task, setting the axiom layers of task.
+        AxiomEvaluator(Task &task);
+        /// Evaluate all axioms in state.
         void evaluate(TimeStampedState &state);
+        /// Evaluate the axioms affected by a change of the variables in changed_vars.
+        /**
+         * The state must have been evaluated before these variables were
+         * changed (e.g. the state is a copy of an evaluated state with the
+         * effects of an operator applied). Only the numeric axioms reading a
+         * changed value and the logic variables depending on one are
+         * recomputed; the result is the same as evaluate(state).
+         */
+        void evaluate(TimeStampedState &state, const std::vector<int> &changed_vars);
+
+        /// Time runs evaluations of the numeric axioms in state and print the results.
+        /**
+         * Compares the compiled numeric program with evaluating the axioms
+         * one by one and checks that both compute the same values.
+         */
+        void benchmark_numeric_axioms(const TimeStampedState &state, int runs) const;
 };
 
 #endif
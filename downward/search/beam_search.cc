@@ -0,0 +1,252 @@
+#include "beam_search.h"
+
+#include "globals.h"
+#include "heuristic.h"
+#include "successor_generator.h"
+#include "plannerParameters.h"
+#include <time.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+/// Orders beam nodes best first: low h, reached by preferred operator, early timestamp.
+struct BeamNodeCompare
+{
+    bool operator()(const BeamNodePtr &left, const BeamNodePtr &right) const
+    {
+        if(left->h != right->h)
+            return left->h < right->h;
+        if(left->preferred != right->preferred)
+            return left->preferred;
+        return left->state.timestamp < right->state.timestamp;
+    }
+};
+
+BeamSearchEngine::BeamSearchEngine(const SearchContext &context, Heuristic *heur,
+        int width) :
+        SearchEngine(context), heuristic(heur), beam_width(width), layer(0), last_progress_layer(0),
+        best_h(HUGE_VAL), number_of_expanded_nodes(0), max_layer_size(0)
+{
+    assert(heuristic);
+    assert(beam_width > 0);
+    start_time = time(NULL);
+}
+
+BeamSearchEngine::~BeamSearchEngine()
+{
+}
+
+void BeamSearchEngine::initialize()
+{
+    cout << "INIT (beam search, width " << beam_width << ")" << endl;
+    current_layer.clear();
+    layer = 0;
+    last_progress_layer = 0;
+    best_h = HUGE_VAL;
+
+    BeamNodePtr root(new BeamNode(*context.task.initial_state, BeamNodePtr(), NULL));
+    if(!evaluate(*root)) {
+        cout << "Initial state is a dead end." << endl;
+        return;
+    }
+    best_h = root->h;
+    current_layer.push_back(root);
+}
+
+void BeamSearchEngine::statistics(time_t & current_time)
+{
+    cout << endl;
+    cout << "Search Time: " << (current_time - start_time) << " sec." << endl;
+    search_statistics.dump(number_of_expanded_nodes, current_time);
+    cout << "Beam layer: " << layer << " (" << current_layer.size() << " state(s), max. "
+        << max_layer_size << " before pruning to width " << beam_width << ")" << endl;
+    cout << "Heuristic Computations: " << heuristic->get_num_computations() << endl;
+    cout << "Number of cache hits in heuristic: " << heuristic->get_num_cache_hits() << endl;
+    cout << "Best heuristic value: " << best_h << endl;
+    dump_allocation_statistics();
+    cout << endl;
+}
+
+void BeamSearchEngine::dump_everything() const
+{
+    cout << "DEBUG: beam layer " << layer << " is:" << endl;
+    for(unsigned int i = 0; i < current_layer.size(); ++i) {
+        cout << "BeamNode" << endl;
+        current_layer[i]->state.dump(true);
+        cout << "Value: " << current_layer[i]->h << endl;
+        cout << "end BeamNode" << endl;
+    }
+}
+
+bool BeamSearchEngine::evaluate(BeamNode &node)
+{
+    heuristic->evaluate(node.state);
+    if(heuristic->is_dead_end())
+        return false;
+    node.h = heuristic->get_heuristic();
+    heuristic->get_preferred_operators(node.preferred_operators, REGULAR);
+    return true;
+}
+
+void BeamSearchEngine::set_solution(const BeamNodePtr &goal_node)
+{
+    vector<const BeamNode *> nodes;
+    for(const BeamNode *node = goal_node.get(); node; node = node->parent.get())
+        nodes.push_back(node);
+    reverse(nodes.begin(), nodes.end());
+
+    Plan plan;
+    PlanTrace path;
+    for(unsigned int i = 0; i < nodes.size(); ++i) {
+        path.push_back(path_states.create(nodes[i]->state));
+    }
+    for(unsigned int i = 1; i < nodes.size(); ++i) {
+        const Operator *op = nodes[i]->op;
+        if(op == context.task.let_time_pass)
+            continue;
+        const TimeStampedState *pred = path[i - 1];
+        plan.push_back(PlanStep(pred->get_timestamp(), op->get_duration(pred), op, pred));
+    }
+    set_plan(plan);
+    set_path(path);
+}
+
+SearchEngine::status BeamSearchEngine::step()
+{
+    if(current_layer.empty()) {
+        cout << "Beam search ran empty in layer " << layer << " -- no solution!" << endl;
+        return FAILED;
+    }
+    if(layer - last_progress_layer > MAX_LAYERS_WITHOUT_PROGRESS) {
+        cout << "Beam search made no progress for " << MAX_LAYERS_WITHOUT_PROGRESS
+            << " layers -- giving up." << endl;
+        return FAILED;
+    }
+
+    // the layer is sorted best first, so the best goal is found first
+    for(unsigned int i = 0; i < current_layer.size(); ++i) {
+        // running operators must have ended, otherwise the plan cannot be rescheduled
+        if(current_layer[i]->state.operators.empty() && current_layer[i]->state.satisfies(context.task.goal)) {
+            set_solution(current_layer[i]);
+            return SOLVED;
+        }
+    }
+
+    BeamLayerIndex index;
+    vector<BeamNodePtr> next_layer;
+    for(unsigned int i = 0; i < current_layer.size(); ++i) {
+        generate_successors(current_layer[i], index, next_layer);
+        // only needed for generating the successors
+        vector<const Operator *>().swap(current_layer[i]->preferred_operators);
+    }
+    // release all states that did not make it into the next layer
+    current_layer.clear();
+    index.clear();
+
+    vector<BeamNodePtr> evaluated;
+    evaluated.reserve(next_layer.size());
+    for(unsigned int i = 0; i < next_layer.size(); ++i) {
+        if(evaluate(*next_layer[i]))
+            evaluated.push_back(next_layer[i]);
+    }
+    next_layer.clear();
+    // states of older layers are hardly ever met again, so the cache of the
+    // heuristic would only grow with every evaluated state
+    heuristic->clear_cache();
+    max_layer_size = max(max_layer_size, (unsigned int)evaluated.size());
+
+    if(evaluated.size() > beam_width) {
+        partial_sort(evaluated.begin(), evaluated.begin() + beam_width, evaluated.end(),
+                BeamNodeCompare());
+        evaluated.resize(beam_width);
+    } else {
+        sort(evaluated.begin(), evaluated.end(), BeamNodeCompare());
+    }
+    current_layer.swap(evaluated);
+    layer++;
+
+    if(!current_layer.empty() && current_layer[0]->h < best_h) {
+        best_h = current_layer[0]->h;
+        last_progress_layer = layer;
+        cout << "Best heuristic value: " << best_h << " [layer " << layer
+            << ", expanded " << number_of_expanded_nodes << " state(s)]" << endl;
+    }
+
+    time_t current_time = time(NULL);
+    report_statistics(current_time);
+
+    // beam search stops at the first plan, so only the timeout for
+    // "no plan found" applies here.
+    if (context.parameters.timeout_while_no_plan_found > 0
+            && current_time - start_time > context.parameters.timeout_while_no_plan_found) {
+        if(context.parameters.verbose)
+            statistics(current_time);
+        return FAILED_TIMEOUT;
+    }
+
+    return IN_PROGRESS;
+}
+
+void BeamSearchEngine::generate_successors(const BeamNodePtr &node, BeamLayerIndex &index,
+        vector<BeamNodePtr> &next_layer)
+{
+    const TimeStampedState &parent = node->state;
+    number_of_expanded_nodes++;
+
+    vector<const Operator *> all_operators;
+    context.task.successor_generator->generate_applicable_ops(parent, all_operators);
+
+    double maxTimeIncrement = 0.0;
+    for(int k = 0; k < parent.operators.size(); ++k) {
+        maxTimeIncrement = max(maxTimeIncrement, parent.time_increment(parent.operators[k]));
+    }
+
+    for(int j = 0; j < all_operators.size(); ++j) {
+        const Operator *op = all_operators[j];
+        assert(op->get_kind() != wait_op);
+
+        // throw away zero cost actions (can't handle) and actions that
+        // cannot improve on a known plan
+        double duration = op->get_duration(&parent);
+        if(duration <= 0.0)
+            continue;
+        double makespan = max(maxTimeIncrement, duration) + parent.timestamp;
+        if(makespan >= bestMakespan)
+            continue;
+        if(!op->is_applicable(parent, NULL, context.task.successor_generator->checks_start_conditions()))
+            continue;
+
+        BeamNodePtr child(new BeamNode(TimeStampedState(parent, *op), node, op));
+        child->preferred = find(node->preferred_operators.begin(),
+                node->preferred_operators.end(), op) != node->preferred_operators.end();
+        insert_into_layer(child, index, next_layer);
+    }
+
+    // only allow let_time_pass if there are running operators (i.e. there is time to pass)
+    if(!context.parameters.insert_let_time_pass_only_when_running_operators_not_empty
+            || !parent.operators.empty()) {
+        BeamNodePtr child(new BeamNode(parent.let_time_pass(false, true), node, context.task.let_time_pass));
+        // without a closed list, letting time pass without effect would loop
+        if(!TssEquals()(child->state, parent)
+                || !double_equals(child->state.timestamp, parent.timestamp)) {
+            insert_into_layer(child, index, next_layer);
+        }
+    }
+    search_statistics.finishExpansion();
+}
+
+void BeamSearchEngine::insert_into_layer(const BeamNodePtr &child, BeamLayerIndex &index,
+        vector<BeamNodePtr> &next_layer)
+{
+    BeamLayerIndex::iterator it = index.find(child->state);
+    if(it == index.end()) {
+        index.insert(make_pair(child->state, (int)next_layer.size()));
+        next_layer.push_back(child);
+        search_statistics.countChild(0);
+    } else if(child->state.timestamp + EPSILON < next_layer[it->second]->state.timestamp) {
+        next_layer[it->second] = child;
+    }
+}
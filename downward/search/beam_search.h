@@ -0,0 +1,104 @@
+#ifndef BEAM_SEARCH_H
+#define BEAM_SEARCH_H
+
+#include <vector>
+#include <tr1/memory>
+#include <tr1/unordered_map>
+#include "closed_list.h"
+#include "search_engine.h"
+#include "state.h"
+#include "operator.h"
+#include "search_statistics.h"
+#include "globals.h"
+
+class Heuristic;
+
+/// A node in the beam, owns its state and shares its predecessor chain.
+struct BeamNode
+{
+    TimeStampedState state;
+    std::tr1::shared_ptr<BeamNode> parent;
+    const Operator *op;         ///< operator leading from parent, the let_time_pass of the task for time passing
+    double h;
+    bool preferred;             ///< reached by a preferred operator of the parent
+    std::vector<const Operator *> preferred_operators;
+
+    BeamNode(const TimeStampedState &s, const std::tr1::shared_ptr<BeamNode> &p,
+            const Operator *o) :
+        state(s), parent(p), op(o), h(0.0), preferred(false)
+    {
+    }
+};
+
+typedef std::tr1::shared_ptr<BeamNode> BeamNodePtr;
+
+/// Maps states of the layer under construction to their index in that layer
+typedef std::tr1::unordered_map<TimeStampedState, int, TssHash, TssEquals> BeamLayerIndex;
+
+/// Beam search with layered expansion.
+/**
+ * Each layer holds at most beam_width states. All successors of a layer
+ * are generated, duplicates are removed within the new layer only and
+ * the best beam_width successors (by heuristic value, preferred operators
+ * and timestamp) form the next layer.
+ *
+ * There is no closed list: A state is kept alive only as long as it is
+ * in the current layer or is an ancestor of such a state, and the cache
+ * of the heuristic is cleared after each layer. Memory is thus bounded by
+ * beam_width states per layer of the current plan prefix plus the
+ * successors of one layer (beam_width times the branching factor), which
+ * are all generated and evaluated before the layer is pruned.
+ * The search is incomplete and returns FAILED when the beam runs empty or
+ * makes no heuristic progress for too long.
+ */
+class BeamSearchEngine : public SearchEngine
+{
+    private:
+        enum
+        {
+            MAX_LAYERS_WITHOUT_PROGRESS = 1000
+        };
+
+        Heuristic *heuristic;
+        int beam_width;
+
+        std::vector<BeamNodePtr> current_layer;
+
+        int layer;
+        int last_progress_layer;
+        double best_h;
+
+        int number_of_expanded_nodes;
+        unsigned int max_layer_size;     ///< largest layer before pruning to the beam width
+
+        time_t start_time;
+
+        SearchStatistics search_statistics;
+
+    private:
+        /// Evaluate node, returns false if it is a dead end.
+        bool evaluate(BeamNode &node);
+        void generate_successors(const BeamNodePtr &node, BeamLayerIndex &index,
+                std::vector<BeamNodePtr> &next_layer);
+        /// Insert child into next_layer unless a duplicate with earlier timestamp is there.
+        void insert_into_layer(const BeamNodePtr &child, BeamLayerIndex &index,
+                std::vector<BeamNodePtr> &next_layer);
+        void set_solution(const BeamNodePtr &goal_node);
+
+    protected:
+        virtual SearchEngine::status step();
+
+    public:
+        BeamSearchEngine(const SearchContext &context, Heuristic *heur, int width);
+        ~BeamSearchEngine();
+
+        virtual void statistics(time_t & current_time);
+        virtual void initialize();
+        virtual void dump_everything() const;
+        virtual int get_number_of_expanded_nodes() const
+        {
+            return number_of_expanded_nodes;
+        }
+};
+
+#endif
@@ -2,7 +2,11 @@
 
 #include "globals.h"
 #include "heuristic.h"
+#include "instrumentation.h"
 #include "successor_generator.h"
+#include "stubborn_sets.h"
+#include "symmetries.h"
+#include "event_stream.h"
 #include "plannerParameters.h"
 #include <time.h>
 #include <iomanip>
@@ -23,18 +27,21 @@ OpenListInfo::OpenListInfo(Heuristic *heur, bool only_pref, OpenListMode _mode)
 void BestFirstSearchEngine::reset() {
     cout << "RESET!" << endl;
     closed_list.clear();
+    if(symmetries)
+        symmetries->clear();
     numberOfSearchSteps = 0;
     lastProgressAtExpansionNumber = 0;
     assert(activeQueue < open_lists.size());
     for(unsigned int i = 0; i < open_lists.size(); ++i) {
         open_lists[i].priority = 0;
     }
-    current_state = *g_initial_state;
+    current_state = *context.task.initial_state;
     current_predecessor = NULL;
     current_operators.clear();
     for(unsigned int i = 0; i < open_lists.size(); ++i) {
         open_lists[i].open = OpenList();
     }
+    operator_lists.clear();
     for(unsigned int i = 0; i < best_heuristic_values_of_queues.size(); ++i) {
         best_heuristic_values_of_queues[i] = -1;
     }
@@ -54,18 +61,27 @@ void BestFirstSearchEngine::reset() {
     cout << endl;
 }
 
-BestFirstSearchEngine::BestFirstSearchEngine(QueueManagementMode _mode) :
-        number_of_expanded_nodes(0), current_state(*g_initial_state), mode(_mode)
+BestFirstSearchEngine::BestFirstSearchEngine(const SearchContext &context,
+        QueueManagementMode _mode) :
+        SearchEngine(context), number_of_expanded_nodes(0),
+        current_state(*context.task.initial_state), mode(_mode)
 {
     current_predecessor = 0;
     start_time = time(NULL);
-    bestMakespan = HUGE_VAL;
-    bestSumOfGoals = HUGE_VAL;
+    last_event_time = start_time;
     queueStartedLastWith = 0;
+    stubborn_sets = NULL;
+    if(context.parameters.use_stubborn_sets)
+        stubborn_sets = new StubbornSets(context.task);
+    symmetries = NULL;
+    if(context.parameters.use_symmetries)
+        symmetries = new Symmetries(context.task);
 }
 
 BestFirstSearchEngine::~BestFirstSearchEngine()
 {
+    delete stubborn_sets;
+    delete symmetries;
 }
 
 void BestFirstSearchEngine::add_heuristic(Heuristic *heuristic,
@@ -74,6 +90,7 @@ void BestFirstSearchEngine::add_heuristic(Heuristic *heuristic,
         bool pref_ops_ordered_mode,  bool pref_ops_rand_mode, bool pref_ops_concurrent_mode)
 {
     assert(use_estimates || use_preferred_operators);
+    assert(&heuristic->get_context().task == &context.task);
     if(pref_ops_ordered_mode) {
         best_heuristic_values_of_queues.push_back(-1);
         preferred_operator_heuristics_ordered.push_back(heuristic);
@@ -156,8 +173,25 @@ void BestFirstSearchEngine::statistics(time_t & current_time)
     for(unsigned int i = 0; i < best_heuristic_values_of_queues.size(); ++i) {
         cout << " [" << i << ": " << best_heuristic_values_of_queues[i] << "]";
     }
-    cout << endl << endl;
+    cout << endl;
+    dump_pruning_statistics();
+    dump_allocation_statistics();
+    cout << endl;
+}
 
+void BestFirstSearchEngine::dump_allocation_statistics() const
+{
+    SearchEngine::dump_allocation_statistics();
+    closed_list.dump_statistics();
+    operator_lists.dump_statistics("Open list operators");
+}
+
+void BestFirstSearchEngine::dump_pruning_statistics() const
+{
+    if(stubborn_sets)
+        stubborn_sets->dump_statistics();
+    if(symmetries)
+        symmetries->dump_statistics();
 }
 
 void BestFirstSearchEngine::dump_transition() const
@@ -165,7 +199,7 @@ void BestFirstSearchEngine::dump_transition() const
     cout << endl;
     if(current_predecessor != 0) {
         cout << "DEBUG: In step(), current predecessor is: " << endl;
-        current_predecessor->dump(g_parameters.verbose);
+        current_predecessor->dump(context.parameters.verbose);
     }
     cout << "DEBUG: In step(), current operators are: ";
     for(unsigned int i = 0; i < current_operators.size(); ++i) {
@@ -173,7 +207,7 @@ void BestFirstSearchEngine::dump_transition() const
     }
     cout << endl;
     cout << "DEBUG: In step(), current state is: " << endl;
-    current_state.dump(g_parameters.verbose);
+    current_state.dump(context.parameters.verbose);
     cout << endl;
 }
 
@@ -192,7 +226,8 @@ void BestFirstSearchEngine::dump_everything() const
             cout << "state" << endl;
             std::tr1::get<0>(*it2)->dump(true);
             cout << "ops: ";
-            const vector<const Operator*>& ops = std::tr1::get<1>(*it2);
+            vector<const Operator*> ops;
+            operator_lists.get(std::tr1::get<1>(*it2), ops);
             for(unsigned int i = 0; i < ops.size(); ++i) {
                 cout << "  " << ops[i]->get_name();
             }
@@ -213,7 +248,7 @@ SearchEngine::status BestFirstSearchEngine::step()
 
 
     numberOfSearchSteps++;
-    if(g_parameters.reset_after_solution_was_found && (mode == PRIORITY_BASED)
+    if(context.parameters.reset_after_solution_was_found && (mode == PRIORITY_BASED)
             && (numberOfSearchSteps - lastProgressAtExpansionNumber) > (5000-1)) {
         cout << "No progress since " << lastProgressAtExpansionNumber << ", now at " << numberOfSearchSteps << endl;
         reset();
@@ -223,12 +258,12 @@ SearchEngine::status BestFirstSearchEngine::step()
 
     double maxTimeIncrement = 0.0;
     for(int k = 0; k < current_state.operators.size(); ++k) {
-        maxTimeIncrement = max(maxTimeIncrement, current_state.operators[k].time_increment);
+        maxTimeIncrement = max(maxTimeIncrement, current_state.time_increment(current_state.operators[k]));
     }
     double makeSpan = maxTimeIncrement + current_state.timestamp;
 
     // when using subgoals we want to keep states with the same makespan as they might have better subgoals
-    if(g_parameters.use_subgoals_to_break_makespan_ties) {
+    if(context.parameters.use_subgoals_to_break_makespan_ties) {
         if (makeSpan <= bestMakespan && !closed_list.contains(current_state)) {
             discard = false;
         }
@@ -241,13 +276,20 @@ SearchEngine::status BestFirstSearchEngine::step()
     // throw away any states resulting from zero cost actions (can't handle)
     for(unsigned int i = 0; i < current_operators.size(); ++i) {
         if(current_predecessor && current_operators[i] &&
-                current_operators[i] != g_let_time_pass &&
+                current_operators[i] != context.task.let_time_pass &&
                 current_operators[i]->get_duration(current_predecessor) <= 0.0) {
             discard = true;
             break;
         }
     }
 
+    // a symmetric state has been closed before (the closed list keeps the
+    // real states, so plans can still be traced back)
+    if(!discard && symmetries && current_operators.size() <= 1
+            && symmetries->is_symmetric_duplicate(current_state)) {
+        discard = true;
+    }
+
     if(!discard) {
         const TimeStampedState* parent_ptr = NULL;
         if(current_operators.size() == 0) {
@@ -258,15 +300,16 @@ SearchEngine::status BestFirstSearchEngine::step()
         } else {
             for(unsigned int i = 0; i < current_operators.size(); ++i) {
                 assert(current_state.is_consistent_when_progressed());
-                assert(current_operators[i]->get_name().compare("wait") != 0);
+                assert(current_operators[i]->get_kind() != wait_op);
                 assert(current_predecessor != &current_state);
                 if(i>0) { //first operator has been applied in fetch_next_state()
                 	assert(activeQueue < open_lists.size());
-                    assert(g_parameters.pref_ops_concurrent_mode && open_lists[activeQueue].mode == CONCURRENT);
+                    assert(context.parameters.pref_ops_concurrent_mode && open_lists[activeQueue].mode == CONCURRENT);
                     if(!current_operators[i]->is_applicable(current_state)) {
                         continue;
                     }
-                    current_predecessor = new TimeStampedState(current_state);
+                    // current_state was closed for the previous operator
+                    current_predecessor = parent_ptr;
 
                     current_state = TimeStampedState(current_state, *current_operators[i]);
                     assert(current_state.is_consistent_when_progressed());
@@ -293,7 +336,7 @@ SearchEngine::status BestFirstSearchEngine::step()
                 return SOLVED;
             generate_successors(parent_ptr);
         }
-    } else if ((current_operators.size() == 1) && (current_operators[0] == g_let_time_pass) &&
+    } else if ((current_operators.size() == 1) && (current_operators[0] == context.task.let_time_pass) &&
             current_state.operators.empty() &&
             makeSpan < bestMakespan) {
         // arrived at same state by letting time pass
@@ -309,24 +352,28 @@ SearchEngine::status BestFirstSearchEngine::step()
     }
 
     time_t current_time = time(NULL);
-    static time_t last_stat_time = current_time;
-    if(g_parameters.verbose && current_time - last_stat_time >= 10) {
-        statistics(current_time);
-        last_stat_time = current_time;
+    report_statistics(current_time);
+    if(context.events.is_open() && current_time - last_event_time >= EventStream::STATISTICS_INTERVAL) {
+        vector<int> open_list_sizes;
+        for(int i = 0; i < open_lists.size(); i++)
+            open_list_sizes.push_back(open_lists[i].open.size());
+        context.events.statistics(number_of_expanded_nodes, search_statistics.generated_states,
+            open_list_sizes);
+        last_event_time = current_time;
     }
 
     // use different timeouts depending if we found a plan or not.
-    if(found_solution()) {
-        if (g_parameters.timeout_if_plan_found > 0 
-                && current_time - start_time > g_parameters.timeout_if_plan_found) {
-            if(g_parameters.verbose)
+    if(found_at_least_one_solution()) {
+        if (context.parameters.timeout_if_plan_found > 0 
+                && current_time - start_time > context.parameters.timeout_if_plan_found) {
+            if(context.parameters.verbose)
                 statistics(current_time);
             return SOLVED_TIMEOUT;
         }
     } else {
-        if (g_parameters.timeout_while_no_plan_found > 0 
-                && current_time - start_time > g_parameters.timeout_while_no_plan_found) {
-            if(g_parameters.verbose)
+        if (context.parameters.timeout_while_no_plan_found > 0 
+                && current_time - start_time > context.parameters.timeout_while_no_plan_found) {
+            if(context.parameters.verbose)
                 statistics(current_time);
             return FAILED_TIMEOUT;
         }
@@ -353,10 +400,10 @@ bool BestFirstSearchEngine::is_dead_end()
 
 bool BestFirstSearchEngine::check_goal()
 {
-    if (current_state.satisfies(g_goal)) {
+    if (current_state.satisfies(context.task.goal)) {
         Plan plan;
         PlanTrace path;
-        closed_list.trace_path(current_state, plan, path);
+        closed_list.trace_path(current_state, plan, path, path_states);
         set_plan(plan);
         set_path(path);
         return true;
@@ -382,14 +429,14 @@ bool BestFirstSearchEngine::check_goal()
         }
         // found goal
 
-        if(!current_state.satisfies(g_goal)) {  // will assert...
+        if(!current_state.satisfies(context.task.goal)) {  // will assert...
             dump_everything();
         }
-        assert(current_state.operators.empty() && current_state.satisfies(g_goal));
+        assert(current_state.operators.empty() && current_state.satisfies(context.task.goal));
 
         Plan plan;
         PlanTrace path;
-        closed_list.trace_path(current_state, plan, path);
+        closed_list.trace_path(current_state, plan, path, path_states);
         set_plan(plan);
         set_path(path);
         return true;
@@ -408,7 +455,8 @@ void BestFirstSearchEngine::dump_plan_prefix_for__state(const TimeStampedState &
 {
     Plan plan;
     PlanTrace path;
-    closed_list.trace_path(state, plan, path);
+    ObjectPool<TimeStampedState> states;
+    closed_list.trace_path(state, plan, path, states);
     for(int i = 0; i < plan.size(); i++) {
         const PlanStep& step = plan[i];
         cout << step.start_time << ": " << "(" << step.op->get_name() << ")"
@@ -418,7 +466,7 @@ void BestFirstSearchEngine::dump_plan_prefix_for__state(const TimeStampedState &
 
 bool BestFirstSearchEngine::check_progress()
 {
-    if(g_parameters.reward_only_pref_op_queue) {
+    if(context.parameters.reward_only_pref_op_queue) {
         bool progress = false;
         for(int i = 0; i < heuristics.size(); i++) {
             if(heuristics[i]->is_dead_end())
@@ -457,6 +505,7 @@ void BestFirstSearchEngine::report_progress()
             cout << "/";
     }
     cout << " [expanded " << closed_list.size() << " state(s)]" << endl;
+    context.events.progress(closed_list.size(), best_heuristic_values_of_queues);
 }
 
 void BestFirstSearchEngine::reward_progress()
@@ -471,7 +520,7 @@ void BestFirstSearchEngine::reward_progress()
     // from which the good state was extracted and/or the open queues
     // for the heuristic for which a new best value was found.
 
-    if(g_parameters.reward_only_pref_op_queue) {
+    if(context.parameters.reward_only_pref_op_queue) {
         for(int i = 0; i < open_lists.size(); i++)
             if(open_lists[i].mode == REGULAR)
                 open_lists[i].priority -= 1000;
@@ -482,23 +531,33 @@ void BestFirstSearchEngine::reward_progress()
     }
 }
 
-bool knownByLogicalStateOnly(LogicalStateClosedList& scl, const TimedSymbolicStates& timedSymbolicStates)
+std::size_t LogicalStateHash::operator()(const vector<double> &values) const
+{
+    std::tr1::hash<double> hash_value;
+    std::size_t ret = values.size();
+    for(int i = 0; i < values.size(); ++i)
+        ret ^= hash_value(values[i]) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
+    return ret;
+}
+
+bool knownByLogicalStateOnly(const SearchContext &context, LogicalStateClosedList& scl,
+        const TimedSymbolicStates& timedSymbolicStates)
 {
     // feature disabled -> return false = state unkown -> insert
-    if(!g_parameters.use_known_by_logical_state_only)
+    if(!context.parameters.use_known_by_logical_state_only)
        return false;
+    INSTRUMENT_PHASE(context.instrumentation, phase_closed_list);
     assert(timedSymbolicStates.size() > 0);
     bool ret = true;
     for (int i = 0; i < timedSymbolicStates.size(); ++i) {
-        if (scl.count(timedSymbolicStates[i].first) > 0) {
-            double currentBestMakespan = scl[timedSymbolicStates[i].first];
-            if (timedSymbolicStates[i].second + EPSILON < currentBestMakespan) {
-                ret = false;
-                scl[timedSymbolicStates[i].first] = timedSymbolicStates[i].second;
-            }
-        } else {
+        // one lookup: inserts the state if it is unknown
+        std::pair<LogicalStateClosedList::iterator, bool> known =
+            scl.insert(make_pair(timedSymbolicStates[i].first, timedSymbolicStates[i].second));
+        if (known.second) {
             ret = false;
-            scl[timedSymbolicStates[i].first] = timedSymbolicStates[i].second;
+        } else if (timedSymbolicStates[i].second + EPSILON < known.first->second) {
+            ret = false;
+            known.first->second = timedSymbolicStates[i].second;
         }
     }
     return ret;
@@ -507,9 +566,14 @@ bool knownByLogicalStateOnly(LogicalStateClosedList& scl, const TimedSymbolicSta
 void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_ptr)
 {
     vector<const Operator *> all_operators;
-    g_successor_generator->generate_applicable_ops(*parent_ptr, all_operators);
+    context.task.successor_generator->generate_applicable_ops(*parent_ptr, all_operators);
     // Filter ops that cannot be applicable just from the preprocess data (doesn't guarantee full applicability)
 
+    // Partial order reduction: only start operators of a stubborn set,
+    // preferred operators outside of it are dropped below.
+    if(stubborn_sets)
+        stubborn_sets->prune_operators(*parent_ptr, all_operators);
+
     vector<const Operator *> preferred_operators_reg;
     for(int i = 0; i < preferred_operator_heuristics_reg.size(); i++) {
         Heuristic *heur = preferred_operator_heuristics_reg[i];
@@ -701,12 +765,12 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 
         double priority = -1;   // invalid
         // lazy eval = compute priority by parent
-        if(g_parameters.lazy_evaluation) {
+        if(context.parameters.lazy_evaluation) {
             double parentG = getG(parent_ptr, parent_ptr, NULL);
             double parentH = heur->get_heuristic();
             assert(!heur->is_dead_end());
             double parentF = parentG + parentH;
-            if(g_parameters.greedy)
+            if(context.parameters.greedy)
                 priority = parentH;
             else
                 priority = parentF;
@@ -748,22 +812,22 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 
         // push successors from applicable ops
         if(open_lists[i].mode == CONCURRENT) {
-        	assert(g_parameters.pref_ops_concurrent_mode);
+        	assert(context.parameters.pref_ops_concurrent_mode);
         	vector<const Operator*> newOps;
         	TimeStampedState tss(*parent_ptr);
 			for(int j = 0; j < ops->size(); j++) {
-				assert((*ops)[j]->get_name().compare("wait") != 0);
+				assert((*ops)[j]->get_kind() != wait_op);
 
 				// compute expected min makespan of this op
 				double maxTimeIncrement = 0.0;
 				for(int k = 0; k < parent_ptr->operators.size(); ++k) {
-					maxTimeIncrement = max(maxTimeIncrement, parent_ptr->operators[k].time_increment);
+					maxTimeIncrement = max(maxTimeIncrement, parent_ptr->time_increment(parent_ptr->operators[k]));
 				}
 				double duration = (*ops)[j]->get_duration(parent_ptr);
 				maxTimeIncrement = max(maxTimeIncrement, duration);
 				double makespan = maxTimeIncrement + parent_ptr->timestamp;
 				bool betterMakespan = makespan < bestMakespan;
-				if(g_parameters.use_subgoals_to_break_makespan_ties && makespan == bestMakespan)
+				if(context.parameters.use_subgoals_to_break_makespan_ties && makespan == bestMakespan)
 					betterMakespan = true;
 
 				// Generate a child/Use an operator if
@@ -774,12 +838,13 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 				// only compute tss if needed
 				TimedSymbolicStates timedSymbolicStates;
 				TimedSymbolicStates* tssPtr = NULL;
-				if(g_parameters.use_known_by_logical_state_only)
+				if(context.parameters.use_known_by_logical_state_only)
 					tssPtr = &timedSymbolicStates;
-				if(betterMakespan && (*ops)[j]->is_applicable(*parent_ptr, tssPtr) &&
-						(!knownByLogicalStateOnly(logical_state_closed_list, timedSymbolicStates))) {
+				if(betterMakespan && (*ops)[j]->is_applicable(*parent_ptr, tssPtr,
+						context.task.successor_generator->checks_start_conditions()) &&
+						(!knownByLogicalStateOnly(context, logical_state_closed_list, timedSymbolicStates))) {
 					// non lazy eval = compute priority by child
-					if(!g_parameters.lazy_evaluation) {
+					if(!context.parameters.lazy_evaluation) {
 						// need to compute the child to evaluate it
 						tss = TimeStampedState(tss, *(*ops)[j]);
 						double childG = getG(&tss, parent_ptr, (*ops)[j]);
@@ -787,7 +852,7 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 						if(heur->is_dead_end())
 							assert(false);
 						double childF = childG + childH;
-						if(g_parameters.greedy)
+						if(context.parameters.greedy)
 							priority = childH;
 						else
 							priority = childF;
@@ -797,23 +862,24 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 				}
 			}
 			if(newOps.size() > 0) {
-			    open.push(std::tr1::make_tuple(parent_ptr, newOps, priority));
+			    INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+			    open.push(std::tr1::make_tuple(parent_ptr, operator_lists.add(newOps), priority));
 			    search_statistics.countChild(i);
 			}
         } else {
 			for(int j = 0; j < ops->size(); j++) {
-				assert((*ops)[j]->get_name().compare("wait") != 0);
+				assert((*ops)[j]->get_kind() != wait_op);
 
 				// compute expected min makespan of this op
 				double maxTimeIncrement = 0.0;
 				for(int k = 0; k < parent_ptr->operators.size(); ++k) {
-					maxTimeIncrement = max(maxTimeIncrement, parent_ptr->operators[k].time_increment);
+					maxTimeIncrement = max(maxTimeIncrement, parent_ptr->time_increment(parent_ptr->operators[k]));
 				}
 				double duration = (*ops)[j]->get_duration(parent_ptr);
 				maxTimeIncrement = max(maxTimeIncrement, duration);
 				double makespan = maxTimeIncrement + parent_ptr->timestamp;
 				bool betterMakespan = makespan < bestMakespan;
-				if(g_parameters.use_subgoals_to_break_makespan_ties && makespan == bestMakespan)
+				if(context.parameters.use_subgoals_to_break_makespan_ties && makespan == bestMakespan)
 					betterMakespan = true;
 
 				// Generate a child/Use an operator if
@@ -824,12 +890,13 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 				// only compute tss if needed
 				TimedSymbolicStates timedSymbolicStates;
 				TimedSymbolicStates* tssPtr = NULL;
-				if(g_parameters.use_known_by_logical_state_only)
+				if(context.parameters.use_known_by_logical_state_only)
 					tssPtr = &timedSymbolicStates;
-				if(betterMakespan && (*ops)[j]->is_applicable(*parent_ptr, tssPtr) &&
-						(!knownByLogicalStateOnly(logical_state_closed_list, timedSymbolicStates))) {
+				if(betterMakespan && (*ops)[j]->is_applicable(*parent_ptr, tssPtr,
+						context.task.successor_generator->checks_start_conditions()) &&
+						(!knownByLogicalStateOnly(context, logical_state_closed_list, timedSymbolicStates))) {
 					// non lazy eval = compute priority by child
-					if(!g_parameters.lazy_evaluation) {
+					if(!context.parameters.lazy_evaluation) {
 						// need to compute the child to evaluate it
 						TimeStampedState tss = TimeStampedState(*parent_ptr, *(*ops)[j]);
 						double childG = getG(&tss, parent_ptr, (*ops)[j]);
@@ -837,25 +904,23 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
 						if(heur->is_dead_end())
 							continue;
 						double childF = childG + childH;
-						if(g_parameters.greedy)
+						if(context.parameters.greedy)
 							priority = childH;
 						else
 							priority = childF;
 					}
 
-					vector<const Operator*> newOps;
-					newOps.push_back((*ops)[j]);
-					assert(newOps.size() > 0);
-					open.push(std::tr1::make_tuple(parent_ptr, newOps, priority));
+					INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+					open.push(std::tr1::make_tuple(parent_ptr, operator_lists.add((*ops)[j]), priority));
 					search_statistics.countChild(i);
 				}
 			}
         }
         // Inserted all children, now insert one more child by letting time pass
         // only allow let_time_pass if there are running operators (i.e. there is time to pass)
-        if(!g_parameters.insert_let_time_pass_only_when_running_operators_not_empty || !parent_ptr->operators.empty()) {
+        if(!context.parameters.insert_let_time_pass_only_when_running_operators_not_empty || !parent_ptr->operators.empty()) {
             // non lazy eval = compute priority by child
-            if(!g_parameters.lazy_evaluation) {
+            if(!context.parameters.lazy_evaluation) {
                 // compute child
                 TimeStampedState tss = parent_ptr->let_time_pass(false,true);
                 double childG = getG(&tss, parent_ptr, NULL);
@@ -865,15 +930,13 @@ void BestFirstSearchEngine::generate_successors(const TimeStampedState *parent_p
                 }
 
                 double childF = childH + childG;
-                if(g_parameters.greedy)
+                if(context.parameters.greedy)
                     priority = childH;
                 else
                     priority = childF;
             }
-            vector<const Operator*> newOps;
-            newOps.push_back(g_let_time_pass);
-            assert(newOps.size() > 0);
-            open.push(std::tr1::make_tuple(parent_ptr, newOps, priority));
+            INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+            open.push(std::tr1::make_tuple(parent_ptr, operator_lists.add(context.task.let_time_pass), priority));
             search_statistics.countChild(i);
         }
     }
@@ -889,7 +952,7 @@ enum SearchEngine::status BestFirstSearchEngine::fetch_next_state()
             return SOLVED_COMPLETE;
         }
         
-        if(g_parameters.verbose) {
+        if(context.parameters.verbose) {
             time_t current_time = time(NULL);
             statistics(current_time);
         }
@@ -897,22 +960,26 @@ enum SearchEngine::status BestFirstSearchEngine::fetch_next_state()
         return FAILED;
     }
 
-    std::tr1::tuple<const TimeStampedState *, vector<const Operator *>, double> next =
-        open_info->open.top();
-    open_info->open.pop();
+    OpenListEntry next;
+    {
+        INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+        next = open_info->open.top();
+        open_info->open.pop();
+    }
     open_info->priority++;
 
     current_predecessor = std::tr1::get<0>(next);
-    current_operators = std::tr1::get<1>(next);
+    operator_lists.get(std::tr1::get<1>(next), current_operators);
+    operator_lists.release(std::tr1::get<1>(next));
 
-    if(current_operators.size() == 1 && current_operators[0] == g_let_time_pass) {
+    if(current_operators.size() == 1 && current_operators[0] == context.task.let_time_pass) {
         // do not apply an operator but rather let some time pass until
         // next scheduled happening
         current_state = current_predecessor->let_time_pass(false,true);
     } else {
         //Apply the first operator. Others are applied in step()
         if(current_operators.size() > 0) {
-        	assert(current_operators[0]->get_name().compare("wait") != 0);
+        	assert(current_operators[0]->get_kind() != wait_op);
         	assert(current_operators[0]->is_applicable(*current_predecessor));
         	current_state = TimeStampedState(*current_predecessor, *current_operators[0]);
         }
@@ -958,7 +1025,7 @@ double BestFirstSearchEngine::getGc(const TimeStampedState *state,
         const Operator *op) const
 {
     double opCost = 0.0;
-    if (op && op != g_let_time_pass) {
+    if (op && op != context.task.let_time_pass) {
         opCost += op->get_duration(state);
     }
     return getGc(state) + opCost;
@@ -970,7 +1037,7 @@ double BestFirstSearchEngine::getGm(const TimeStampedState *state) const
     for (int i = 0; i < state->operators.size(); ++i) {
         const ScheduledOperator* op = &state->operators[i];
         double duration = 0.0;
-        if (op && op != g_let_time_pass) {
+        if (op && op != context.task.let_time_pass) {
             duration = op->get_duration(state);
         }
         if (duration > longestActionDuration) {
@@ -997,7 +1064,7 @@ double BestFirstSearchEngine::getG(const TimeStampedState* state_ptr,
         const TimeStampedState* closed_ptr, const Operator* op) const
 {
     double g = HUGE_VAL;
-    switch(g_parameters.g_values) {
+    switch(context.parameters.g_values) {
         case PlannerParameters::GTimestamp:
             g = getGt(state_ptr);
             break;
@@ -1012,11 +1079,11 @@ double BestFirstSearchEngine::getG(const TimeStampedState* state_ptr,
             break;
         case PlannerParameters::GWeighted:
             if(op == NULL)
-                g = g_parameters.g_weight * getGm(state_ptr) 
-                    + (1.0 - g_parameters.g_weight) * getGc(closed_ptr);
+                g = context.parameters.g_weight * getGm(state_ptr) 
+                    + (1.0 - context.parameters.g_weight) * getGc(closed_ptr);
             else
-                g = g_parameters.g_weight * getGm(state_ptr) 
-                    + (1.0 - g_parameters.g_weight) * getGc(closed_ptr, op);
+                g = context.parameters.g_weight * getGm(state_ptr) 
+                    + (1.0 - context.parameters.g_weight) * getGc(closed_ptr, op);
             break;
         default:
             assert(false);
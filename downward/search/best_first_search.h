@@ -8,12 +8,16 @@
 #include "state.h"
 #include "operator.h"
 #include <tr1/tuple>
+#include <tr1/unordered_map>
 #include "search_statistics.h"
 #include "globals.h"
 
 class Heuristic;
+class StubbornSets;
+class Symmetries;
 
-typedef std::tr1::tuple<const TimeStampedState *, vector<const Operator *>, double> OpenListEntry;
+/// Predecessor, index of the operators to apply in the operator_lists of the engine, priority.
+typedef std::tr1::tuple<const TimeStampedState *, int, double> OpenListEntry;
 
 class OpenListEntryCompare
 {
@@ -37,9 +41,15 @@ struct OpenListInfo
     int priority; // low value indicates high priority
 };
 
+/// Hash of the logical and primitive functional values of a state (see TimedSymbolicState).
+struct LogicalStateHash
+{
+    std::size_t operator()(const std::vector<double> &values) const;
+};
+
 /// Maps logical state to best timestamp for that state
-typedef std::map<std::vector<double>, double> LogicalStateClosedList;
-bool knownByLogicalStateOnly(LogicalStateClosedList& scl,
+typedef std::tr1::unordered_map<std::vector<double>, double, LogicalStateHash> LogicalStateClosedList;
+bool knownByLogicalStateOnly(const SearchContext &context, LogicalStateClosedList& scl,
         const TimedSymbolicStates& timedSymbolicStates);
 
 class BestFirstSearchEngine : public SearchEngine
@@ -53,6 +63,8 @@ class BestFirstSearchEngine : public SearchEngine
         std::vector<Heuristic *> preferred_operator_heuristics_rand;
         std::vector<Heuristic *> preferred_operator_heuristics_concurrent;
         ClosedList closed_list;
+        /// The operators of the open list entries, released when popped and on reset().
+        PointerArena<const Operator> operator_lists;
         int number_of_expanded_nodes;
         
         LogicalStateClosedList logical_state_closed_list;
@@ -64,9 +76,13 @@ class BestFirstSearchEngine : public SearchEngine
         vector<const Operator*> current_operators;
 
         time_t start_time;
+        time_t last_event_time;     ///< when the last statistics event was written
 
         SearchStatistics search_statistics;
 
+        StubbornSets *stubborn_sets;    ///< partial order reduction, NULL if disabled
+        Symmetries *symmetries;         ///< symmetric duplicate pruning, NULL if disabled
+
         int activeQueue;
         int lastProgressAtExpansionNumber;
         int numberOfSearchSteps;
@@ -105,19 +121,22 @@ class BestFirstSearchEngine : public SearchEngine
             ROUND_ROBIN, PRIORITY_BASED
         } mode;
 
-        BestFirstSearchEngine(QueueManagementMode _mode);
+        BestFirstSearchEngine(const SearchContext &context, QueueManagementMode _mode);
         ~BestFirstSearchEngine();
         void add_heuristic(Heuristic *heuristic, bool use_estimates,
                 bool use_preferred_operators, bool pref_ops_cheapest_mode = false,
                 bool pref_ops_most_expensive_mode = false, bool pref_ops_ordered_mode = false,
                 bool pref_ops_rand_mode = false, bool pref_ops_concurrent_mode = false);
         virtual void statistics(time_t & current_time);
+        /// Print statistics of successor pruning techniques (if enabled).
+        void dump_pruning_statistics() const;
+        virtual void dump_allocation_statistics() const;
+        virtual int get_number_of_expanded_nodes() const
+        {
+            return number_of_expanded_nodes;
+        }
         virtual void initialize();
         SearchEngine::status fetch_next_state();
-
-    public:
-        double bestMakespan;
-        double bestSumOfGoals;
 };
 
 #endif
@@ -0,0 +1,314 @@
+#include "best_first_width_search.h"
+
+#include "globals.h"
+#include "heuristic.h"
+#include "instrumentation.h"
+#include "successor_generator.h"
+#include "plannerParameters.h"
+#include <time.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+/// Largest size (in bits) of the pair tables of all partitions together
+/// before width 2 is disabled (128 MB)
+static const size_t MAX_PAIR_TABLE_BITS = size_t(1) << 30;
+
+static const size_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+
+NoveltyTable::NoveltyTable(const Task &task, int max_width) :
+        task(task), num_atoms(0), width(max_width)
+{
+    assert(width >= 1);
+    var_offset.resize(task.variable_domain.size(), -1);
+    for(int i = 0; i < task.variable_domain.size(); ++i) {
+        if(task.is_functional(i) || task.variable_domain[i] <= 0)
+            continue;
+        var_offset[i] = num_atoms;
+        num_atoms += task.variable_domain[i];
+    }
+    running_op_atom.resize(task.operators.size());
+    for(int i = 0; i < task.operators.size(); ++i) {
+        running_op_atom[i] = num_atoms;
+        num_atoms++;
+    }
+
+    if(num_atoms < 2)
+        width = 1;
+    // the tables are allocated when a partition is first seen, but every
+    // partition may be seen during the search
+    int num_partitions = task.goal.size() + 1;
+    size_t pair_bits_per_partition = size_t(num_atoms) * (num_atoms - 1) / 2;
+    if(width > 1 && pair_bits_per_partition > MAX_PAIR_TABLE_BITS / num_partitions) {
+        cout << "Novelty pair tables would need " << pair_bits_per_partition
+            << " bits for each of " << num_partitions
+            << " partitions, reducing width to 1." << endl;
+        width = 1;
+    }
+    width = min(width, 2);
+
+    atom_bits.resize(num_partitions);
+    if(width > 1)
+        pair_bits.resize(num_partitions);
+}
+
+bool NoveltyTable::test_and_set(vector<unsigned long> &bits, size_t bit)
+{
+    unsigned long &word = bits[bit / BITS_PER_WORD];
+    unsigned long mask = 1UL << (bit % BITS_PER_WORD);
+    if(word & mask)
+        return false;
+    word |= mask;
+    return true;
+}
+
+size_t NoveltyTable::pair_index(int atom1, int atom2) const
+{
+    assert(atom1 < atom2);
+    size_t a = atom1;
+    return a * (2 * size_t(num_atoms) - a - 1) / 2 + (atom2 - atom1 - 1);
+}
+
+void NoveltyTable::get_atoms(const TimeStampedState &state, vector<int> &atoms) const
+{
+    atoms.clear();
+    for(int i = 0; i < state.state.size(); ++i) {
+        if(var_offset[i] < 0)
+            continue;
+        int value = static_cast<int>(state.state[i]);
+        if(value < 0 || value >= task.variable_domain[i])
+            continue;
+        atoms.push_back(var_offset[i] + value);
+    }
+    for(int i = 0; i < state.operators.size(); ++i) {
+        int id = state.operators[i].get_id();
+        if(id >= 0)
+            atoms.push_back(running_op_atom[id]);
+    }
+    sort(atoms.begin(), atoms.end());
+    atoms.erase(unique(atoms.begin(), atoms.end()), atoms.end());
+}
+
+int NoveltyTable::compute_novelty(const vector<int> &atoms, int partition)
+{
+    assert(partition >= 0 && partition < atom_bits.size());
+    vector<unsigned long> &atoms_seen = atom_bits[partition];
+    if(atoms_seen.empty())
+        atoms_seen.resize(num_atoms / BITS_PER_WORD + 1, 0);
+
+    bool new_atom = false;
+    for(int i = 0; i < atoms.size(); ++i) {
+        if(test_and_set(atoms_seen, atoms[i]))
+            new_atom = true;
+    }
+
+    bool new_pair = false;
+    if(width > 1) {
+        vector<unsigned long> &pairs_seen = pair_bits[partition];
+        if(pairs_seen.empty())
+            pairs_seen.resize(pair_index(num_atoms - 2, num_atoms - 1) / BITS_PER_WORD + 1, 0);
+        for(int i = 0; i < atoms.size(); ++i) {
+            for(int j = i + 1; j < atoms.size(); ++j) {
+                if(test_and_set(pairs_seen, pair_index(atoms[i], atoms[j])))
+                    new_pair = true;
+            }
+        }
+    }
+
+    if(new_atom)
+        return 1;
+    if(new_pair)
+        return 2;
+    return NOT_NOVEL;
+}
+
+BestFirstWidthSearchEngine::BestFirstWidthSearchEngine(const SearchContext &context,
+        Heuristic *heur, int width) :
+        SearchEngine(context), heuristic(heur), novelty_table(context.task, width),
+        number_of_expanded_nodes(0),
+        best_h(HUGE_VAL)
+{
+    novelty_counts.resize(NoveltyTable::NOT_NOVEL + 1, 0);
+    start_time = time(NULL);
+}
+
+BestFirstWidthSearchEngine::~BestFirstWidthSearchEngine()
+{
+}
+
+void BestFirstWidthSearchEngine::initialize()
+{
+    cout << "INIT (best first width search, width " << novelty_table.get_width()
+        << ", " << novelty_table.get_num_atoms() << " atoms)" << endl;
+    TimeStampedState initial_state = *context.task.initial_state;
+    insert_child(NULL, NULL, initial_state);
+}
+
+void BestFirstWidthSearchEngine::statistics(time_t & current_time)
+{
+    cout << endl;
+    cout << "Search Time: " << (current_time - start_time) << " sec." << endl;
+    search_statistics.dump(number_of_expanded_nodes, current_time);
+    cout << "OpenList size: " << open.size() << endl;
+    cout << "Generated states by novelty:";
+    for(int i = 1; i < novelty_counts.size(); ++i) {
+        cout << " [" << i << ": " << novelty_counts[i] << "]";
+    }
+    cout << endl;
+    if(heuristic) {
+        cout << "Heuristic Computations: " << heuristic->get_num_computations() << endl;
+        cout << "Number of cache hits in heuristic: " << heuristic->get_num_cache_hits() << endl;
+    }
+    cout << "Best heuristic value: " << best_h << endl;
+    dump_allocation_statistics();
+    cout << endl;
+}
+
+void BestFirstWidthSearchEngine::dump_allocation_statistics() const
+{
+    SearchEngine::dump_allocation_statistics();
+    closed_list.dump_statistics();
+}
+
+void BestFirstWidthSearchEngine::dump_everything() const
+{
+    cout << "DEBUG: open list size: " << open.size() << endl;
+    if(!open.empty()) {
+        const WidthOpenListEntry &top = open.top();
+        cout << "DEBUG: next state (novelty " << tr1::get<1>(top)
+            << ", value " << tr1::get<2>(top) << "):" << endl;
+        tr1::get<0>(top)->dump(true);
+    }
+}
+
+int BestFirstWidthSearchEngine::goal_count(const TimeStampedState &state) const
+{
+    int count = 0;
+    for(int i = 0; i < context.task.goal.size(); ++i) {
+        if(!double_equals(state.state[context.task.goal[i].first], context.task.goal[i].second))
+            count++;
+    }
+    return count;
+}
+
+bool BestFirstWidthSearchEngine::check_goal(const TimeStampedState &state)
+{
+    // running operators must have ended, otherwise the plan cannot be rescheduled
+    if(state.operators.empty() && state.satisfies(context.task.goal)) {
+        Plan plan;
+        PlanTrace path;
+        closed_list.trace_path(state, plan, path, path_states);
+        set_plan(plan);
+        set_path(path);
+        return true;
+    }
+    return false;
+}
+
+SearchEngine::status BestFirstWidthSearchEngine::step()
+{
+    if(open.empty()) {
+        if(context.parameters.verbose) {
+            time_t current_time = time(NULL);
+            statistics(current_time);
+        }
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+
+    const TimeStampedState *state_ptr;
+    {
+        INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+        state_ptr = tr1::get<0>(open.top());
+        open.pop();
+    }
+    if(check_goal(*state_ptr))
+        return SOLVED;
+    generate_successors(state_ptr);
+
+    time_t current_time = time(NULL);
+    report_statistics(current_time);
+
+    // stops at the first plan, so only the timeout for "no plan found" applies here.
+    if (context.parameters.timeout_while_no_plan_found > 0
+            && current_time - start_time > context.parameters.timeout_while_no_plan_found) {
+        if(context.parameters.verbose)
+            statistics(current_time);
+        return FAILED_TIMEOUT;
+    }
+
+    return IN_PROGRESS;
+}
+
+void BestFirstWidthSearchEngine::generate_successors(const TimeStampedState *parent_ptr)
+{
+    number_of_expanded_nodes++;
+
+    vector<const Operator *> all_operators;
+    context.task.successor_generator->generate_applicable_ops(*parent_ptr, all_operators);
+
+    double maxTimeIncrement = 0.0;
+    for(int k = 0; k < parent_ptr->operators.size(); ++k) {
+        maxTimeIncrement = max(maxTimeIncrement, parent_ptr->time_increment(parent_ptr->operators[k]));
+    }
+
+    for(int j = 0; j < all_operators.size(); ++j) {
+        const Operator *op = all_operators[j];
+        assert(op->get_kind() != wait_op);
+
+        // throw away zero cost actions (can't handle) and actions that
+        // cannot improve on a known plan
+        double duration = op->get_duration(parent_ptr);
+        if(duration <= 0.0)
+            continue;
+        double makespan = max(maxTimeIncrement, duration) + parent_ptr->timestamp;
+        if(makespan >= bestMakespan)
+            continue;
+        if(!op->is_applicable(*parent_ptr, NULL, context.task.successor_generator->checks_start_conditions()))
+            continue;
+
+        TimeStampedState child(*parent_ptr, *op);
+        insert_child(parent_ptr, op, child);
+    }
+
+    // only allow let_time_pass if there are running operators (i.e. there is time to pass)
+    if(!context.parameters.insert_let_time_pass_only_when_running_operators_not_empty
+            || !parent_ptr->operators.empty()) {
+        TimeStampedState child = parent_ptr->let_time_pass(false, true);
+        insert_child(parent_ptr, context.task.let_time_pass, child);
+    }
+    search_statistics.finishExpansion();
+}
+
+void BestFirstWidthSearchEngine::insert_child(const TimeStampedState *parent_ptr,
+        const Operator *op, TimeStampedState &child)
+{
+    if(parent_ptr && closed_list.contains(child))
+        return;
+    const TimeStampedState *child_ptr = closed_list.insert(child, parent_ptr, op);
+    search_statistics.countChild(0);
+
+    int unsatisfied_goals = goal_count(*child_ptr);
+    double h = unsatisfied_goals;
+    if(heuristic) {
+        h = heuristic->evaluate(*child_ptr);
+        if(heuristic->is_dead_end())
+            return;
+    }
+
+    vector<int> atoms;
+    novelty_table.get_atoms(*child_ptr, atoms);
+    int novelty = novelty_table.compute_novelty(atoms, unsatisfied_goals);
+    novelty_counts[novelty]++;
+
+    if(h < best_h) {
+        best_h = h;
+        cout << "Best heuristic value: " << best_h << " [expanded "
+            << number_of_expanded_nodes << " state(s)]" << endl;
+    }
+    INSTRUMENT_PHASE(context.instrumentation, phase_open_list);
+    open.push(tr1::make_tuple(child_ptr, novelty, h, child_ptr->timestamp));
+}
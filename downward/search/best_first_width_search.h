@@ -0,0 +1,132 @@
+#ifndef BEST_FIRST_WIDTH_SEARCH_H
+#define BEST_FIRST_WIDTH_SEARCH_H
+
+#include <vector>
+#include <queue>
+#include <tr1/tuple>
+#include "closed_list.h"
+#include "search_engine.h"
+#include "state.h"
+#include "operator.h"
+#include "search_statistics.h"
+#include "globals.h"
+
+class Heuristic;
+
+/// Novelty tables for width 1 (atoms) and width 2 (atom pairs).
+/**
+ * Atoms are the values of the logical variables of TimeStampedState::state
+ * plus one atom per operator for "operator is running". Tables are kept
+ * per partition (the number of unsatisfied goals) as plain bit vectors
+ * sized from the variable domains of the task. Width 2 is only used if
+ * the pair tables of all partitions fit into a fixed limit.
+ */
+class NoveltyTable
+{
+    private:
+        const Task &task;
+        std::vector<int> var_offset;     ///< first atom of each variable, -1 if not logical
+        std::vector<int> running_op_atom;   ///< operator id -> atom
+        int num_atoms;
+        int width;
+
+        /// one bit vector per partition, empty until the partition is seen
+        std::vector<std::vector<unsigned long> > atom_bits;
+        std::vector<std::vector<unsigned long> > pair_bits;
+
+        static bool test_and_set(std::vector<unsigned long> &bits, size_t bit);
+        size_t pair_index(int atom1, int atom2) const;
+
+    public:
+        enum
+        {
+            NOT_NOVEL = 3
+        };
+
+        /// Build the atom numbering, widths > 1 are reduced if the pair tables get too large.
+        NoveltyTable(const Task &task, int max_width);
+
+        /// Collect the atoms of state (sorted).
+        void get_atoms(const TimeStampedState &state, std::vector<int> &atoms) const;
+
+        /// Compute novelty of atoms in partition and add them to the tables.
+        /**
+         * \returns 1 if an atom is new, 2 if only a pair of atoms is new,
+         * NOT_NOVEL otherwise.
+         */
+        int compute_novelty(const std::vector<int> &atoms, int partition);
+
+        int get_num_atoms() const { return num_atoms; }
+        int get_width() const { return width; }
+};
+
+/// Open list entry: state, novelty, secondary key (heuristic), timestamp.
+typedef std::tr1::tuple<const TimeStampedState *, int, double, double> WidthOpenListEntry;
+
+class WidthOpenListEntryCompare
+{
+    public:
+        bool operator()(const WidthOpenListEntry &left_entry, const WidthOpenListEntry &right_entry) const
+        {
+            if(std::tr1::get<1>(left_entry) != std::tr1::get<1>(right_entry))
+                return std::tr1::get<1>(right_entry) < std::tr1::get<1>(left_entry);
+            if(std::tr1::get<2>(left_entry) != std::tr1::get<2>(right_entry))
+                return std::tr1::get<2>(right_entry) < std::tr1::get<2>(left_entry);
+            return std::tr1::get<3>(right_entry) < std::tr1::get<3>(left_entry);
+        }
+};
+
+typedef std::priority_queue<WidthOpenListEntry, std::vector<WidthOpenListEntry>,
+        WidthOpenListEntryCompare> WidthOpenList;
+
+/// Best-first width search (BFWS).
+/**
+ * Expands states ordered by novelty first and by a secondary key second.
+ * The secondary key is the given heuristic (CEA), or the number of
+ * unsatisfied goals if no heuristic is given. Novelty is computed relative
+ * to all states generated before with the same number of unsatisfied goals.
+ * States that are not novel are still kept, so the search is complete.
+ */
+class BestFirstWidthSearchEngine : public SearchEngine
+{
+    private:
+        Heuristic *heuristic;
+        NoveltyTable novelty_table;
+        ClosedList closed_list;
+        WidthOpenList open;
+
+        int number_of_expanded_nodes;
+        std::vector<int> novelty_counts;     ///< number of generated states per novelty
+        double best_h;
+
+        time_t start_time;
+
+        SearchStatistics search_statistics;
+
+    private:
+        int goal_count(const TimeStampedState &state) const;
+        bool check_goal(const TimeStampedState &state);
+        /// Insert child into closed list, evaluate and open it.
+        void insert_child(const TimeStampedState *parent_ptr, const Operator *op,
+                TimeStampedState &child);
+        void generate_successors(const TimeStampedState *parent_ptr);
+
+    protected:
+        virtual SearchEngine::status step();
+
+    public:
+        /// \param heur secondary key, use goal count if NULL
+        BestFirstWidthSearchEngine(const SearchContext &context, Heuristic *heur, int width);
+        ~BestFirstWidthSearchEngine();
+
+        virtual void statistics(time_t & current_time);
+        virtual void dump_allocation_statistics() const;
+        virtual void initialize();
+        virtual void dump_everything() const;
+        virtual int get_number_of_expanded_nodes() const
+        {
+            return number_of_expanded_nodes;
+        }
+};
+
+#endif
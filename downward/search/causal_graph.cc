@@ -1,16 +1,18 @@
 #include "causal_graph.h"
 #include "globals.h"
 #include "domain_transition_graph.h"
+#include "task_reader.h"
 
 #include <algorithm>
 #include <iostream>
 #include <cassert>
 using namespace std;
 
-CausalGraph::CausalGraph(istream &in)
+CausalGraph::CausalGraph(const Task &task, TaskReader &in) :
+    task(task)
 {
     check_magic(in, "begin_CG");
-    int var_count = g_variable_domain.size();
+    int var_count = task.variable_domain.size();
     arcs.resize(var_count);
     edges.resize(var_count);
     for(int from_node = 0; from_node < var_count; from_node++) {
@@ -46,9 +48,9 @@ const vector<int> &CausalGraph::get_neighbours(int var) const
 void CausalGraph::get_comp_vars_for_func_var(int var, vector<int>& comp_vars)
 {
     for(int i = 0; i < arcs[var].size(); ++i) {
-        if(g_variable_types[arcs[var][i]] == comparison) {
+        if(task.variable_types[arcs[var][i]] == comparison) {
             comp_vars.push_back(arcs[var][i]);
-        } else if(g_variable_types[arcs[var][i]] == subterm_functional) {
+        } else if(task.variable_types[arcs[var][i]] == subterm_functional) {
             get_comp_vars_for_func_var(arcs[var][i], comp_vars);
         }
     }
@@ -72,11 +74,11 @@ void CausalGraph::get_functional_vars_in_unrolled_term(int top_var,
         if(!current_is_predecessor_of_top_var) {
             continue;
         }
-        if(g_variable_types[current_var] == primitive_functional) {
+        if(task.variable_types[current_var] == primitive_functional) {
             intermediate_vars.insert(current_var);
         } else {
-            assert (g_variable_types[current_var] != comparison);
-            if(g_variable_types[current_var] == subterm_functional) {
+            assert (task.variable_types[current_var] != comparison);
+            if(task.variable_types[current_var] == subterm_functional) {
                 get_functional_vars_in_unrolled_term(current_var, intermediate_vars);
             }
         }
@@ -87,9 +89,9 @@ void CausalGraph::dump() const
 {
     cout << "Causal graph: " << endl;
     for(int i = 0; i < arcs.size(); i++) {
-        cout << "dependent on var " << g_variable_name[i] << ": " << endl;
+        cout << "dependent on var " << task.variable_name[i] << ": " << endl;
         for(int j = 0; j < arcs[i].size(); j++)
-            cout << "  " << g_variable_name[arcs[i][j]] << ",";
+            cout << "  " << task.variable_name[arcs[i][j]] << ",";
         cout << endl;
     }
 }
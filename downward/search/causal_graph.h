@@ -7,12 +7,16 @@
 #include <map>
 using namespace std;
 
+class TaskReader;
+struct Task;
+
 class CausalGraph
 {
+        const Task &task;
         vector<vector<int> > arcs;
         vector<vector<int> > edges;
     public:
-        CausalGraph(istream &in);
+        CausalGraph(const Task &task, TaskReader &in);
         ~CausalGraph()
         {
         }
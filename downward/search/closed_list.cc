@@ -1,4 +1,5 @@
 #include "closed_list.h"
+#include "instrumentation.h"
 
 // #include "state.h"
 
@@ -52,9 +53,10 @@ bool prevailEquals(const Prevail &prev1, const Prevail &prev2)
     return true;
 }
 
-bool scheduledConditionEquals(const ScheduledCondition &cond1, const ScheduledCondition &cond2)
+bool scheduledConditionEquals(const ScheduledCondition &cond1, double timestamp1,
+        const ScheduledCondition &cond2, double timestamp2)
 {
-    if(!double_equals(cond1.time_increment, cond2.time_increment))
+    if(!double_equals(cond1.time - timestamp1, cond2.time - timestamp2))
         return false;
     if(cond1.var != cond2.var)
         return false;
@@ -63,10 +65,15 @@ bool scheduledConditionEquals(const ScheduledCondition &cond1, const ScheduledCo
     return true;
 }
 
-bool scheduledEffectEquals(const ScheduledEffect &eff1, const ScheduledEffect &eff2)
+bool scheduledEffectEquals(const ScheduledEffect &seff1, double timestamp1,
+        const ScheduledEffect &seff2, double timestamp2)
 {
-    if(!double_equals(eff1.time_increment, eff2.time_increment))
+    if(!double_equals(seff1.time - timestamp1, seff2.time - timestamp2))
         return false;
+    if(seff1.effect == seff2.effect)
+        return true;
+    const PrePost &eff1 = *seff1.effect;
+    const PrePost &eff2 = *seff2.effect;
     if(eff1.var != eff2.var)
         return false;
     if(!double_equals(eff1.pre, eff2.pre))
@@ -95,6 +102,21 @@ bool scheduledEffectEquals(const ScheduledEffect &eff1, const ScheduledEffect &e
     return true;
 }
 
+/// Whether the events of two states are equal, see scheduledConditionEquals.
+template<class Event>
+static bool eventsEqual(const vector<Event> &events1, double timestamp1,
+        const vector<Event> &events2, double timestamp2,
+        bool (*equals)(const Event &, double, const Event &, double))
+{
+    if(events1.size() != events2.size())
+        return false;
+    for(int i = 0; i < events1.size(); ++i) {
+        if(!equals(events1[i], timestamp1, events2[i], timestamp2))
+            return false;
+    }
+    return true;
+}
+
 bool TssEquals::operator()(const TimeStampedState &tss1, const TimeStampedState &tss2) const
 {
     assert(tss1.state.size() == tss2.state.size());
@@ -104,19 +126,20 @@ bool TssEquals::operator()(const TimeStampedState &tss1, const TimeStampedState
         return false;
     if(tss1.conds_at_end.size() != tss2.conds_at_end.size())
         return false;
-    if(!equal(tss1.scheduled_effects.begin(), tss1.scheduled_effects.end(),
-                tss2.scheduled_effects.begin(), scheduledEffectEquals))
+    if(!eventsEqual(tss1.scheduled_effects, tss1.timestamp,
+                tss2.scheduled_effects, tss2.timestamp, scheduledEffectEquals))
         return false;
-    if(!equal(tss1.conds_over_all.begin(), tss1.conds_over_all.end(),
-                tss2.conds_over_all.begin(), scheduledConditionEquals))
+    if(!eventsEqual(tss1.conds_over_all, tss1.timestamp,
+                tss2.conds_over_all, tss2.timestamp, scheduledConditionEquals))
         return false;
-    if(!equal(tss1.conds_at_end.begin(), tss1.conds_at_end.end(),
-                tss2.conds_at_end.begin(), scheduledConditionEquals))
+    if(!eventsEqual(tss1.conds_at_end, tss1.timestamp,
+                tss2.conds_at_end, tss2.timestamp, scheduledConditionEquals))
         return false;
 
+    const vector<variable_type> &types = tss1.get_task().variable_types;
     for(int i = 0; i < tss1.state.size(); ++i) {
-        if (!(g_variable_types[i] == primitive_functional
-                    || g_variable_types[i] == logical)) {
+        if (!(types[i] == primitive_functional
+                    || types[i] == logical)) {
             continue;
         }
 
@@ -181,33 +204,39 @@ const TimeStampedState *ClosedList::insert(
         TimeStampedState &entry, const TimeStampedState *predecessor,
         const Operator *annotation)
 {
-    ClosedListMap::iterator ret =
-        closed.insert(ValuePair(entry, PredecessorInfo(predecessor, annotation)));
-    //    assert(ret.second);
-    return &ret->first;
+    INSTRUMENT_PHASE(entry.get_context().instrumentation, phase_closed_list);
+    const TimeStampedState *state = states.create(entry);
+    closed.insert(ValuePair(state, PredecessorInfo(predecessor, annotation)));
+    return state;
 }
 
 void ClosedList::clear()
 {
     closed.clear();
+    states.clear();
 }
 
 bool ClosedList::contains(const TimeStampedState &entry) const
 {
+    // timed by get_min_ts_of_key
     double min_so_far = get_min_ts_of_key(entry);
     double diff = entry.timestamp - min_so_far;
-    return (!(diff + EPSILON < 0));
+    bool known = !(diff + EPSILON < 0);
+    if(known)
+        INSTRUMENT_COUNT(entry.get_context().instrumentation, phase_closed_list, 1);
+    return known;
 }
 
 const TimeStampedState& ClosedList::get(const TimeStampedState &state) const
 {
+    INSTRUMENT_PHASE(state.get_context().instrumentation, phase_closed_list);
     std::pair<ClosedListMap::const_iterator, ClosedListMap::const_iterator>
-        entries = closed.equal_range(state);
-    const TimeStampedState *ret = &(closed.find(state)->first);
+        entries = closed.equal_range(&state);
+    const TimeStampedState *ret = closed.find(&state)->first;
     ClosedListMap::const_iterator it = entries.first;
     for (; it != entries.second; ++it) {
-        if (it->first.timestamp + EPSILON < ret->timestamp) {
-            ret = &(it->first);
+        if (it->first->timestamp + EPSILON < ret->timestamp) {
+            ret = it->first;
         }
     }
     return *ret;
@@ -215,12 +244,13 @@ const TimeStampedState& ClosedList::get(const TimeStampedState &state) const
 
 double ClosedList::get_min_ts_of_key(const TimeStampedState &state) const
 {
+    INSTRUMENT_PHASE(state.get_context().instrumentation, phase_closed_list);
     double ret = REALLYBIG;
     std::pair<ClosedListMap::const_iterator, ClosedListMap::const_iterator>
-        entries = closed.equal_range(state);
+        entries = closed.equal_range(&state);
     ClosedListMap::const_iterator it = entries.first;
     for(; it != entries.second; ++it) {
-        ret = min(ret, it->first.timestamp);
+        ret = min(ret, it->first->timestamp);
     }
     return ret;
 }
@@ -230,6 +260,11 @@ int ClosedList::size() const
     return closed.size();
 }
 
+void ClosedList::dump_statistics() const
+{
+    states.dump_statistics("Closed list states");
+}
+
 double ClosedList::getCostOfPath(const TimeStampedState &entry) const
 {
     double ret = 0.0;
@@ -237,21 +272,20 @@ double ClosedList::getCostOfPath(const TimeStampedState &entry) const
     for (;;) {
         double min_timestamp = current_entry.timestamp;
         std::pair<ClosedListMap::const_iterator, ClosedListMap::const_iterator>
-            entries = closed.equal_range(current_entry);
+            entries = closed.equal_range(&current_entry);
         ClosedListMap::const_iterator it = entries.first;
         const PredecessorInfo* info_helper = NULL;
         for (; it != entries.second; ++it) {
-            if (it->first.timestamp + EPSILON < min_timestamp || !info_helper) {
+            if (it->first->timestamp + EPSILON < min_timestamp || !info_helper) {
                 info_helper = &(it->second);
-                min_timestamp = it->first.timestamp;
+                min_timestamp = it->first->timestamp;
             }
         }
         if (!info_helper || info_helper->predecessor == 0)
             break;
         const PredecessorInfo &info = *info_helper;
         const TimeStampedState* pred = info.predecessor;
-        if (info.annotation != g_let_time_pass
-                && info.annotation->get_name().compare("wait")) {
+        if (info.annotation->get_kind() == regular_op) {
             const Operator* op = info.annotation;
 
             double duration = op->get_duration(pred);
@@ -263,23 +297,23 @@ double ClosedList::getCostOfPath(const TimeStampedState &entry) const
 }
 
 double ClosedList::trace_path(const TimeStampedState &entry,
-        vector<PlanStep> &path, PlanTrace &states) const
+        vector<PlanStep> &path, PlanTrace &states, ObjectPool<TimeStampedState> &pool) const
 {
     double ret = 0.0;
     assert(path.empty());
     TimeStampedState current_entry = entry;
-    states.push_back(new TimeStampedState(entry));
+    states.push_back(pool.create(entry));
     for(;;) {
         double min_timestamp = current_entry.timestamp;
         double timestamp = min_timestamp;
         std::pair<ClosedListMap::const_iterator, ClosedListMap::const_iterator>
-            entries = closed.equal_range(current_entry);
+            entries = closed.equal_range(&current_entry);
         ClosedListMap::const_iterator it = entries.first;
         const PredecessorInfo* info_helper = NULL;
         for(; it != entries.second; ++it) {
-            if(it->first.timestamp + EPSILON < min_timestamp || !info_helper) {
+            if(it->first->timestamp + EPSILON < min_timestamp || !info_helper) {
                 info_helper = &(it->second);
-                min_timestamp = it->first.timestamp;
+                min_timestamp = it->first->timestamp;
             }
         }
         double diff = timestamp - min_timestamp;
@@ -291,18 +325,17 @@ double ClosedList::trace_path(const TimeStampedState &entry,
                 path[i].start_time -= diff;
             }
             for(int i = 0; i < states.size(); i++) {
-                states[i]->timestamp -= diff;
+                states[i]->shift_time(-diff);
             }
         }
         const TimeStampedState* pred = info.predecessor;
-        if(info.annotation != g_let_time_pass
-                && info.annotation->get_name().compare("wait")) {
+        if(info.annotation->get_kind() == regular_op) {
             const Operator* op = info.annotation;
             double duration = op->get_duration(pred);
             path.push_back(PlanStep(pred->get_timestamp(), duration, op, pred));
             ret += duration;
         }
-        states.push_back(new TimeStampedState(*pred));
+        states.push_back(pool.create(*pred));
         current_entry = *pred;
     }
     reverse(path.begin(), path.end());
@@ -319,16 +352,17 @@ double getSumOfSubgoals(const vector<PlanStep> &plan)
     return ret;
 }
 
-double getSumOfSubgoals(const PlanTrace &path)
+double getSumOfSubgoals(const Task &task, const PlanTrace &path)
 {
+    const vector<pair<int, double> > &goal = task.goal;
     double ret = 0.0;
-    for (int i = 0; i < g_goal.size(); ++i) {
-        assert(g_variable_types[g_goal[i].first] == logical || g_variable_types[g_goal[i].first] == comparison);
+    for (int i = 0; i < goal.size(); ++i) {
+        assert(task.variable_types[goal[i].first] == logical || task.variable_types[goal[i].first] == comparison);
         //        cout << "Goal " << i << ": " << g_variable_name[g_goal[i].first] << " has to be " << g_goal[i].second << endl;
         double actualIncrement = 0.0;
         for (int j = path.size() - 1; j >= 0; --j) {
             //            cout << "At timstamp " << path[j]->timestamp << " it is " << path[j]->state[g_goal[i].first] << endl;
-            if (double_equals(path[j]->state[g_goal[i].first], g_goal[i].second)) {
+            if (double_equals(path[j]->state[goal[i].first], goal[i].second)) {
                 actualIncrement = path[j]->timestamp;
             } else {
                 //                cout << "Goal " << i << " is satiesfied at timestamp " << actualIncrement << endl;
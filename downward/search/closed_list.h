@@ -6,22 +6,34 @@
 #include <algorithm>
 #include <vector>
 
+#include "object_pool.h"
 #include "operator.h"
 
 struct TssHash
 {
     std::size_t operator()(const TimeStampedState & tss) const;
+    std::size_t operator()(const TimeStampedState *tss) const
+    {
+        return (*this)(*tss);
+    }
 };
 
 bool prevailEquals(const Prevail &prev1, const Prevail &prev2);
 
-bool scheduledConditionEquals(const ScheduledCondition &cond1, const ScheduledCondition &cond2);
+/// Event equality, the times are compared relative to the time stamps of the states.
+bool scheduledConditionEquals(const ScheduledCondition &cond1, double timestamp1,
+        const ScheduledCondition &cond2, double timestamp2);
 
-bool scheduledEffectEquals(const ScheduledEffect &eff1, const ScheduledEffect &eff2);
+bool scheduledEffectEquals(const ScheduledEffect &eff1, double timestamp1,
+        const ScheduledEffect &eff2, double timestamp2);
 
 struct TssEquals
 {
     bool operator()(const TimeStampedState &tss1, const TimeStampedState &tss2) const;
+    bool operator()(const TimeStampedState *tss1, const TimeStampedState *tss2) const
+    {
+        return (*this)(*tss1, *tss2);
+    }
 };
 
 class ClosedList
@@ -37,9 +49,12 @@ class ClosedList
         }
     };
 
-    typedef tr1::unordered_multimap<TimeStampedState, PredecessorInfo, TssHash, TssEquals> ClosedListMap;
+    // The states are kept in a pool, the map only refers to them.
+    typedef tr1::unordered_multimap<const TimeStampedState *, PredecessorInfo,
+            TssHash, TssEquals> ClosedListMap;
     typedef ClosedListMap::value_type ValuePair;
     ClosedListMap closed;
+    ObjectPool<TimeStampedState> states;
 
     public:
         ClosedList();
@@ -56,11 +71,14 @@ class ClosedList
         double get_min_ts_of_key(const TimeStampedState &state) const;
 
         int size() const;
-        double trace_path(const TimeStampedState &entry, std::vector<PlanStep> &path, PlanTrace &staes) const;
+        void dump_statistics() const;
+        /// Trace the plan to entry back, the states of the trace are created in pool.
+        double trace_path(const TimeStampedState &entry, std::vector<PlanStep> &path,
+                PlanTrace &states, ObjectPool<TimeStampedState> &pool) const;
         double getCostOfPath(const TimeStampedState &entry) const;
 };
 
 double getSumOfSubgoals(const vector<PlanStep> &plan);
-double getSumOfSubgoals(const PlanTrace &path);
+double getSumOfSubgoals(const Task &task, const PlanTrace &path);
 
 #endif
@@ -12,7 +12,7 @@ using namespace std;
 
 LocalProblem::LocalProblem(CyclicCGHeuristic* _owner, int the_var_no,
         int the_start_value) :
-    owner(_owner), base_priority(-1.0), var_no(the_var_no),
+    owner(_owner), task(_owner->get_context().task), base_priority(-1.0), var_no(the_var_no),
     causal_graph_parents(NULL), start_value(the_start_value)
 {
 }
@@ -26,7 +26,7 @@ double LocalTransition::get_direct_cost()
             assert(false);
             ScheduledOperator *s_op = dynamic_cast<ScheduledOperator*>(label->op);
             assert(s_op);
-            g_HACK()->set_waiting_time(max(g_HACK()->get_waiting_time(), s_op->time_increment));
+            g_HACK()->set_waiting_time(max(g_HACK()->get_waiting_time(), s_op->time));
         } else {
             LocalProblemNode *source = get_source();
             ret = source->children_state[duration_var_local];
@@ -63,8 +63,8 @@ void LocalTransitionDiscrete::on_source_expanded(const TimeStampedState &state)
         for(int i = 0; i < prevail.size(); i++) {
             int local_var = prevail[i].local_var;
             int prev_var_no = prevail[i].prev_dtg->var;
-            assert(g_variable_types[prev_var_no]==logical ||
-                    g_variable_types[prev_var_no]==comparison);
+            assert(g_HACK()->get_context().task.variable_types[prev_var_no]==logical ||
+                    g_HACK()->get_context().task.variable_types[prev_var_no]==comparison);
             double current_val = source->children_state[local_var];
             if(!double_equals(current_val, prevail[i].value)) {
                 int current_val_int = static_cast<int>(current_val);
@@ -78,7 +78,7 @@ void LocalTransitionDiscrete::on_source_expanded(const TimeStampedState &state)
                 LocalProblemNode *cond_node =
                     child_problem->get_node(prev_value);
                 if(!double_equals(cond_node->reached_by_wait_for, -1.0)) {
-                    assert(!g_parameters.cg_heuristic_zero_cost_waiting_transitions
+                    assert(!g_HACK()->get_context().parameters.cg_heuristic_zero_cost_waiting_transitions
                             || cond_node->cost == 0.0);  // If zero cost is on, this should be 0.0
                     assert(cond_node->cost < LocalProblem::QUITE_A_LOT);
                     g_HACK()->set_waiting_time(max(g_HACK()->get_waiting_time(),
@@ -154,11 +154,11 @@ void LocalProblemNodeDiscrete::on_expand(const TimeStampedState &state)
         const vector<LocalAssignment> &cyclic_effects =
             reached_by->label->effect;
         for(int i = 0; i < cyclic_effects.size(); i++) {
-            if(g_variable_types[cyclic_effects[i].prev_dtg->var] == logical) {
+            if(owner->task.variable_types[cyclic_effects[i].prev_dtg->var] == logical) {
                 children_state[cyclic_effects[i].local_var]
                     = cyclic_effects[i].value;
             } else {
-                assert(g_variable_types[cyclic_effects[i].prev_dtg->var] == primitive_functional);
+                assert(owner->task.variable_types[cyclic_effects[i].prev_dtg->var] == primitive_functional);
                 const LocalAssignment &la = cyclic_effects[i];
                 updatePrimitiveNumericVariable(la.fop, la.local_var, la.var,
                         children_state);
@@ -210,7 +210,7 @@ void LocalProblemNode::mark_helpful_transitions(const TimeStampedState &state, i
             ScheduledOperator *s_op =
                 dynamic_cast<ScheduledOperator*> (reached_by->label->op);
             assert(s_op);
-            duration = s_op->time_increment;
+            duration = s_op->time;
         } else if(!(duration_variable == -1)) {
             duration = reached_by->get_source()->children_state[reached_by->duration_var_local];
         }
@@ -263,8 +263,8 @@ void CyclicCGHeuristic::setCheapestPrefOpsExternally(int number) {
         if(idx == -1) {
             return;
         }
-        set<const Operator*> prefOps = prefOpsSortedByCorrespondigGoal[idx];
-        for(set<const Operator*>::iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
+        const set<const Operator*> &prefOps = prefOpsSortedByCorrespondigGoal[idx];
+        for(set<const Operator*>::const_iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
         	set_preferred(*it, CHEAPEST);
         }
         costsOfGoals[idx] = -1.0;
@@ -286,8 +286,8 @@ void CyclicCGHeuristic::setMostExpensivePrefOpsExternally(int number) {
         if(idx == -1) {
             return;
         }
-        set<const Operator*> prefOps = prefOpsSortedByCorrespondigGoal[idx];
-        for(set<const Operator*>::iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
+        const set<const Operator*> &prefOps = prefOpsSortedByCorrespondigGoal[idx];
+        for(set<const Operator*>::const_iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
             set_preferred(*it, MOSTEXPENSIVE);
         }
         costsOfGoals[idx] = -1.0;
@@ -308,8 +308,9 @@ void CyclicCGHeuristic::setRandPrefOpsExternally(int number) {
             return;
         }
         int idx = rand() % notYetSatiesfiedGoals.size();
-        set<const Operator*> prefOps = prefOpsSortedByCorrespondigGoal[notYetSatiesfiedGoals[idx]];
-        for(set<const Operator*>::iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
+        const set<const Operator*> &prefOps =
+            prefOpsSortedByCorrespondigGoal[notYetSatiesfiedGoals[idx]];
+        for(set<const Operator*>::const_iterator it = prefOps.begin(); it != prefOps.end(); ++it) {
             set_preferred(*it, RAND);
         }
         notYetSatiesfiedGoals[idx] = notYetSatiesfiedGoals[notYetSatiesfiedGoals.size()-1];
@@ -467,18 +468,18 @@ void LocalProblemDiscrete::compile_DTG_arcs_to_LTD_objects(
 
 void LocalProblemDiscrete::build_nodes_for_variable(int var_no)
 {
-    if(!(g_variable_types[var_no] == logical)) {
-        cout << "variable type: " << g_variable_types[var_no] << endl;
+    if(!(task.variable_types[var_no] == logical)) {
+        cout << "variable type: " << task.variable_types[var_no] << endl;
         assert(false);
     }
-    DomainTransitionGraph *dtg = g_transition_graphs[var_no];
+    DomainTransitionGraph *dtg = task.transition_graphs[var_no];
     DomainTransitionGraphSymb *dtgs =
         dynamic_cast<DomainTransitionGraphSymb *> (dtg);
     assert(dtgs);
     causal_graph_parents = &dtg->ccg_parents;
     global_to_local_parents = &dtg->global_to_local_ccg_parents;
     int num_parents = causal_graph_parents->size();
-    for(int value = 0; value < g_variable_domain[var_no]; value++)
+    for(int value = 0; value < task.variable_domain[var_no]; value++)
         nodes.push_back(LocalProblemNodeDiscrete(this, num_parents, value));
     compile_DTG_arcs_to_LTD_objects(dtgs);
 }
@@ -488,17 +489,17 @@ void LocalProblemDiscrete::build_nodes_for_goal()
     // TODO: We have a small memory leak here. Could be fixed by
     // making two LocalProblem classes with a virtual destructor.
     causal_graph_parents = new vector<int> ;
-    for(int i = 0; i < g_goal.size(); i++)
-        causal_graph_parents->push_back(g_goal[i].first);
+    for(int i = 0; i < task.goal.size(); i++)
+        causal_graph_parents->push_back(task.goal[i].first);
 
     for(int value = 0; value < 2; value++)
-        nodes.push_back(LocalProblemNodeDiscrete(this, g_goal.size(), value));
+        nodes.push_back(LocalProblemNodeDiscrete(this, task.goal.size(), value));
 
     vector<LocalAssignment> goals;
-    for(int i = 0; i < g_goal.size(); i++) {
-        int goal_var = g_goal[i].first;
-        double goal_value = g_goal[i].second;
-        DomainTransitionGraph *goal_dtg = g_transition_graphs[goal_var];
+    for(int i = 0; i < task.goal.size(); i++) {
+        int goal_var = task.goal[i].first;
+        double goal_value = task.goal[i].second;
+        DomainTransitionGraph *goal_dtg = task.transition_graphs[goal_var];
         goals.push_back(LocalAssignment(goal_dtg, i, goal_value, end_cond));
     }
     ValueTransitionLabel *label = new ValueTransitionLabel(-1, goals, end);
@@ -550,22 +551,22 @@ void LocalProblemDiscrete::initialize(double base_priority_, int start_value,
         start->children_state[i] = state[var];
     }
     owner->add_to_queue(start);
-    if(g_parameters.cg_heuristic_fire_waiting_transitions_only_if_local_problems_matches_state) {
+    if(owner->get_context().parameters.cg_heuristic_fire_waiting_transitions_only_if_local_problems_matches_state) {
         if(!(double_equals(state[var_no], start_value))) {
             return;
         }
     }
     for(int i = 0; i < state.scheduled_effects.size(); i++) {
         const ScheduledEffect &seffect = state.scheduled_effects[i];
-        if(seffect.var == var_no) {
-            LocalProblemNodeDiscrete& node = nodes[static_cast<int>(seffect.post)];
-            if(g_parameters.cg_heuristic_zero_cost_waiting_transitions)
+        if(seffect.effect->var == var_no) {
+            LocalProblemNodeDiscrete& node = nodes[static_cast<int>(seffect.effect->post)];
+            if(owner->get_context().parameters.cg_heuristic_zero_cost_waiting_transitions)
                 node.cost = 0.0;
             else
-                node.cost = seffect.time_increment;
-            assert(seffect.time_increment > 0.0);
-            assert(seffect.time_increment < LocalProblem::QUITE_A_LOT);
-            node.reached_by_wait_for = seffect.time_increment;
+                node.cost = state.time_increment(seffect);
+            assert(state.time_increment(seffect) > 0.0);
+            assert(state.time_increment(seffect) < LocalProblem::QUITE_A_LOT);
+            node.reached_by_wait_for = state.time_increment(seffect);
             for(int i = 0; i < parents_num; ++i) {
                 int varToSet = (*causal_graph_parents)[i];
                 double valueToSet = state[varToSet];
@@ -573,9 +574,9 @@ void LocalProblemDiscrete::initialize(double base_priority_, int start_value,
                     if(j == i)
                         continue;
                     const ScheduledEffect &otherSeffect = state.scheduled_effects[j];
-                    if(otherSeffect.var == varToSet && 
-                       otherSeffect.time_increment == seffect.time_increment) {
-                        valueToSet = otherSeffect.post;
+                    if(otherSeffect.effect->var == varToSet && 
+                       state.time_increment(otherSeffect) == state.time_increment(seffect)) {
+                        valueToSet = otherSeffect.effect->post;
                         break;
                     }
                 }
@@ -790,9 +791,10 @@ void LocalProblemNodeComp::on_expand(const TimeStampedState &state)
     }
     opened = true;
 
-    vector<LocalTransitionComp*> ready_transitions;
+    vector<LocalTransitionComp*> &ready_transitions = g_HACK()->ready_transitions;
+    ready_transitions.clear();
     nodes_where_this_subscribe.resize(outgoing_transitions.size());
-    vector<double> temp_children_state(children_state.size());
+    vector<double> &temp_children_state = g_HACK()->temp_children_state;
     for(int i = 0; i < outgoing_transitions.size(); i++) {
         LocalTransitionComp *trans = &outgoing_transitions[i];
         temp_children_state = children_state;
@@ -866,8 +868,8 @@ bool CyclicCGHeuristic::is_running(LocalTransition* trans, const TimeStampedStat
     if(!trans->label || !trans->label->op)
         return false;
     for(int i = 0; i < state.operators.size(); ++i) {
-        if(!(state.operators[i].get_name().compare(trans->label->op->get_name()))) {
-            set_waiting_time(max(get_waiting_time(), state.operators[i].time_increment - EPS_TIME));
+        if(state.operators[i].get_id() == trans->label->op->get_id()) {
+            set_waiting_time(max(get_waiting_time(), state.time_increment(state.operators[i]) - EPS_TIME));
             return true;
         }
     }
@@ -882,7 +884,7 @@ bool LocalProblemNodeComp::is_satiesfied(int trans_index,
         const LocalAssignment &pre_cond = trans->label->precond[i];
         // check whether the cost of this prevail has already been computed
         int global_var = (*(owner->causal_graph_parents))[pre_cond.local_var];
-        assert(!is_functional(global_var));
+        assert(!owner->task.is_functional(global_var));
         double current_val = children_state[pre_cond.local_var];
         if(double_equals(current_val, pre_cond.value)) {
             // to change nothing costs nothing
@@ -945,10 +947,10 @@ void LocalProblemNodeComp::updateNumericVariables(LocalTransitionComp &trans,
         dynamic_cast<const FuncTransitionLabel*> (trans.label);
     assert(label_func);
     int primitive_var_local = label_func->starting_variable;
-    assert(g_variable_types[(*owner->causal_graph_parents)[primitive_var_local]]
+    assert(owner->task.variable_types[(*owner->causal_graph_parents)[primitive_var_local]]
             == primitive_functional);
     int influencing_var_local = label_func->influencing_variable;
-    assert(is_functional((*owner->causal_graph_parents)[influencing_var_local]));
+    assert(owner->task.is_functional((*owner->causal_graph_parents)[influencing_var_local]));
     assignment_op a_op = label_func->a_op;
     updatePrimitiveNumericVariable(a_op, primitive_var_local,
             influencing_var_local, temp_children_state);
@@ -1004,12 +1006,12 @@ void LocalProblemNode::updateNumericVariablesRec(int local_var,
             static_cast<binary_op> (owner->children_in_cg[var_to_update][2]);
         int left_var = owner->children_in_cg[var_to_update][0];
         int right_var = owner->children_in_cg[var_to_update][1];
-        if(g_variable_types[(*(owner->causal_graph_parents))[var_to_update]]
+        if(owner->task.variable_types[(*(owner->causal_graph_parents))[var_to_update]]
                 == subterm_functional) {
             updateSubtermNumericVariables(var_to_update, bop, left_var,
                     right_var, temp_children_state);
         } else {
-            assert(g_variable_types[(*(owner->causal_graph_parents))[var_to_update]] == comparison);
+            assert(owner->task.variable_types[(*(owner->causal_graph_parents))[var_to_update]] == comparison);
             updateComparisonVariables(var_to_update, bop, left_var, right_var,
                     temp_children_state);
         }
@@ -1150,19 +1152,19 @@ void LocalProblem::buildDependingVars(int parents_num)
     for(int i = 0; i < parents_num; i++) {
         int context_variable = (*causal_graph_parents)[i];
         const vector<int>& current_depending_vars =
-            g_causal_graph->get_successors(context_variable);
+            task.causal_graph->get_successors(context_variable);
         for(int j = 0; j < current_depending_vars.size(); j++) {
             int current_depending_var = current_depending_vars[j];
-            if(g_variable_types[current_depending_var] == comparison
-                    || g_variable_types[current_depending_var]
+            if(task.variable_types[current_depending_var] == comparison
+                    || task.variable_types[current_depending_var]
                     == subterm_functional) {
                 int idx = getLocalIndexOfGlobalVariable(current_depending_var);
                 if(idx != -1)
                     depending_vars[i].push_back(idx);
             }
         }
-        if(g_variable_types[context_variable] == subterm_functional) {
-            DomainTransitionGraph *dtg = g_transition_graphs[context_variable];
+        if(task.variable_types[context_variable] == subterm_functional) {
+            DomainTransitionGraph *dtg = task.transition_graphs[context_variable];
             DomainTransitionGraphSubterm *dtgs =
                 dynamic_cast<DomainTransitionGraphSubterm*> (dtg);
             assert(dtgs);
@@ -1174,8 +1176,8 @@ void LocalProblem::buildDependingVars(int parents_num)
                 children_in_cg[i].push_back(right_var);
                 children_in_cg[i].push_back(dtgs->op);
             }
-        } else if(g_variable_types[context_variable] == comparison) {
-            DomainTransitionGraph *dtg = g_transition_graphs[context_variable];
+        } else if(task.variable_types[context_variable] == comparison) {
+            DomainTransitionGraph *dtg = task.transition_graphs[context_variable];
             DomainTransitionGraphComp *dtgc =
                 dynamic_cast<DomainTransitionGraphComp*> (dtg);
             assert(dtgc);
@@ -1209,11 +1211,11 @@ LocalProblemComp::LocalProblemComp(CyclicCGHeuristic* _owner, int the_var_no, in
 
 void LocalProblemComp::build_nodes_for_variable(int var_no, int the_start_value)
 {
-    if(!(g_variable_types[var_no] == comparison)) {
-        cout << "variable type: " << g_variable_types[var_no] << endl;
+    if(!(task.variable_types[var_no] == comparison)) {
+        cout << "variable type: " << task.variable_types[var_no] << endl;
         assert(false);
     }
-    DomainTransitionGraph *dtg = g_transition_graphs[var_no];
+    DomainTransitionGraph *dtg = task.transition_graphs[var_no];
     DomainTransitionGraphComp *dtgc =
         dynamic_cast<DomainTransitionGraphComp *> (dtg);
     assert(dtgc);
@@ -1223,7 +1225,7 @@ void LocalProblemComp::build_nodes_for_variable(int var_no, int the_start_value)
 
     int num_parents = causal_graph_parents->size();
 
-    assert(g_variable_domain[var_no] == 3);
+    assert(task.variable_domain[var_no] == 3);
     // There are 3 values for a comp variable: false, true and undefined. In the heuristic we only have
     // to deal with the first both of them.
     nodes.push_back(LocalProblemNodeComp(this, num_parents, 0, dtgc->nodes.second.op));
@@ -1281,7 +1283,8 @@ void LocalProblemComp::initialize(double base_priority_, int start_value,
     owner->add_to_queue(&nodes[start_value]);
 }
 
-CyclicCGHeuristic::CyclicCGHeuristic(Mode _mode) : mode(_mode)
+CyclicCGHeuristic::CyclicCGHeuristic(const SearchContext &context, Mode _mode) :
+    Heuristic(context), mode(_mode)
 {
     goal_problem = 0;
     goal_node = 0;
@@ -1299,26 +1302,45 @@ void CyclicCGHeuristic::initialize()
     assert(goal_problem == 0);
     cout << "Initializing cyclic causal graph heuristic...";
 
-    int num_variables = g_variable_domain.size();
+    int num_variables = context.task.variable_domain.size();
 
     goal_problem = new LocalProblemDiscrete(this, -1, 0);
     goal_node = &goal_problem->nodes[1];
 
     local_problem_index.resize(num_variables);
     for(int var_no = 0; var_no < num_variables; var_no++) {
-        int num_values = g_variable_domain[var_no];
+        int num_values = context.task.variable_domain[var_no];
         if(num_values == -1) {
             //we don't need local problems for functional variables so far....
-            assert(g_variable_types[var_no] == subterm_functional || g_variable_types[var_no] == primitive_functional);
+            assert(context.task.variable_types[var_no] == subterm_functional || context.task.variable_types[var_no] == primitive_functional);
         } else {
             local_problem_index[var_no].resize(num_values, NULL);
         }
     }
-    prefOpsSortedByCorrespondigGoal.resize(g_goal.size());
-    costsOfGoals.resize(g_goal.size());
+    prefOpsSortedByCorrespondigGoal.resize(context.task.goal.size());
+    costsOfGoals.resize(context.task.goal.size());
     cout << "done." << endl;
 }
 
+void CyclicCGHeuristic::clear_cache()
+{
+    cacheHeuristicValue.clear();
+    cachePrefOps.clear();
+    cacheCostsToGoal.clear();
+}
+
+void CyclicCGHeuristic::reset_goal()
+{
+    clear_cache();
+    if(goal_problem == 0)
+        return;     // not initialized yet
+    delete goal_problem;
+    goal_problem = new LocalProblemDiscrete(this, -1, 0);
+    goal_node = &goal_problem->nodes[1];
+    prefOpsSortedByCorrespondigGoal.assign(context.task.goal.size(), set<const Operator*>());
+    costsOfGoals.assign(context.task.goal.size(), 0.0);
+}
+
 void CyclicCGHeuristic::reset_pref_ops_from_cache(double heuristic, const TimeStampedState &state) {
     if(heuristic != DEAD_END && heuristic != 0) {
         PrefOpsCache::const_iterator it = cachePrefOps.find(state);
@@ -1335,12 +1357,12 @@ void CyclicCGHeuristic::reset_pref_ops_from_cache(double heuristic, const TimeSt
 
 void CyclicCGHeuristic::compute_pref_ops(double heuristic, const TimeStampedState &state) {
     if(heuristic != DEAD_END && heuristic != 0) {
-        if(g_parameters.pref_ops_cheapest_mode || g_parameters.pref_ops_most_expensive_mode ||
-                g_parameters.pref_ops_ordered_mode || g_parameters.pref_ops_rand_mode) {
-            assert(g_parameters.number_pref_ops_cheapest_mode +
-                    g_parameters.number_pref_ops_most_expensive_mode +
-                    g_parameters.number_pref_ops_ordered_mode +
-                    g_parameters.number_pref_ops_rand_mode > 0);
+        if(context.parameters.pref_ops_cheapest_mode || context.parameters.pref_ops_most_expensive_mode ||
+                context.parameters.pref_ops_ordered_mode || context.parameters.pref_ops_rand_mode) {
+            assert(context.parameters.number_pref_ops_cheapest_mode +
+                    context.parameters.number_pref_ops_most_expensive_mode +
+                    context.parameters.number_pref_ops_ordered_mode +
+                    context.parameters.number_pref_ops_rand_mode > 0);
             goal_node->setCostsOfGoals(state);
         }
         cacheCostsToGoal[state] = costsOfGoals;
@@ -1353,22 +1375,22 @@ void CyclicCGHeuristic::compute_pref_ops(double heuristic, const TimeStampedStat
 }
 
 void CyclicCGHeuristic::set_specific_pref_ops(const TimeStampedState &state) {
-    vector<double> temp_costsOfGoals = costsOfGoals;
-    if(g_parameters.pref_ops_ordered_mode) {
-        setFirstPrefOpsExternally(g_parameters.number_pref_ops_ordered_mode);
+    savedCostsOfGoals = costsOfGoals;
+    if(context.parameters.pref_ops_ordered_mode) {
+        setFirstPrefOpsExternally(context.parameters.number_pref_ops_ordered_mode);
     }
-    if(g_parameters.pref_ops_cheapest_mode) {
-        setCheapestPrefOpsExternally(g_parameters.number_pref_ops_cheapest_mode);
+    if(context.parameters.pref_ops_cheapest_mode) {
+        setCheapestPrefOpsExternally(context.parameters.number_pref_ops_cheapest_mode);
     }
-    costsOfGoals = temp_costsOfGoals;
-    if(g_parameters.pref_ops_most_expensive_mode) {
-        setMostExpensivePrefOpsExternally(g_parameters.number_pref_ops_most_expensive_mode);
+    costsOfGoals = savedCostsOfGoals;
+    if(context.parameters.pref_ops_most_expensive_mode) {
+        setMostExpensivePrefOpsExternally(context.parameters.number_pref_ops_most_expensive_mode);
     }
-    costsOfGoals = temp_costsOfGoals;
-    if(g_parameters.pref_ops_rand_mode) {
-        setRandPrefOpsExternally(g_parameters.number_pref_ops_rand_mode);
+    costsOfGoals = savedCostsOfGoals;
+    if(context.parameters.pref_ops_rand_mode) {
+        setRandPrefOpsExternally(context.parameters.number_pref_ops_rand_mode);
     }
-    if(g_parameters.pref_ops_concurrent_mode) {
+    if(context.parameters.pref_ops_concurrent_mode) {
         setConcurrentPrefOpsExternally(state);
     }
     setAllPrefOpsExternally();
@@ -1376,13 +1398,13 @@ void CyclicCGHeuristic::set_specific_pref_ops(const TimeStampedState &state) {
 
 double CyclicCGHeuristic::compute_heuristic(const TimeStampedState &state)
 {
-    if(state.satisfies(g_goal) && state.operators.empty()) {
+    if(state.satisfies(context.task.goal) && state.operators.empty()) {
         return 0.0;
     }
 
     double heuristic = DEAD_END;
 
-    if(g_parameters.use_caching_in_heuristic) {
+    if(context.parameters.use_caching_in_heuristic) {
         HeuristicValueCache::const_iterator it = cacheHeuristicValue.find(state);
         if(it != cacheHeuristicValue.end()) {
             num_cache_hits++;
@@ -1415,8 +1437,8 @@ double CyclicCGHeuristic::compute_heuristic(const TimeStampedState &state)
     } else if(mode == SUFFIX_MAKESPAN) {
         double longestRunningAction = 0.0;
         for(int i = 0; i < state.operators.size(); ++i) {
-            if(state.operators[i].time_increment > longestRunningAction) {
-                longestRunningAction = state.operators[i].time_increment;
+            if(state.time_increment(state.operators[i]) > longestRunningAction) {
+                longestRunningAction = state.time_increment(state.operators[i]);
             }
         }
 
@@ -1433,8 +1455,8 @@ double CyclicCGHeuristic::compute_heuristic(const TimeStampedState &state)
         }
         double longestRunningAction = 0.0;
         for(int i = 0; i < state.operators.size(); ++i) {
-            if(state.operators[i].time_increment > longestRunningAction) {
-                longestRunningAction = state.operators[i].time_increment;
+            if(state.time_increment(state.operators[i]) > longestRunningAction) {
+                longestRunningAction = state.time_increment(state.operators[i]);
             }
         }
         assert(longestRunningAction <= scheduledPlanMakespan);
@@ -1459,7 +1481,7 @@ double CyclicCGHeuristic::computeScheduledPlanMakespan(const TimeStampedState &
     vector<TimedOp> needed_ops;
     for(int i = 0; i < state.operators.size(); ++i) {
         needed_ops.push_back(tr1::make_tuple(&state.operators[i],
-                    state.operators[i].time_increment, i));
+                    state.time_increment(state.operators[i]), i));
     }
     set<const Operator*> labels;
     goal_problem->generate_causal_constraints(goal_node, constraints, needed_ops,
@@ -1486,7 +1508,7 @@ double CyclicCGHeuristic::computeScheduledPlanMakespan(const TimeStampedState &
         variable_names.push_back(tr1::get<0>(needed_ops[i])->get_name()
                 + "e");
     }
-    SimpleTemporalProblem stn(variable_names);
+    SimpleTemporalProblem stn(context.instrumentation, variable_names);
 
     // assert that start time point of actions are non-negative
     for(int i = 0; i < needed_ops.size(); ++i) {
@@ -1530,7 +1552,7 @@ double CyclicCGHeuristic::computeScheduledPlanMakespan(const TimeStampedState &
 
 void CyclicCGHeuristic::initialize_queue()
 {
-    open_nodes = node_queue();
+    open_nodes.clear();
 }
 
 void CyclicCGHeuristic::add_to_queue(LocalProblemNode *node)
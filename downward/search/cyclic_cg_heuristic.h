@@ -7,6 +7,7 @@
 #include "heuristic.h"
 #include "state.h"
 #include "domain_transition_graph.h"
+#include <ext/pool_allocator.h>
 #include <ext/slist>
 #include <cmath>
 #include <stdlib.h>
@@ -33,10 +34,9 @@ class LocalTransitionDiscrete;
 class LocalTransition;
 class Node_compare;
 
-typedef priority_queue<LocalProblemNode*, std::vector<LocalProblemNode*>,
-        Node_compare> node_queue;
-
-typedef __gnu_cxx ::slist<std::pair<LocalTransition*, int> > waiting_list_t;
+// the nodes of the waiting lists are recycled between evaluations
+typedef __gnu_cxx ::slist<std::pair<LocalTransition*, int>,
+        __gnu_cxx ::__pool_alloc<std::pair<LocalTransition*, int> > > waiting_list_t;
 typedef waiting_list_t::const_iterator const_it_waiting_list;
 typedef waiting_list_t::iterator it_waiting_list;
 
@@ -127,6 +127,7 @@ class LocalProblem
 {
     public:
         CyclicCGHeuristic* owner;
+        const Task &task;
         enum
         {
             QUITE_A_LOT = 10000000
@@ -309,6 +310,17 @@ class Node_compare
         }
 };
 
+/// Priority queue of the nodes to expand, keeps its memory when cleared.
+class node_queue : public priority_queue<LocalProblemNode*, std::vector<LocalProblemNode*>,
+        Node_compare>
+{
+    public:
+        void clear()
+        {
+            c.clear();
+        }
+};
+
 class CyclicCGHeuristic: public Heuristic
 {
 
@@ -340,8 +352,13 @@ class CyclicCGHeuristic: public Heuristic
         set<int> mostExpensiveGoals;
         set<int> randGoals;
         vector<double> costsOfGoals;
+        vector<double> savedCostsOfGoals;   ///< costsOfGoals while selecting preferred operators
         vector<set<const Operator*> > prefOpsSortedByCorrespondigGoal;
 
+        // scratch data of LocalProblemNodeComp::on_expand(), kept between evaluations
+        vector<LocalTransitionComp*> ready_transitions;
+        vector<double> temp_children_state;
+
         vector<LocalProblemNodeDiscrete*> nodes_with_an_additional_transition;
         vector<ValueNode*> dtg_nodes_with_an_additional_transition;
         vector<Operator*> generated_waiting_ops;
@@ -356,6 +373,10 @@ class CyclicCGHeuristic: public Heuristic
         inline LocalProblem *get_local_problem(int var_no, int value);
 
         virtual void initialize();
+        /// Rebuild the goal problem after the goal of the task has changed.
+        /** The local problems of the variables do not depend on the goal and are kept. */
+        void reset_goal();
+        virtual void clear_cache();
         void reset_pref_ops_from_cache(double heuristic, const TimeStampedState &state);
         void compute_pref_ops(double heuristic, const TimeStampedState &state);
         void set_specific_pref_ops(const TimeStampedState &state);
@@ -369,7 +390,7 @@ class CyclicCGHeuristic: public Heuristic
         void setAllPrefOpsExternally();
         bool canBeInserted(set<const Operator*> oldSet, set<const Operator*> newSet);
 
-        CyclicCGHeuristic(Mode mode);
+        CyclicCGHeuristic(const SearchContext &context, Mode mode);
         ~CyclicCGHeuristic();
         virtual bool dead_ends_are_reliable() {
             return false;
@@ -396,10 +417,10 @@ inline LocalProblem *CyclicCGHeuristic::get_local_problem(int var_no, int value)
 {
     LocalProblem *result = local_problem_index[var_no][value];
     if(!result) {
-        if(g_variable_types[var_no] == comparison) {
+        if(context.task.variable_types[var_no] == comparison) {
             result = new LocalProblemComp(this, var_no, value);
         } else {
-            assert(g_variable_types[var_no] == logical);
+            assert(context.task.variable_types[var_no] == logical);
             result = new LocalProblemDiscrete(this, var_no, value);
         }
         local_problem_index[var_no][value] = result;
@@ -9,40 +9,46 @@ using namespace __gnu_cxx;
 
 #include "domain_transition_graph.h"
 #include "globals.h"
+#include "task_reader.h"
 
-void DomainTransitionGraph::read_all(istream &in)
+DomainTransitionGraph::DomainTransitionGraph(Task &t, int var_index) :
+    task(t), var(var_index), is_axiom(t.axiom_layers[var_index] != -1)
 {
-    int var_count = g_variable_domain.size();
+}
+
+void DomainTransitionGraph::read_all(Task &task, TaskReader &in)
+{
+    int var_count = task.variable_domain.size();
 
     // First step: Allocate graphs and nodes.
-    g_transition_graphs.reserve(var_count);
+    task.transition_graphs.reserve(var_count);
     for(int var = 0; var < var_count; var++) {
-        switch (g_variable_types[var]) {
+        switch (task.variable_types[var]) {
             case logical: 
                 {
-                    int range = g_variable_domain[var];
+                    int range = task.variable_domain[var];
                     assert(range> 0);
-                    DomainTransitionGraphSymb *dtg = new DomainTransitionGraphSymb(var, range);
-                    g_transition_graphs.push_back(dtg);
+                    DomainTransitionGraphSymb *dtg = new DomainTransitionGraphSymb(task, var, range);
+                    task.transition_graphs.push_back(dtg);
                     break;
                 }
             case primitive_functional: 
                 {
-                    DomainTransitionGraphFunc *dtg = new DomainTransitionGraphFunc(var);
-                    g_transition_graphs.push_back(dtg);
+                    DomainTransitionGraphFunc *dtg = new DomainTransitionGraphFunc(task, var);
+                    task.transition_graphs.push_back(dtg);
                     break;
                 }
             case subterm_functional: 
                 {
                     DomainTransitionGraphSubterm *dtg =
-                        new DomainTransitionGraphSubterm(var);
-                    g_transition_graphs.push_back(dtg);
+                        new DomainTransitionGraphSubterm(task, var);
+                    task.transition_graphs.push_back(dtg);
                     break;
                 }
             case comparison: 
                 {
-                    DomainTransitionGraphComp *dtg = new DomainTransitionGraphComp(var);
-                    g_transition_graphs.push_back(dtg);
+                    DomainTransitionGraphComp *dtg = new DomainTransitionGraphComp(task, var);
+                    task.transition_graphs.push_back(dtg);
                     break;
                 }
             default:
@@ -53,7 +59,7 @@ void DomainTransitionGraph::read_all(istream &in)
 
     // Second step: Read transitions from file.
     for(int var = 0; var < var_count; var++) {
-        g_transition_graphs[var]->read_data(in);
+        task.transition_graphs[var]->read_data(in);
     }
 
     // Third step: Each primitive and subterm variable connected by a direct path to a comparison variable
@@ -61,19 +67,20 @@ void DomainTransitionGraph::read_all(istream &in)
     // Furthermore, collect all FuncTransitions of each subterm and primitive variable of a comparison
     // variable directly in the corresponding dtg.
     for(int var = 0; var < var_count; var++) {
-        if(g_variable_types[var] == comparison) {
+        if(task.variable_types[var] == comparison) {
             map<int, int> global_to_ccg_parent;
-            DomainTransitionGraph::compute_causal_graph_parents_comp(var,
+            DomainTransitionGraph::compute_causal_graph_parents_comp(task, var,
                     global_to_ccg_parent);
-            DomainTransitionGraph::collect_func_transitions(var,
+            DomainTransitionGraph::collect_func_transitions(task, var,
                     global_to_ccg_parent);
         }
     }
 }
 
-void DomainTransitionGraph::compute_causal_graph_parents_comp(int var, map<int, int> &global_to_ccg_parent)
+void DomainTransitionGraph::compute_causal_graph_parents_comp(Task &task, int var,
+        map<int, int> &global_to_ccg_parent)
 {
-    DomainTransitionGraph *dtg = g_transition_graphs[var];
+    DomainTransitionGraph *dtg = task.transition_graphs[var];
     DomainTransitionGraphComp *cdtg =
         dynamic_cast<DomainTransitionGraphComp*>(dtg);
     assert(cdtg);
@@ -83,9 +90,10 @@ void DomainTransitionGraph::compute_causal_graph_parents_comp(int var, map<int,
             global_to_ccg_parent);
 }
 
-void DomainTransitionGraph::collect_func_transitions(int var, map<int, int> &global_to_ccg_parent)
+void DomainTransitionGraph::collect_func_transitions(Task &task, int var,
+        map<int, int> &global_to_ccg_parent)
 {
-    DomainTransitionGraph *dtg = g_transition_graphs[var];
+    DomainTransitionGraph *dtg = task.transition_graphs[var];
     DomainTransitionGraphComp *cdtg =
         dynamic_cast<DomainTransitionGraphComp*>(dtg);
     assert(cdtg);
@@ -95,16 +103,15 @@ void DomainTransitionGraph::collect_func_transitions(int var, map<int, int> &glo
             global_to_ccg_parent);
 }
 
-DomainTransitionGraphSymb::DomainTransitionGraphSymb(int var_index, int node_count)
+DomainTransitionGraphSymb::DomainTransitionGraphSymb(Task &task, int var_index, int node_count) :
+    DomainTransitionGraph(task, var_index)
 {
-    is_axiom = g_axiom_layers[var_index] != -1;
-    var = var_index;
     nodes.reserve(node_count);
     for(int value = 0; value < node_count; value++)
         nodes.push_back(ValueNode(this, value));
 }
 
-void DomainTransitionGraphSymb::read_data(istream &in)
+void DomainTransitionGraphSymb::read_data(TaskReader &in)
 {
     check_magic(in, "begin_DTG");
 
@@ -181,7 +188,7 @@ void DomainTransitionGraphSymb::read_data(istream &in)
                 translate_global_to_local(global_to_ccg_parent, global_var);
                 int ccg_parent = global_to_ccg_parent[global_var];
                 DomainTransitionGraph *prev_dtg =
-                    g_transition_graphs[global_var];
+                    task.transition_graphs[global_var];
                 all_prevails.push_back(LocalAssignment(prev_dtg, ccg_parent,
                     val, cond_type));
             }
@@ -195,8 +202,8 @@ void DomainTransitionGraphSymb::read_data(istream &in)
                 // the_operator = &g_axioms[operator_index];
             } else {
                 assert(operator_index >= 0 && operator_index
-                        < g_operators.size());
-                the_operator = &g_operators[operator_index];
+                        < task.operators.size());
+                the_operator = &task.operators[operator_index];
             }
 
             // Build up cyclic_effect. This is messy because this isn't
@@ -216,7 +223,7 @@ void DomainTransitionGraphSymb::read_data(istream &in)
                         bool already_contained_in_global = global_to_ccg_parent.count(var_no);
                         bool var_influences_important_comp_var = false;
                         if(!already_contained_in_global &&
-                            g_variable_types[var_no] == primitive_functional) {
+                            task.variable_types[var_no] == primitive_functional) {
                             var_influences_important_comp_var =
                                 add_relevant_functional_vars_to_context(var_no, global_to_ccg_parent);
                         }
@@ -269,20 +276,20 @@ void DomainTransitionGraphSymb::extend_cyclic_effect(const PrePost& pre_post, ve
         // the cyclic effects
         assert(global_to_ccg_parent.count(var_no));
         int ccg_parent = global_to_ccg_parent[var_no];
-        assert(g_variable_types[var_no] == primitive_functional || g_variable_types[var_no] == logical);
-        if(g_variable_types[var_no] == logical) {
+        assert(task.variable_types[var_no] == primitive_functional || task.variable_types[var_no] == logical);
+        if(task.variable_types[var_no] == logical) {
             if(!double_equals(pre, post)) {
                 // FIXME: condition_type is nonsense at this point (will not be needed later!)
                 cyclic_effect.push_back(LocalAssignment(
-                    g_transition_graphs[var_no], ccg_parent,
+                    task.transition_graphs[var_no], ccg_parent,
                     post, end_cond));
             }
         } else {
-            assert(g_variable_types[var_no] == primitive_functional);
+            assert(task.variable_types[var_no] == primitive_functional);
             translate_global_to_local(global_to_ccg_parent, var_post);
             // FIXME: condition_type is nonsense at this point (will not be needed later!)
             cyclic_effect.push_back(LocalAssignment(
-                        g_transition_graphs[var_no], ccg_parent,
+                        task.transition_graphs[var_no], ccg_parent,
                         global_to_ccg_parent[var_post], fop, end_cond));
         }
     }
@@ -294,13 +301,13 @@ bool DomainTransitionGraphSymb::add_relevant_functional_vars_to_context(int var_
     // insert all variables on direct paths in the causal graph from var_no
     // (primitive functional) to a relevant comparison
     vector<int> comp_vars;
-    g_causal_graph->get_comp_vars_for_func_var(var_no, comp_vars);
+    task.causal_graph->get_comp_vars_for_func_var(var_no, comp_vars);
     bool var_influences_important_comp_var = false;
     for(int s = 0; s < comp_vars.size(); ++s) {
         if(global_to_ccg_parent.count(comp_vars[s])) {
             var_influences_important_comp_var = true;
             set<int> intermediate_vars;
-            g_causal_graph->get_functional_vars_in_unrolled_term(comp_vars[s], intermediate_vars);
+            task.causal_graph->get_functional_vars_in_unrolled_term(comp_vars[s], intermediate_vars);
             set<int>::iterator it;
             for(it = intermediate_vars.begin(); it != intermediate_vars.end(); ++it) {
                 translate_global_to_local(global_to_ccg_parent, *it);
@@ -370,13 +377,12 @@ void DomainTransitionGraphSymb::get_successors(int value, vector<int> &result) c
         result.push_back(transitions[i].target->value);
 }
 
-DomainTransitionGraphSubterm::DomainTransitionGraphSubterm(int var_index)
+DomainTransitionGraphSubterm::DomainTransitionGraphSubterm(Task &task, int var_index) :
+    DomainTransitionGraph(task, var_index)
 {
-    is_axiom = g_axiom_layers[var_index] != -1;
-    var = var_index;
 }
 
-void DomainTransitionGraphSubterm::read_data(istream &in)
+void DomainTransitionGraphSubterm::read_data(TaskReader &in)
 {
     check_magic(in, "begin_DTG");
     in >> left_var >> op >> right_var;
@@ -389,13 +395,12 @@ void DomainTransitionGraphSubterm::dump() const
     cout << left_var << " " << op << " " << right_var << endl;
 }
 
-DomainTransitionGraphFunc::DomainTransitionGraphFunc(int var_index)
+DomainTransitionGraphFunc::DomainTransitionGraphFunc(Task &task, int var_index) :
+    DomainTransitionGraph(task, var_index)
 {
-    is_axiom = g_axiom_layers[var_index] != -1;
-    var = var_index;
 }
 
-void DomainTransitionGraphFunc::read_data(istream &in)
+void DomainTransitionGraphFunc::read_data(TaskReader &in)
 {
     check_magic(in, "begin_DTG");
     int number_of_transitions;
@@ -403,7 +408,7 @@ void DomainTransitionGraphFunc::read_data(istream &in)
     for(int i = 0; i < number_of_transitions; i++) {
         int op_index;
         in >> op_index;
-        Operator *op = &g_operators[op_index];
+        Operator *op = &task.operators[op_index];
 
         trans_type tt;
         in >> tt;
@@ -429,7 +434,7 @@ void DomainTransitionGraphFunc::read_data(istream &in)
         in >> count; //number of  Conditions
         for(int i = 0; i < count; i++) {
             LocalAssignment prev_cond = LocalAssignment(in);
-            prev_cond.prev_dtg = g_transition_graphs[prev_cond.local_var];
+            prev_cond.prev_dtg = task.transition_graphs[prev_cond.local_var];
             prevails.push_back(prev_cond);
         }
         transitions.push_back(FuncTransitionLabel(var, prevails, effects, a_op,
@@ -439,7 +444,7 @@ void DomainTransitionGraphFunc::read_data(istream &in)
     check_magic(in, "end_DTG");
 }
 
-LocalAssignment::LocalAssignment(istream &in)
+LocalAssignment::LocalAssignment(TaskReader &in)
 {
     in >> local_var >> value >> cond_type;
 }
@@ -467,13 +472,12 @@ void DomainTransitionGraphFunc::dump() const
     }
 }
 
-DomainTransitionGraphComp::DomainTransitionGraphComp(int var_index)
+DomainTransitionGraphComp::DomainTransitionGraphComp(Task &task, int var_index) :
+    DomainTransitionGraph(task, var_index)
 {
-    is_axiom = g_axiom_layers[var_index] != -1;
-    var = var_index;
 }
 
-void DomainTransitionGraphComp::read_data(istream &in)
+void DomainTransitionGraphComp::read_data(TaskReader &in)
 {
     check_magic(in, "begin_DTG");
     check_magic(in, "1");
@@ -487,14 +491,14 @@ void DomainTransitionGraphComp::read_data(istream &in)
 void DomainTransitionGraphComp::compute_recursively_parents(int var,
         map<int, int> &global_to_ccg_parent)
 {
-    if(g_variable_types[var] == primitive_functional) {
+    if(task.variable_types[var] == primitive_functional) {
         // Processing for full DTG (cyclic CG).
         translate_global_to_local(global_to_ccg_parent, var);
         return;
     }
-    if(g_variable_types[var] == subterm_functional) {
+    if(task.variable_types[var] == subterm_functional) {
         translate_global_to_local(global_to_ccg_parent, var);
-        DomainTransitionGraph* dtg = g_transition_graphs[var];
+        DomainTransitionGraph* dtg = task.transition_graphs[var];
         DomainTransitionGraphSubterm* sdtg =
             dynamic_cast<DomainTransitionGraphSubterm*>(dtg);
         assert(sdtg);
@@ -522,8 +526,8 @@ int DomainTransitionGraph::translate_global_to_local(map<int, int> &global_to_cc
 void DomainTransitionGraphComp::collect_recursively_func_transitions(int var,
         map<int, int> &global_to_ccg_parent)
 {
-    DomainTransitionGraph* dtg = g_transition_graphs[var];
-    if(g_variable_types[var] == primitive_functional) {
+    DomainTransitionGraph* dtg = task.transition_graphs[var];
+    if(task.variable_types[var] == primitive_functional) {
         DomainTransitionGraphFunc* fdtg =
             dynamic_cast<DomainTransitionGraphFunc*>(dtg);
         assert(fdtg);
@@ -557,7 +561,7 @@ void DomainTransitionGraphComp::collect_recursively_func_transitions(int var,
         }
         return;
     }
-    if(g_variable_types[var] == subterm_functional) {
+    if(task.variable_types[var] == subterm_functional) {
         DomainTransitionGraphSubterm* sdtg =
             dynamic_cast<DomainTransitionGraphSubterm*>(dtg);
         assert(sdtg);
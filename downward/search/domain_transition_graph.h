@@ -44,7 +44,7 @@ struct LocalAssignment
     {
         value = -1.0;
     }
-    LocalAssignment(istream &in);
+    LocalAssignment(TaskReader &in);
     void dump() const;
 };
 
@@ -116,6 +116,7 @@ class FuncTransitionLabel : public ValueTransitionLabel
 class DomainTransitionGraph
 {
     public:
+        Task &task;
         int var;
         bool is_axiom;
 
@@ -124,11 +125,15 @@ class DomainTransitionGraph
         // (only needed for initializing child_state for the start node?)
         hashmap global_to_local_ccg_parents;
 
+        DomainTransitionGraph(Task &task, int var_index);
         virtual ~DomainTransitionGraph() {}
-        static void read_all(istream &in);
-        virtual void read_data(istream &in) = 0;
-        static void compute_causal_graph_parents_comp(int var, map<int, int> &global_to_ccg_parent);
-        static void collect_func_transitions(int var, map<int, int> &global_to_ccg_parent);
+        /// Read the transition graphs of all variables of task.
+        static void read_all(Task &task, TaskReader &in);
+        virtual void read_data(TaskReader &in) = 0;
+        static void compute_causal_graph_parents_comp(Task &task, int var,
+                map<int, int> &global_to_ccg_parent);
+        static void collect_func_transitions(Task &task, int var,
+                map<int, int> &global_to_ccg_parent);
         virtual void dump() const = 0;
     protected:
         int translate_global_to_local(map<int, int> &global_to_ccg_parent, int global_var);
@@ -139,8 +144,8 @@ class DomainTransitionGraphSymb : public DomainTransitionGraph
     public:
         vector<ValueNode> nodes;
 
-        DomainTransitionGraphSymb(int var_index, int node_count);
-        virtual void read_data(istream &in);
+        DomainTransitionGraphSymb(Task &task, int var_index, int node_count);
+        virtual void read_data(TaskReader &in);
         virtual void dump() const;
         virtual void get_successors(int value, vector<int> &result) const;
         // Build vector of values v' such that there is a transition from value to v'.
@@ -160,8 +165,8 @@ class DomainTransitionGraphSubterm : public DomainTransitionGraph
         int right_var;
         binary_op op;
 
-        DomainTransitionGraphSubterm(int var_index);
-        virtual void read_data(istream &in);
+        DomainTransitionGraphSubterm(Task &task, int var_index);
+        virtual void read_data(TaskReader &in);
         virtual void dump() const;
 
     private:
@@ -172,8 +177,8 @@ class DomainTransitionGraphFunc : public DomainTransitionGraph
 {
     public:
         vector<FuncTransitionLabel> transitions;
-        DomainTransitionGraphFunc(int var_index);
-        virtual void read_data(istream &in);
+        DomainTransitionGraphFunc(Task &task, int var_index);
+        virtual void read_data(TaskReader &in);
         virtual void dump() const;
 
     private:
@@ -189,8 +194,8 @@ class DomainTransitionGraphComp : public DomainTransitionGraph
         vector<FuncTransitionLabel> transitions;
 
         std::pair<CompTransition, CompTransition> nodes; //first has start value false; second has start value true
-        DomainTransitionGraphComp(int var_index);
-        virtual void read_data(istream &in);
+        DomainTransitionGraphComp(Task &task, int var_index);
+        virtual void read_data(TaskReader &in);
         void compute_recursively_parents(int var, map<int, int> &global_to_ccg_parent);
         void collect_recursively_func_transitions(int var, map<int, int> &global_to_ccg_parent);
         virtual void dump() const;
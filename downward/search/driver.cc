@@ -0,0 +1,98 @@
+#include "driver.h"
+#include "planner.h"
+#include "replanner.h"
+#include "task_reader.h"
+#include "../preprocess/preprocessor.h"
+#include "../preprocess/task_writer.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Reads the values the preprocessor kept in memory (MemoryTaskWriter).
+/**
+ * Numbers come as they were computed and words as they were written, so
+ * nothing is formatted or parsed on the way to the search.
+ */
+class PreprocessedTaskReader : public TaskReader
+{
+    vector<preprocess::TaskToken> tokens;
+    size_t pos;
+
+    const preprocess::TaskToken &next_token(const char *expected)
+    {
+        if(pos == tokens.size()) {
+            cout << "Expected " << expected << " in task, got the end of the task." << endl;
+            exit(1);
+        }
+        return tokens[pos++];
+    }
+    void syntax_error(const char *expected, const preprocess::TaskToken &token)
+    {
+        cout << "Expected " << expected << " in task, got '" << token.word << "'." << endl;
+        exit(1);
+    }
+    public:
+        /// Preprocess the translated task from sas_input.
+        PreprocessedTaskReader(istream &sas_input) : pos(0)
+        {
+            preprocess::MemoryTaskWriter writer(tokens);
+            preprocess::preprocess_task(sas_input, writer);
+        }
+        virtual int read_int()
+        {
+            const preprocess::TaskToken &token = next_token("an integer");
+            if(token.kind == preprocess::TaskToken::NUMBER)
+                return static_cast<int>(token.number);
+            int value;
+            if(!parse_int(token.word.data(), token.word.data() + token.word.size(), value))
+                syntax_error("an integer", token);
+            return value;
+        }
+        virtual double read_double()
+        {
+            const preprocess::TaskToken &token = next_token("a number");
+            if(token.kind == preprocess::TaskToken::NUMBER)
+                return token.number;
+            double value;
+            if(parse_double(token.word.data(), token.word.data() + token.word.size(), value))
+                return value;
+            char *end;
+            value = strtod(token.word.c_str(), &end);
+            if(end == token.word.c_str() || *end != '\0')
+                syntax_error("a number", token);
+            return value;
+        }
+        virtual string read_string()
+        {
+            const preprocess::TaskToken &token = next_token("a word");
+            if(token.kind != preprocess::TaskToken::NUMBER)
+                return token.word;
+            ostringstream word;
+            word << token.number;
+            return word.str();
+        }
+        virtual string read_line()
+        {
+            return read_string();
+        }
+};
+
+int run_pipeline(int argc, char **argv, istream &sas_input)
+{
+    return run_planner(argc, argv, new PreprocessedTaskReader(sas_input));
+}
+
+int run_replanning_pipeline(int argc, char **argv, istream &sas_input, istream &requests)
+{
+    // Requests may change any variable or the goal, so no variable may be
+    // pruned as irrelevant for the goal of the translated task.
+    bool do_not_prune = preprocess::g_do_not_prune_variables;
+    preprocess::g_do_not_prune_variables = true;
+    TaskReader *task_reader = new PreprocessedTaskReader(sas_input);
+    preprocess::g_do_not_prune_variables = do_not_prune;
+    return run_replanner(argc, argv, task_reader, requests);
+}
@@ -0,0 +1,17 @@
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include <iostream>
+
+/// Preprocess the translated task from sas_input and run the search on it in memory.
+/**
+ * argv are the search options (argv[0] is the program name). Returns the
+ * exit code of the search.
+ */
+int run_pipeline(int argc, char **argv, std::istream &sas_input);
+
+/// Preprocess the task once without pruning variables and answer the replanning requests on it (see replanner.h).
+int run_replanning_pipeline(int argc, char **argv, std::istream &sas_input,
+        std::istream &requests);
+
+#endif
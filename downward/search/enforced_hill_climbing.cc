@@ -0,0 +1,237 @@
+#include "enforced_hill_climbing.h"
+
+#include "globals.h"
+#include "heuristic.h"
+#include "successor_generator.h"
+#include "plannerParameters.h"
+#include <time.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+EnforcedHillClimbingSearchEngine::EnforcedHillClimbingSearchEngine(
+        const SearchContext &context, Heuristic *heur) :
+        SearchEngine(context), heuristic(heur), current_h(HUGE_VAL), number_of_expanded_nodes(0),
+        number_of_plateau_escapes(0)
+{
+    assert(heuristic);
+    start_time = time(NULL);
+}
+
+EnforcedHillClimbingSearchEngine::~EnforcedHillClimbingSearchEngine()
+{
+}
+
+void EnforcedHillClimbingSearchEngine::initialize()
+{
+    cout << "INIT (enforced hill-climbing)" << endl;
+    closed_list.clear();
+    plateau.clear();
+    current_h = HUGE_VAL;
+
+    TimeStampedState initial_state = *context.task.initial_state;
+    const TimeStampedState *initial_ptr = closed_list.insert(initial_state, NULL, NULL);
+    double h = heuristic->evaluate(*initial_ptr);
+    if(heuristic->is_dead_end()) {
+        cout << "Initial state is a dead end." << endl;
+        return;
+    }
+    current_h = h;
+    vector<const Operator *> preferred;
+    heuristic->get_preferred_operators(preferred, REGULAR);
+    plateau.push_back(PlateauEntry(initial_ptr, preferred));
+    report_progress();
+}
+
+void EnforcedHillClimbingSearchEngine::statistics(time_t & current_time)
+{
+    cout << endl;
+    cout << "Search Time: " << (current_time - start_time) << " sec." << endl;
+    search_statistics.dump(number_of_expanded_nodes, current_time);
+    cout << "Plateau size: " << plateau.size() << endl;
+    cout << "Plateau escapes: " << number_of_plateau_escapes << endl;
+    cout << "Heuristic Computations: " << heuristic->get_num_computations() << endl;
+    cout << "Number of cache hits in heuristic: " << heuristic->get_num_cache_hits() << endl;
+    cout << "Best heuristic value: " << current_h << endl;
+    dump_allocation_statistics();
+    cout << endl;
+}
+
+void EnforcedHillClimbingSearchEngine::dump_allocation_statistics() const
+{
+    SearchEngine::dump_allocation_statistics();
+    closed_list.dump_statistics();
+}
+
+void EnforcedHillClimbingSearchEngine::dump_everything() const
+{
+    cout << "DEBUG: current heuristic value: " << current_h << endl;
+    cout << "DEBUG: plateau is:" << endl;
+    for(std::deque<PlateauEntry>::const_iterator it = plateau.begin(); it != plateau.end(); ++it) {
+        cout << "PlateauEntry" << endl;
+        it->first->dump(true);
+        cout << "preferred ops: ";
+        for(unsigned int i = 0; i < it->second.size(); ++i) {
+            cout << "  " << it->second[i]->get_name();
+        }
+        cout << endl;
+        cout << "end PlateauEntry" << endl;
+    }
+}
+
+void EnforcedHillClimbingSearchEngine::report_progress() const
+{
+    cout << "Best heuristic value: " << current_h
+        << " [expanded " << closed_list.size() << " state(s)]" << endl;
+}
+
+bool EnforcedHillClimbingSearchEngine::check_goal(const TimeStampedState &state)
+{
+    // running operators must have ended, otherwise the plan cannot be rescheduled
+    if(state.operators.empty() && state.satisfies(context.task.goal)) {
+        Plan plan;
+        PlanTrace path;
+        closed_list.trace_path(state, plan, path, path_states);
+        set_plan(plan);
+        set_path(path);
+        return true;
+    }
+    return false;
+}
+
+SearchEngine::status EnforcedHillClimbingSearchEngine::step()
+{
+    if(plateau.empty()) {
+        cout << "Enforced hill-climbing failed to escape plateau with h = "
+            << current_h << endl;
+        if(context.parameters.verbose) {
+            time_t current_time = time(NULL);
+            statistics(current_time);
+        }
+        return FAILED;
+    }
+
+    PlateauEntry entry = plateau.front();
+    plateau.pop_front();
+    if(expand(entry) == SOLVED)
+        return SOLVED;
+
+    time_t current_time = time(NULL);
+    report_statistics(current_time);
+
+    // enforced hill-climbing stops at the first plan, so only the
+    // timeout for "no plan found" applies here.
+    if (context.parameters.timeout_while_no_plan_found > 0
+            && current_time - start_time > context.parameters.timeout_while_no_plan_found) {
+        if(context.parameters.verbose)
+            statistics(current_time);
+        return FAILED_TIMEOUT;
+    }
+
+    return IN_PROGRESS;
+}
+
+SearchEngine::status EnforcedHillClimbingSearchEngine::expand(const PlateauEntry &entry)
+{
+    const TimeStampedState *parent_ptr = entry.first;
+    number_of_expanded_nodes++;
+
+    vector<const Operator *> all_operators;
+    context.task.successor_generator->generate_applicable_ops(*parent_ptr, all_operators);
+
+    // Try preferred operators first, then all others (no pruning, so
+    // the breadth-first plateau search stays complete for its plateau).
+    vector<const Operator *> ordered_operators;
+    const vector<const Operator *> &preferred_operators = entry.second;
+    for(int k = 0; k < preferred_operators.size(); ++k) {
+        if(find(all_operators.begin(), all_operators.end(), preferred_operators[k])
+                != all_operators.end()
+                && find(ordered_operators.begin(), ordered_operators.end(),
+                    preferred_operators[k]) == ordered_operators.end()) {
+            ordered_operators.push_back(preferred_operators[k]);
+        }
+    }
+    for(int l = 0; l < all_operators.size(); ++l) {
+        if(find(ordered_operators.begin(), ordered_operators.end(), all_operators[l])
+                == ordered_operators.end()) {
+            ordered_operators.push_back(all_operators[l]);
+        }
+    }
+
+    double maxTimeIncrement = 0.0;
+    for(int k = 0; k < parent_ptr->operators.size(); ++k) {
+        maxTimeIncrement = max(maxTimeIncrement, parent_ptr->time_increment(parent_ptr->operators[k]));
+    }
+
+    bool is_goal = false;
+    for(int j = 0; j < ordered_operators.size(); ++j) {
+        const Operator *op = ordered_operators[j];
+        assert(op->get_kind() != wait_op);
+
+        // throw away zero cost actions (can't handle) and actions that
+        // cannot improve on a known plan
+        double duration = op->get_duration(parent_ptr);
+        if(duration <= 0.0)
+            continue;
+        double makespan = max(maxTimeIncrement, duration) + parent_ptr->timestamp;
+        if(makespan >= bestMakespan)
+            continue;
+        if(!op->is_applicable(*parent_ptr, NULL, context.task.successor_generator->checks_start_conditions()))
+            continue;
+
+        TimeStampedState child(*parent_ptr, *op);
+        bool improved = insert_child(parent_ptr, op, child, is_goal);
+        if(is_goal)
+            return SOLVED;
+        if(improved) {
+            search_statistics.finishExpansion();
+            return IN_PROGRESS;
+        }
+    }
+
+    // only allow let_time_pass if there are running operators (i.e. there is time to pass)
+    if(!context.parameters.insert_let_time_pass_only_when_running_operators_not_empty
+            || !parent_ptr->operators.empty()) {
+        TimeStampedState child = parent_ptr->let_time_pass(false, true);
+        insert_child(parent_ptr, context.task.let_time_pass, child, is_goal);
+        if(is_goal)
+            return SOLVED;
+    }
+
+    search_statistics.finishExpansion();
+    return IN_PROGRESS;
+}
+
+bool EnforcedHillClimbingSearchEngine::insert_child(const TimeStampedState *parent_ptr,
+        const Operator *op, TimeStampedState &child, bool &is_goal)
+{
+    if(closed_list.contains(child))
+        return false;
+    const TimeStampedState *child_ptr = closed_list.insert(child, parent_ptr, op);
+    search_statistics.countChild(0);
+
+    double h = heuristic->evaluate(*child_ptr);
+    if(heuristic->is_dead_end())
+        return false;
+    if(check_goal(*child_ptr)) {
+        is_goal = true;
+        return true;
+    }
+
+    vector<const Operator *> preferred;
+    heuristic->get_preferred_operators(preferred, REGULAR);
+    if(h < current_h) {
+        // escaped the plateau: commit to this state and restart from it
+        current_h = h;
+        plateau.clear();
+        plateau.push_back(PlateauEntry(child_ptr, preferred));
+        number_of_plateau_escapes++;
+        report_progress();
+        return true;
+    }
+    plateau.push_back(PlateauEntry(child_ptr, preferred));
+    return false;
+}
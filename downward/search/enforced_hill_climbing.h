@@ -0,0 +1,76 @@
+#ifndef ENFORCED_HILL_CLIMBING_H
+#define ENFORCED_HILL_CLIMBING_H
+
+#include <vector>
+#include <deque>
+#include <utility>
+#include "closed_list.h"
+#include "search_engine.h"
+#include "state.h"
+#include "operator.h"
+#include "search_statistics.h"
+#include "globals.h"
+
+class Heuristic;
+
+/// Enforced hill-climbing search.
+/**
+ * Starting from the current state, a breadth-first search is run until
+ * a state with a strictly better heuristic value is found. The search
+ * then commits to that state and restarts the breadth-first search from
+ * there (plateau escape). Preferred operators of the heuristic are tried
+ * before all other applicable operators.
+ *
+ * The engine is incomplete: If the breadth-first search from the current
+ * state exhausts without improvement, FAILED is returned and the caller
+ * is expected to fall back to a complete search (BestFirstSearchEngine).
+ */
+class EnforcedHillClimbingSearchEngine : public SearchEngine
+{
+    private:
+        typedef std::pair<const TimeStampedState *, std::vector<const Operator *> > PlateauEntry;
+
+        Heuristic *heuristic;
+        ClosedList closed_list;
+
+        /// Breadth-first queue of the current plateau, states with their preferred operators
+        std::deque<PlateauEntry> plateau;
+        double current_h;        ///< Heuristic value of the state the current plateau started from
+
+        int number_of_expanded_nodes;
+        int number_of_plateau_escapes;
+
+        time_t start_time;
+
+        SearchStatistics search_statistics;
+
+    private:
+        /// Generate all successors of parent_ptr, preferred operators first.
+        /**
+         * \returns SOLVED if a goal was found, IN_PROGRESS otherwise.
+         */
+        SearchEngine::status expand(const PlateauEntry &entry);
+        /// Evaluate and queue one child, returns true if it improves on current_h.
+        bool insert_child(const TimeStampedState *parent_ptr, const Operator *op,
+                TimeStampedState &child, bool &is_goal);
+        bool check_goal(const TimeStampedState &state);
+        void report_progress() const;
+
+    protected:
+        virtual SearchEngine::status step();
+
+    public:
+        EnforcedHillClimbingSearchEngine(const SearchContext &context, Heuristic *heur);
+        ~EnforcedHillClimbingSearchEngine();
+
+        virtual void statistics(time_t & current_time);
+        virtual void dump_allocation_statistics() const;
+        virtual void initialize();
+        virtual void dump_everything() const;
+        virtual int get_number_of_expanded_nodes() const
+        {
+            return number_of_expanded_nodes;
+        }
+};
+
+#endif
@@ -0,0 +1,316 @@
+#include "epsilonize.h"
+#include "operator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Decimal places of the written plans (see write_plan).
+static const int PLAN_DECIMALS = 8;
+
+/// Largest number of decimal places of the fixed point arithmetic.
+static const int MAX_DECIMALS = 18;
+
+/// Bound of all fixed point values, leaves room for sums of a few of them.
+static const int64_t MAX_UNITS = static_cast<int64_t>(1) << 60;
+
+/// Plan step with start time and duration in fixed point units.
+struct FixedPointStep
+{
+    int64_t timestamp;
+    int64_t duration;
+
+    int64_t end() const
+    {
+        return timestamp + duration;
+    }
+};
+
+typedef vector<FixedPointStep> FixedPointPlan;
+
+static int64_t power_of_ten(int exponent)
+{
+    int64_t result = 1;
+    for(int i = 0; i < exponent; i++)
+        result *= 10;
+    return result;
+}
+
+/// Value as written with "%.8f" in units of 10^-8, false if it is negative or too large.
+static bool to_plan_units(double value, int64_t &units)
+{
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), "%.*f", PLAN_DECIMALS, value);
+    if(length <= 0 || length >= static_cast<int>(sizeof(buffer)) || buffer[0] == '-')
+        return false;
+    units = 0;
+    for(const char *c = buffer; *c; c++) {
+        if(*c == '.')
+            continue;
+        if(*c < '0' || *c > '9' || units > MAX_UNITS / 10)
+            return false;
+        units = units * 10 + (*c - '0');
+    }
+    return units <= MAX_UNITS;
+}
+
+/// Smallest number of decimal places that represent all durations exactly.
+static int duration_granularity(const FixedPointPlan &plan, int decimals)
+{
+    for(int places = 0; places < decimals; places++) {
+        int64_t unit = power_of_ten(decimals - places);
+        bool exact = true;
+        for(int i = 0; exact && i < plan.size(); i++)
+            exact = plan[i].duration % unit == 0;
+        if(exact)
+            return places;
+    }
+    return decimals;
+}
+
+/// Smallest k with number <= 10^k.
+static int next_power_of_ten(int number)
+{
+    int exponent = 0;
+    for(int64_t power = 1; power < number; power *= 10)
+        exponent++;
+    return exponent;
+}
+
+static int64_t get_makespan(const FixedPointPlan &plan)
+{
+    int64_t makespan = 0;
+    for(int i = 0; i < plan.size(); i++)
+        makespan = max(makespan, plan[i].end());
+    return makespan;
+}
+
+static void add_separation(FixedPointPlan &plan, int64_t separation)
+{
+    for(int i = 0; i < plan.size(); i++)
+        plan[i].timestamp += (i + 1) * separation;
+}
+
+/// Latest start or end of a step other than excluded that is not after time.
+static int64_t last_happening_before(const FixedPointPlan &plan, int64_t time, int excluded)
+{
+    int64_t last_happening = 0;
+    for(int i = 0; i < plan.size(); i++) {
+        if(i == excluded)
+            continue;
+        if(plan[i].timestamp <= time)
+            last_happening = max(last_happening, plan[i].timestamp);
+        if(plan[i].end() <= time)
+            last_happening = max(last_happening, plan[i].end());
+    }
+    return last_happening;
+}
+
+class CompareTimestamps
+{
+    const FixedPointPlan &plan;
+public:
+    CompareTimestamps(const FixedPointPlan &p) : plan(p)
+    {
+    }
+
+    bool operator()(int lhs, int rhs) const
+    {
+        return plan[lhs].timestamp < plan[rhs].timestamp;
+    }
+};
+
+/// Move every start back to the happening before it, in order of the separated start times.
+static void remove_wasted_time(FixedPointPlan &plan, int64_t separation)
+{
+    // last_happening_before only works properly if no two steps share a
+    // happening, so separate them first
+    add_separation(plan, separation);
+    vector<int> order(plan.size());
+    for(int i = 0; i < order.size(); i++)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), CompareTimestamps(plan));
+    for(int i = 0; i < order.size(); i++)
+        plan[order[i]].timestamp = last_happening_before(plan, plan[order[i]].timestamp, order[i]);
+}
+
+static int64_t get_adjusted_makespan(const FixedPointPlan &plan, int64_t separation)
+{
+    FixedPointPlan adjusted = plan;
+    remove_wasted_time(adjusted, separation);
+    return get_makespan(adjusted);
+}
+
+/// Epsilonize the steps given by start_times and durations in place.
+/**
+ * Sets the properties of result, but not its plan.
+ */
+static bool epsilonize_steps(vector<double> &start_times, vector<double> &durations,
+        EpsilonizedPlan &result)
+{
+    int num_steps = start_times.size();
+    FixedPointPlan fixed(num_steps);
+    int64_t largest = 0;
+    for(int i = 0; i < num_steps; i++) {
+        if(!to_plan_units(start_times[i], fixed[i].timestamp)
+                || !to_plan_units(durations[i], fixed[i].duration))
+            return false;
+        largest = max(largest, fixed[i].end());
+    }
+
+    // separation = granularity / next power of ten of the plan size / 100
+    int separation_decimals = duration_granularity(fixed, PLAN_DECIMALS)
+        + next_power_of_ten(num_steps) + 2;
+    int decimals = max(PLAN_DECIMALS, separation_decimals);
+    if(decimals > MAX_DECIMALS)
+        return false;
+    int64_t scale = power_of_ten(decimals - PLAN_DECIMALS);
+    // timestamps grow by at most twice the plan size times the separation
+    if(largest > MAX_UNITS / scale / 4)
+        return false;
+    for(int i = 0; i < fixed.size(); i++) {
+        fixed[i].timestamp *= scale;
+        fixed[i].duration *= scale;
+    }
+    int64_t separation = power_of_ten(decimals - separation_decimals);
+
+    int64_t orig_makespan = get_makespan(fixed);
+    remove_wasted_time(fixed, separation);
+    add_separation(fixed, separation);
+    int64_t adjusted_makespan = get_adjusted_makespan(fixed, separation);
+    int64_t makespan = get_makespan(fixed);
+    if(orig_makespan < adjusted_makespan)
+        return false;
+
+    double unit = static_cast<double>(power_of_ten(decimals));
+    for(int i = 0; i < num_steps; i++) {
+        start_times[i] = fixed[i].timestamp / unit;
+        durations[i] = fixed[i].duration / unit;
+    }
+    result.orig_makespan = orig_makespan / unit;
+    result.adjusted_makespan = adjusted_makespan / unit;
+    result.makespan = makespan / unit;
+    result.wasted_time = (makespan - adjusted_makespan) / unit;
+    result.val_param = separation / unit / 2;
+    return true;
+}
+
+bool epsilonize_plan(const Plan &plan, EpsilonizedPlan &result)
+{
+    vector<double> start_times, durations;
+    for(int i = 0; i < plan.size(); i++) {
+        start_times.push_back(plan[i].start_time);
+        durations.push_back(plan[i].duration);
+    }
+    if(!epsilonize_steps(start_times, durations, result))
+        return false;
+    result.plan = plan;
+    for(int i = 0; i < plan.size(); i++) {
+        result.plan[i].start_time = start_times[i];
+        result.plan[i].duration = durations[i];
+    }
+    return true;
+}
+
+static void write_properties(FILE *file, const EpsilonizedPlan &plan)
+{
+    fprintf(file, "; eps_adjusted_makespan: %.10f\n", plan.adjusted_makespan);
+    fprintf(file, "; eps_makespan: %.10f\n", plan.makespan);
+    fprintf(file, "; eps_orig_makespan: %.10f\n", plan.orig_makespan);
+    fprintf(file, "; eps_val_param: %.10f\n", plan.val_param);
+    fprintf(file, "; eps_wasted_time: %.10f\n", plan.wasted_time);
+}
+
+static void write_step(FILE *file, double start_time, const string &name, double duration)
+{
+    fprintf(file, "%.10f: (%s) [%.10f]\n", start_time, name.c_str(), duration);
+}
+
+void write_epsilonized_plan(FILE *file, const EpsilonizedPlan &plan)
+{
+    write_properties(file, plan);
+    for(int i = 0; i < plan.plan.size(); i++) {
+        const PlanStep &step = plan.plan[i];
+        write_step(file, step.start_time, step.op->get_name(), step.duration);
+    }
+}
+
+static string strip(const string &text)
+{
+    string::size_type begin = text.find_first_not_of(" \t\r\n");
+    if(begin == string::npos)
+        return "";
+    string::size_type end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+/// Parse "[<start>:] (<name>) [[<duration>]]" as epsilonize_plan.py does.
+static bool parse_step(const string &line, bool has_previous, double previous_start,
+        double &start_time, string &name, double &duration)
+{
+    string::size_type open = line.find('(');
+    string::size_type close = line.rfind(')');
+    if(open == string::npos || close == string::npos || close < open)
+        return false;
+    string prefix = strip(line.substr(0, open));
+    if(prefix.empty()) {
+        // a missing start time is the one of the previous step
+        if(!has_previous)
+            return false;
+        start_time = previous_start;
+    } else {
+        if(prefix[prefix.size() - 1] != ':')
+            return false;
+        string number = strip(prefix.substr(0, prefix.size() - 1));
+        char *end;
+        start_time = strtod(number.c_str(), &end);
+        if(number.empty() || *end)
+            return false;
+    }
+    name = strip(line.substr(open + 1, close - open - 1));
+
+    string suffix = strip(line.substr(close + 1));
+    duration = 0;
+    if(!suffix.empty()) {
+        if(suffix[0] != '[' || suffix[suffix.size() - 1] != ']')
+            return false;
+        string number = strip(suffix.substr(1, suffix.size() - 2));
+        char *end;
+        duration = strtod(number.c_str(), &end);
+        if(number.empty() || *end)
+            return false;
+    }
+    return start_time >= 0 && duration >= 0;
+}
+
+bool epsilonize_plan_file(istream &in, FILE *out)
+{
+    vector<double> start_times, durations;
+    vector<string> names;
+    string line;
+    while(getline(in, line)) {
+        line = strip(line.substr(0, line.find(';')));
+        if(line.empty())
+            continue;
+        double start_time, duration;
+        string name;
+        if(!parse_step(line, !start_times.empty(),
+                    start_times.empty() ? 0 : start_times.back(), start_time, name, duration))
+            return false;
+        start_times.push_back(start_time);
+        names.push_back(name);
+        durations.push_back(duration);
+    }
+
+    EpsilonizedPlan result;
+    if(!epsilonize_steps(start_times, durations, result))
+        return false;
+    write_properties(out, result);
+    for(int i = 0; i < names.size(); i++)
+        write_step(out, start_times[i], names[i], durations[i]);
+    return true;
+}
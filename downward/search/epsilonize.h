@@ -0,0 +1,50 @@
+#ifndef EPSILONIZE_H
+#define EPSILONIZE_H
+
+#include "globals.h"
+
+#include <cstdio>
+#include <iostream>
+
+/// A plan after epsilonize_plan together with the properties reported for it.
+struct EpsilonizedPlan
+{
+    Plan plan;
+    double orig_makespan;       ///< makespan of the input plan
+    double adjusted_makespan;   ///< makespan without wasted time
+    double makespan;            ///< makespan of the epsilonized plan
+    double wasted_time;         ///< makespan - adjusted_makespan
+    double val_param;           ///< half the separation, the tolerance to use for VAL
+
+    EpsilonizedPlan() : orig_makespan(0), adjusted_makespan(0), makespan(0),
+        wasted_time(0), val_param(0)
+    {
+    }
+};
+
+/// Epsilonize plan in-process, as epsilonize_plan.py does for a plan file.
+/**
+ * Wasted time (start times that can be moved to the previous happening) is
+ * removed and all happenings are separated by an epsilon that is below the
+ * granularity of the durations. The plan is processed as written with
+ * "%.8f" and all arithmetic is exact decimal arithmetic, so the result is
+ * the same as the one of the script on the written plan.
+ *
+ * \returns false, if the plan cannot be epsilonized (negative times, times
+ * too large for exact arithmetic or an adjusted makespan larger than the
+ * original one). result is undefined then.
+ */
+bool epsilonize_plan(const Plan &plan, EpsilonizedPlan &result);
+
+/// Write plan in the format of epsilonize_plan.py (properties as comments, times with "%.10f").
+void write_epsilonized_plan(FILE *file, const EpsilonizedPlan &plan);
+
+/// Epsilonize the plan file in and write it to out, like epsilonize_plan.py.
+/**
+ * Reads the plan format of the script (comments after ';', optional start
+ * time and duration). \returns false if a line cannot be parsed or the
+ * plan cannot be epsilonized, out may have been written to then.
+ */
+bool epsilonize_plan_file(std::istream &in, FILE *out);
+
+#endif
@@ -0,0 +1,203 @@
+#include "event_stream.h"
+#include "operator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static double get_walltime()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static string json_string(const string &value)
+{
+    string result = "\"";
+    for(int i = 0; i < value.size(); i++) {
+        char c = value[i];
+        if(c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if(static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            sprintf(escaped, "\\u%04x", c);
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
+
+static string json_number(double value)
+{
+    if(value != value || value > REALLYBIG || value < -REALLYBIG)
+        return "null";  // NaN and infinity are no JSON numbers
+    char buffer[32];
+    if(fabs(value) < 1e15)
+        sprintf(buffer, "%.8f", value);
+    else
+        sprintf(buffer, "%.17g", value);
+    return buffer;
+}
+
+static string json_int(int value)
+{
+    char buffer[16];
+    sprintf(buffer, "%d", value);
+    return buffer;
+}
+
+EventStream::EventStream() :
+    fd(-1), owns_fd(false), start_walltime(0)
+{
+}
+
+EventStream::~EventStream()
+{
+    close_stream();
+}
+
+bool EventStream::open(const string &target)
+{
+    close_stream();
+    start_walltime = get_walltime();
+    if(!target.empty() && target.find_first_not_of("0123456789") == string::npos) {
+        fd = atoi(target.c_str());
+        if(fcntl(fd, F_GETFD) < 0) {
+            cerr << "Event stream: file descriptor " << fd << " is not open." << endl;
+            fd = -1;
+            return false;
+        }
+    } else if(target.compare(0, 5, "unix:") == 0) {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        string path = target.substr(5);
+        if(path.size() >= sizeof(address.sun_path)) {
+            cerr << "Event stream: socket path too long: " << path << endl;
+            return false;
+        }
+        strcpy(address.sun_path, path.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+            perror(path.c_str());
+            if(fd >= 0)
+                ::close(fd);
+            fd = -1;
+            return false;
+        }
+        owns_fd = true;
+    } else {
+        fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) {
+            perror(target.c_str());
+            return false;
+        }
+        owns_fd = true;
+    }
+    // a reader that goes away must not kill the search
+    signal(SIGPIPE, SIG_IGN);
+    return true;
+}
+
+void EventStream::close_stream()
+{
+    if(fd >= 0 && owns_fd)
+        ::close(fd);
+    fd = -1;
+    owns_fd = false;
+}
+
+void EventStream::write_event(const string &type, const string &fields)
+{
+    if(fd < 0)
+        return;
+    string line = "{\"event\": " + json_string(type) + ", \"time\": "
+        + json_number(get_walltime() - start_walltime);
+    if(!fields.empty())
+        line += ", " + fields;
+    line += "}\n";
+    const char *data = line.data();
+    size_t size = line.size();
+    while(size > 0) {
+        ssize_t written = write(fd, data, size);
+        if(written < 0 && errno == EINTR)
+            continue;
+        if(written <= 0) {
+            cerr << "Event stream: write failed, closing it." << endl;
+            close_stream();
+            return;
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+void EventStream::incumbent(const Plan &plan, int plan_number, const string &plan_file)
+{
+    if(fd < 0)
+        return;
+    double makespan = 0;
+    string steps;
+    for(int i = 0; i < plan.size(); i++) {
+        const PlanStep &step = plan[i];
+        makespan = max(makespan, step.start_time + step.duration);
+        if(i > 0)
+            steps += ", ";
+        steps += "{\"start\": " + json_number(step.start_time)
+            + ", \"name\": " + json_string(step.op->get_name())
+            + ", \"duration\": " + json_number(step.duration) + "}";
+    }
+    write_event("incumbent", "\"plan_number\": " + json_int(plan_number)
+        + ", \"makespan\": " + json_number(makespan)
+        + ", \"file\": " + json_string(plan_file)
+        + ", \"plan\": [" + steps + "]");
+}
+
+void EventStream::progress(int expanded, const vector<double> &best_heuristic_values)
+{
+    if(fd < 0)
+        return;
+    string values;
+    for(int i = 0; i < best_heuristic_values.size(); i++)
+        values += (i > 0 ? ", " : "") + json_number(best_heuristic_values[i]);
+    write_event("progress", "\"expanded\": " + json_int(expanded)
+        + ", \"best_h\": [" + values + "]");
+}
+
+void EventStream::statistics(int expanded, int generated, const vector<int> &open_list_sizes)
+{
+    if(fd < 0)
+        return;
+    string sizes;
+    for(int i = 0; i < open_list_sizes.size(); i++)
+        sizes += (i > 0 ? ", " : "") + json_int(open_list_sizes[i]);
+    write_event("statistics", "\"expanded\": " + json_int(expanded)
+        + ", \"generated\": " + json_int(generated)
+        + ", \"open\": [" + sizes + "]");
+}
+
+void EventStream::termination(const string &reason, int exit_code, int plans, double best_makespan)
+{
+    write_event("termination", "\"reason\": " + json_string(reason)
+        + ", \"exit_code\": " + json_int(exit_code)
+        + ", \"plans\": " + json_int(plans)
+        + ", \"best_makespan\": "
+        + (best_makespan == REALLYBIG ? string("null") : json_number(best_makespan)));
+}
@@ -0,0 +1,57 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include "globals.h"
+
+#include <string>
+#include <vector>
+
+/// Progress of the search as JSON lines for other processes (option J).
+/**
+ * Every event is one JSON object on a line of its own, written with a
+ * single write call. All events have the fields "event" and "time" (wall
+ * clock seconds since the stream was opened):
+ *
+ *   {"event": "incumbent", "plan_number": n, "makespan": m, "file": f,
+ *    "plan": [{"start": s, "name": op, "duration": d}, ...]}
+ *       a new best plan was written (file is empty for stdout)
+ *   {"event": "progress", "expanded": n, "best_h": [h, ...]}
+ *       a better heuristic value was reached in one of the open lists
+ *   {"event": "statistics", "expanded": n, "generated": n, "open": [size, ...]}
+ *       periodically during best first search
+ *   {"event": "termination", "reason": r, "exit_code": c, "plans": n,
+ *    "best_makespan": m}
+ *       the search ended, reason is one of solved, solved_complete,
+ *       timeout, unsolved or error (best_makespan is null without plan)
+ *
+ * If the reader goes away the stream is closed and the search continues.
+ */
+class EventStream
+{
+    int fd;
+    bool owns_fd;
+    double start_walltime;
+
+    void write_event(const std::string &type, const std::string &fields);
+    void close_stream();
+    public:
+        /// Seconds between statistics events.
+        static const int STATISTICS_INTERVAL = 1;
+
+        EventStream();
+        ~EventStream();
+
+        /// Open target: a file descriptor number, "unix:<socket path>" or a file name.
+        bool open(const std::string &target);
+        bool is_open() const
+        {
+            return fd >= 0;
+        }
+
+        void incumbent(const Plan &plan, int plan_number, const std::string &plan_file);
+        void progress(int expanded, const std::vector<double> &best_heuristic_values);
+        void statistics(int expanded, int generated, const std::vector<int> &open_list_sizes);
+        void termination(const std::string &reason, int exit_code, int plans, double best_makespan);
+};
+
+#endif
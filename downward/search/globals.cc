@@ -16,6 +16,7 @@ using namespace std;
 #include "state.h"
 #include "successor_generator.h"
 #include "plannerParameters.h"
+#include "task_reader.h"
 
 void PlanStep::dump() const
 {
@@ -23,7 +24,7 @@ void PlanStep::dump() const
         << endl;
 }
 
-void check_magic(istream &in, string magic)
+void check_magic(TaskReader &in, string magic)
 {
     string word;
     in >> word;
@@ -34,7 +35,7 @@ void check_magic(istream &in, string magic)
     }
 }
 
-void read_variables(istream &in)
+void read_variables(Task &task, TaskReader &in)
 {
     check_magic(in, "begin_variables");
     int count;
@@ -42,26 +43,26 @@ void read_variables(istream &in)
     for(int i = 0; i < count; i++) {
         string name;
         in >> name;
-        g_variable_name.push_back(name);
+        task.variable_name.push_back(name);
         int range;
         in >> range;
-        g_variable_domain.push_back(range);
+        task.variable_domain.push_back(range);
         int layer;
         in >> layer;
-        g_axiom_layers.push_back(layer);
+        task.axiom_layers.push_back(layer);
         //identify variable type
         if(range != -1) {
-            g_variable_types.push_back(logical);
+            task.variable_types.push_back(logical);
             //changes to comparison if a comparison axiom is detected
         } else {
-            g_variable_types.push_back(primitive_functional);
+            task.variable_types.push_back(primitive_functional);
             //changes to subterm_functional if a numeric axiom is detected
         }
     }
     check_magic(in, "end_variables");
 }
 
-void read_goal(istream &in)
+void read_goal(Task &task, TaskReader &in)
 {
     check_magic(in, "begin_goal");
     int count;
@@ -70,126 +71,166 @@ void read_goal(istream &in)
         int var;
         double val;
         in >> var >> val;
-        g_goal.push_back(make_pair(var, val));
+        task.goal.push_back(make_pair(var, val));
     }
     check_magic(in, "end_goal");
 }
 
-void dump_goal()
+void dump_goal(const Task &task)
 {
     cout << "Goal Conditions:" << endl;
-    for(int i = 0; i < g_goal.size(); i++)
-        cout << "  " << g_variable_name[g_goal[i].first] << ": "
-            << g_goal[i].second << endl;
+    for(int i = 0; i < task.goal.size(); i++)
+        cout << "  " << task.variable_name[task.goal[i].first] << ": "
+            << task.goal[i].second << endl;
 }
 
-void read_operators(istream &in)
+void read_operators(Task &task, TaskReader &in)
 {
     int count;
     in >> count;
     for(int i = 0; i < count; i++)
-        g_operators.push_back(Operator(in));
+        task.operators.push_back(Operator(in, i, task));
 }
 
-void read_logic_axioms(istream &in)
+void read_logic_axioms(Task &task, TaskReader &in)
 {
     int count;
     in >> count;
     for(int i = 0; i < count; i++) {
         LogicAxiom *ax = new LogicAxiom(in);
-        g_axioms.push_back(ax);
+        task.axioms.push_back(ax);
     }
 }
 
-void read_numeric_axioms(istream &in)
+void read_numeric_axioms(Task &task, TaskReader &in)
 {
     int count;
     in >> count;
     for(int i = 0; i < count; i++) {
-        NumericAxiom *ax = new NumericAxiom(in);
-        g_axioms.push_back(ax);
+        NumericAxiom *ax = new NumericAxiom(in, task);
+        task.axioms.push_back(ax);
         // ax->dump();
     }
 }
 
-void read_contains_universal_conditions(istream &in)
+void read_contains_universal_conditions(Task &task, TaskReader &in)
 {
-    in >> g_contains_universal_conditions;
+    in >> task.contains_universal_conditions;
 }
 
-void evaluate_axioms_in_init()
+static bool has_numeric_or_conditional_effect(const Task &task,
+        const vector<PrePost> &effects)
 {
-    g_axiom_evaluator = new AxiomEvaluator;
-    g_axiom_evaluator->evaluate(*g_initial_state);
+    for(int i = 0; i < effects.size(); i++) {
+        const PrePost &eff = effects[i];
+        if(task.is_functional(eff.var) || !eff.cond_start.empty() ||
+                !eff.cond_overall.empty() || !eff.cond_end.empty())
+            return true;
+    }
+    return false;
+}
+
+/// Find the task_class of the task, after the operators and axioms were read.
+static task_class classify_task(const Task &task)
+{
+    if(!task.axioms.empty())
+        return general_task;
+    for(int i = 0; i < task.operators.size(); i++) {
+        if(has_numeric_or_conditional_effect(task, task.operators[i].get_pre_post_start()) ||
+                has_numeric_or_conditional_effect(task, task.operators[i].get_pre_post_end()))
+            return numeric_task;
+    }
+    return propositional_task;
+}
+
+const char *task_class_name(task_class tc)
+{
+    switch(tc) {
+        case propositional_task:
+            return "propositional";
+        case numeric_task:
+            return "numeric";
+        default:
+            return "general";
+    }
 }
 
-void read_everything(istream &in)
+void evaluate_axioms_in_init(Task &task)
 {
-    read_variables(in);
-    g_initial_state = new TimeStampedState(in);
-    //g_initial_state->dump();
-    read_goal(in);
-    read_operators(in);
-    read_logic_axioms(in);
-    read_numeric_axioms(in);
-    evaluate_axioms_in_init();
+    task.axiom_evaluator = new AxiomEvaluator(task);
+    task.axiom_evaluator->evaluate(*task.initial_state);
+}
+
+void read_everything(const SearchContext &context, TaskReader &in)
+{
+    Task &task = context.task;
+    read_variables(task, in);
+    task.initial_state = new TimeStampedState(context, in);
+    //task.initial_state->dump(true);
+    read_goal(task, in);
+    read_operators(task, in);
+    read_logic_axioms(task, in);
+    read_numeric_axioms(task, in);
+    task.progression_class = classify_task(task);
+    evaluate_axioms_in_init(task);
     check_magic(in, "begin_SG");
-    g_successor_generator = read_successor_generator(in);
+    task.successor_generator = new SuccessorGenerator(task, in,
+            context.parameters.check_start_conditions_in_successor_generator);
     check_magic(in, "end_SG");
-    g_causal_graph = new CausalGraph(in);
-    DomainTransitionGraph::read_all(in);
-    read_contains_universal_conditions(in);
+    task.causal_graph = new CausalGraph(task, in);
+    DomainTransitionGraph::read_all(task, in);
+    read_contains_universal_conditions(task, in);
 }
 
-void dump_everything()
+void dump_everything(const Task &task)
 {
-    cout << "Variables (" << g_variable_name.size() << "):" << endl;
-    for(int i = 0; i < g_variable_name.size(); i++)
-        cout << "  " << g_variable_name[i] << " (range "
-            << g_variable_domain[i] << ")" << endl;
+    cout << "Variables (" << task.variable_name.size() << "):" << endl;
+    for(int i = 0; i < task.variable_name.size(); i++)
+        cout << "  " << task.variable_name[i] << " (range "
+            << task.variable_domain[i] << ")" << endl;
     cout << "Initial State:" << endl;
-    g_initial_state->dump(true);
-    dump_goal();
+    task.initial_state->dump(true);
+    dump_goal(task);
     cout << "Successor Generator:" << endl;
-    g_successor_generator->dump();
-    for(int i = 0; i < g_variable_domain.size(); i++)
-        g_transition_graphs[i]->dump();
+    task.successor_generator->dump();
+    for(int i = 0; i < task.variable_domain.size(); i++)
+        task.transition_graphs[i]->dump();
 }
 
-void dump_DTGs()
+void dump_DTGs(const Task &task)
 {
-    for(int i = 0; i < g_variable_domain.size(); i++) {
+    for(int i = 0; i < task.variable_domain.size(); i++) {
         cout << "DTG of variable " << i;
-        g_transition_graphs[i]->dump();
+        task.transition_graphs[i]->dump();
     }
 }
 
-int g_last_arithmetic_axiom_layer;
-int g_comparison_axiom_layer;
-int g_first_logic_axiom_layer;
-int g_last_logic_axiom_layer;
-vector<string> g_variable_name;
-vector<int> g_variable_domain;
-vector<int> g_axiom_layers;
-vector<double> g_default_axiom_values;
-vector<variable_type> g_variable_types;
-TimeStampedState *g_initial_state;
-vector<pair<int, double> > g_goal;
-vector<Operator> g_operators;
-vector<Axiom*> g_axioms;
-AxiomEvaluator *g_axiom_evaluator;
-SuccessorGenerator *g_successor_generator;
-vector<DomainTransitionGraph *> g_transition_graphs;
-CausalGraph *g_causal_graph;
-
-PlannerParameters g_parameters;
-
-Operator *g_let_time_pass;
-Operator *g_wait_operator;
+Task::Task() :
+    last_arithmetic_axiom_layer(-1), comparison_axiom_layer(-1),
+    first_logic_axiom_layer(-1), last_logic_axiom_layer(-1),
+    initial_state(0), axiom_evaluator(0), successor_generator(0),
+    causal_graph(0), let_time_pass(0), wait_operator(0),
+    contains_universal_conditions(false), effect_pool(new EffectPool),
+    progression_class(general_task)
+{
+}
 
-bool g_contains_universal_conditions;
+Task::~Task()
+{
+    delete initial_state;
+    for(int i = 0; i < axioms.size(); i++)
+        delete axioms[i];
+    delete axiom_evaluator;
+    delete successor_generator;
+    for(int i = 0; i < transition_graphs.size(); i++)
+        delete transition_graphs[i];
+    delete causal_graph;
+    delete let_time_pass;
+    delete wait_operator;
+    delete effect_pool;
+}
 
-istream& operator>>(istream &is, assignment_op &aop)
+TaskReader &operator>>(TaskReader &is, assignment_op &aop)
 {
     string strVal;
     is >> strVal;
@@ -237,7 +278,7 @@ ostream& operator<<(ostream &os, const assignment_op &aop)
     return os;
 }
 
-istream& operator>>(istream &is, binary_op &bop)
+TaskReader &operator>>(TaskReader &is, binary_op &bop)
 {
     string strVal;
     is >> strVal;
@@ -308,7 +349,7 @@ ostream& operator<<(ostream &os, const binary_op &bop)
     return os;
 }
 
-istream& operator>>(istream &is, trans_type &tt)
+TaskReader &operator>>(TaskReader &is, trans_type &tt)
 {
     string strVal;
     is >> strVal;
@@ -349,7 +390,7 @@ ostream& operator<<(ostream &os, const trans_type &tt)
     return os;
 }
 
-istream& operator>>(istream &is, condition_type &ct)
+TaskReader &operator>>(TaskReader &is, condition_type &ct)
 {
     string strVal;
     is >> strVal;
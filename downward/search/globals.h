@@ -19,12 +19,19 @@ using namespace std;
 class AxiomEvaluator;
 //class CausalGraph;
 class DomainTransitionGraph;
+class EffectPool;
+class EventStream;
+class Instrumentation;
 class Operator;
+class PlannerParameters;
 class Axiom;
 class LogicAxiom;
 class NumericAxiom;
 class TimeStampedState;
 class SuccessorGenerator;
+class TaskReader;
+struct Task;
+struct SearchContext;
 
 enum OpenListMode {ALL=0, REGULAR=1, ORDERED=2, CHEAPEST=3, MOSTEXPENSIVE=4, RAND=5, CONCURRENT=6};
 
@@ -62,11 +69,11 @@ inline bool double_equals(double a, double b)
 const double REALLYBIG = numeric_limits<double>::max();
 const double REALLYSMALL = -numeric_limits<double>::max();
 
-void read_everything(istream &in);
-void dump_everything();
-void dump_DTGs();
+void read_everything(const SearchContext &context, TaskReader &in);
+void dump_everything(const Task &task);
+void dump_DTGs(const Task &task);
 
-void check_magic(istream &in, string magic);
+void check_magic(TaskReader &in, string magic);
 
 enum variable_type
 {
@@ -76,37 +83,76 @@ enum variable_type
     comparison
 };
 
-extern int g_last_arithmetic_axiom_layer;
-extern int g_comparison_axiom_layer;
-extern int g_first_logic_axiom_layer;
-extern int g_last_logic_axiom_layer;
-extern vector<string> g_variable_name;
-extern vector<int> g_variable_domain;
-extern vector<int> g_axiom_layers;
-extern vector<double> g_default_axiom_values;
-extern vector<variable_type> g_variable_types;
-extern TimeStampedState *g_initial_state;
-extern vector<pair<int, double> > g_goal;
-extern vector<Operator> g_operators;
-extern vector<Axiom*> g_axioms;
-extern AxiomEvaluator *g_axiom_evaluator;
-extern SuccessorGenerator *g_successor_generator;
-extern vector<DomainTransitionGraph *> g_transition_graphs;
-extern CausalGraph *g_causal_graph;
+/// Features of a task that select the code used to progress its states.
+enum task_class
+{
+    propositional_task,     ///< no numeric or conditional effects, no axioms
+    numeric_task,           ///< numeric or conditional effects, no axioms
+    general_task
+};
 
-class PlannerParameters;
-extern PlannerParameters g_parameters;
+/// Name of a task_class for output.
+const char *task_class_name(task_class tc);
 
-inline bool is_functional(int var)
+/// All data of a planning task read from the preprocessor output.
+/**
+ * Nothing refers to a task implicitly: states, operators, axioms and the
+ * search code get the task (or the SearchContext of the search) they work
+ * on, so several tasks can be loaded and searched in one process.
+ */
+struct Task
 {
-    const variable_type& vt = g_variable_types[var];
-    return (vt == primitive_functional || vt == subterm_functional);
-}
+    int last_arithmetic_axiom_layer;
+    int comparison_axiom_layer;
+    int first_logic_axiom_layer;
+    int last_logic_axiom_layer;
+    vector<string> variable_name;
+    vector<int> variable_domain;
+    vector<int> axiom_layers;
+    vector<double> default_axiom_values;
+    vector<variable_type> variable_types;
+    TimeStampedState *initial_state;
+    vector<pair<int, double> > goal;
+    vector<Operator> operators;
+    vector<Axiom*> axioms;
+    AxiomEvaluator *axiom_evaluator;
+    SuccessorGenerator *successor_generator;
+    vector<DomainTransitionGraph *> transition_graphs;
+    CausalGraph *causal_graph;
+    Operator *let_time_pass;
+    Operator *wait_operator;
+    bool contains_universal_conditions;
+    EffectPool *effect_pool;
+    task_class progression_class;
+
+    Task();
+    ~Task();
+
+    bool is_functional(int var) const
+    {
+        const variable_type& vt = variable_types[var];
+        return (vt == primitive_functional || vt == subterm_functional);
+    }
+};
 
-extern Operator *g_let_time_pass;
-extern Operator *g_wait_operator;
+/// A task together with the parameters and outputs of a search on it.
+/**
+ * The states of the task keep a pointer to the context the task was read
+ * in, search engines and heuristics the context they were created for.
+ * So the context has to outlive the task and everything searching it.
+ */
+struct SearchContext
+{
+    Task &task;
+    PlannerParameters &parameters;
+    EventStream &events;
+    Instrumentation &instrumentation;
 
-extern bool g_contains_universal_conditions;
+    SearchContext(Task &t, PlannerParameters &p, EventStream &e, Instrumentation &i) :
+        task(t), parameters(p), events(e), instrumentation(i)
+    {
+    }
+};
 
 enum assignment_op
 {
@@ -134,16 +180,16 @@ enum condition_type
     start_cond = 0, overall_cond = 1, end_cond = 2, ax_cond
 };
 
-istream& operator>>(istream &is, assignment_op &aop);
+TaskReader &operator>>(TaskReader &is, assignment_op &aop);
 ostream& operator<<(ostream &os, const assignment_op &aop);
 
-istream& operator>>(istream &is, binary_op &bop);
+TaskReader &operator>>(TaskReader &is, binary_op &bop);
 ostream& operator<<(ostream &os, const binary_op &bop);
 
-istream& operator>>(istream &is, trans_type &tt);
+TaskReader &operator>>(TaskReader &is, trans_type &tt);
 ostream& operator<<(ostream &os, const trans_type &tt);
 
-istream& operator>>(istream &is, condition_type &fop);
+TaskReader &operator>>(TaskReader &is, condition_type &fop);
 ostream& operator<<(ostream &os, const condition_type &fop);
 
 void printSet(const set<int> s);
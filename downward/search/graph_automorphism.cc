@@ -0,0 +1,372 @@
+#include "graph_automorphism.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+/// Upper bound on the partitions stored along the first path (in ints)
+static const int MAX_FIRST_PATH_ENTRIES = 5000000;
+
+int ColoredGraph::add_vertex(int color)
+{
+    colors.push_back(color);
+    adjacency.push_back(vector<int>());
+    return colors.size() - 1;
+}
+
+void ColoredGraph::add_edge(int u, int v)
+{
+    assert(u >= 0 && u < colors.size());
+    assert(v >= 0 && v < colors.size());
+    adjacency[u].push_back(v);
+    adjacency[v].push_back(u);
+}
+
+void ColoredGraph::finalize()
+{
+    for(int i = 0; i < adjacency.size(); ++i) {
+        sort(adjacency[i].begin(), adjacency[i].end());
+        adjacency[i].erase(unique(adjacency[i].begin(), adjacency[i].end()),
+                adjacency[i].end());
+    }
+}
+
+bool ColoredGraph::is_automorphism(const vector<int> &perm) const
+{
+    assert(perm.size() == colors.size());
+    vector<int> mapped;
+    for(int u = 0; u < colors.size(); ++u) {
+        int image = perm[u];
+        if(colors[image] != colors[u])
+            return false;
+        if(adjacency[image].size() != adjacency[u].size())
+            return false;
+        mapped.clear();
+        for(int j = 0; j < adjacency[u].size(); ++j)
+            mapped.push_back(perm[adjacency[u][j]]);
+        sort(mapped.begin(), mapped.end());
+        if(mapped != adjacency[image])
+            return false;
+    }
+    return true;
+}
+
+/// Orders vertices by their neighbor count in the current splitter.
+class CountCompare
+{
+    const vector<int> &counts;
+    public:
+        CountCompare(const vector<int> &c) : counts(c)
+        {
+        }
+        bool operator()(int u, int v) const
+        {
+            return counts[u] < counts[v];
+        }
+};
+
+/// Orders vertices by color, then by index.
+class ColorCompare
+{
+    const ColoredGraph &graph;
+    public:
+        ColorCompare(const ColoredGraph &g) : graph(g)
+        {
+        }
+        bool operator()(int u, int v) const
+        {
+            if(graph.get_color(u) != graph.get_color(v))
+                return graph.get_color(u) < graph.get_color(v);
+            return u < v;
+        }
+};
+
+static int find_orbit(vector<int> &orbit, int v)
+{
+    while(orbit[v] != v) {
+        orbit[v] = orbit[orbit[v]];
+        v = orbit[v];
+    }
+    return v;
+}
+
+AutomorphismFinder::AutomorphismFinder(const ColoredGraph &g, int max_nodes) :
+        graph(g), num_vertices(g.get_num_vertices()), max_search_nodes(max_nodes),
+        search_nodes(0), limit_reached(false)
+{
+    counts.resize(num_vertices, 0);
+}
+
+void AutomorphismFinder::init_partition(Partition &p) const
+{
+    p.elements.resize(num_vertices);
+    for(int i = 0; i < num_vertices; ++i)
+        p.elements[i] = i;
+    sort(p.elements.begin(), p.elements.end(), ColorCompare(graph));
+
+    p.position.resize(num_vertices);
+    p.cell_of.resize(num_vertices);
+    p.cell_end.assign(num_vertices, -1);
+    p.num_cells = 0;
+    int start = 0;
+    for(int i = 0; i < num_vertices; ++i) {
+        if(i > 0 && graph.get_color(p.elements[i]) != graph.get_color(p.elements[i - 1])) {
+            p.cell_end[start] = i;
+            start = i;
+        }
+        if(i == start)
+            p.num_cells++;
+        p.position[p.elements[i]] = i;
+        p.cell_of[p.elements[i]] = start;
+    }
+    if(num_vertices > 0)
+        p.cell_end[start] = num_vertices;
+}
+
+int AutomorphismFinder::split_cell(Partition &p, int start, vector<int> &splitters,
+        vector<bool> &in_queue)
+{
+    int end = p.cell_end[start];
+    bool uniform = true;
+    for(int i = start + 1; i < end && uniform; ++i)
+        uniform = counts[p.elements[i]] == counts[p.elements[start]];
+    if(uniform)
+        return 0;
+    sort(p.elements.begin() + start, p.elements.begin() + end, CountCompare(counts));
+
+    bool was_queued = in_queue[start];
+    int largest = start;
+    int largest_size = 0;
+    int new_cells = 0;
+    int cell_start = start;
+    for(int i = start; i <= end; ++i) {
+        if(i < end && counts[p.elements[i]] == counts[p.elements[cell_start]]) {
+            p.position[p.elements[i]] = i;
+            p.cell_of[p.elements[i]] = cell_start;
+            continue;
+        }
+        p.cell_end[cell_start] = i;
+        if(cell_start != start) {
+            new_cells++;
+            if(was_queued) {
+                splitters.push_back(cell_start);
+                in_queue[cell_start] = true;
+            }
+        }
+        if(i - cell_start > largest_size) {
+            largest = cell_start;
+            largest_size = i - cell_start;
+        }
+        if(i < end) {
+            cell_start = i;
+            p.position[p.elements[i]] = i;
+            p.cell_of[p.elements[i]] = cell_start;
+        }
+    }
+    p.num_cells += new_cells;
+
+    if(!was_queued) {
+        // the union was stable before, all parts but one suffice as splitters
+        for(int i = start; i < end; i = p.cell_end[i]) {
+            if(i != largest) {
+                splitters.push_back(i);
+                in_queue[i] = true;
+            }
+        }
+    }
+    return new_cells;
+}
+
+void AutomorphismFinder::refine(Partition &p, vector<int> &splitters)
+{
+    vector<bool> in_queue(num_vertices, false);
+    for(int i = 0; i < splitters.size(); ++i)
+        in_queue[splitters[i]] = true;
+
+    vector<int> touched_vertices;
+    vector<int> touched_cells;
+    vector<bool> cell_touched(num_vertices, false);
+    for(int head = 0; head < splitters.size() && p.num_cells < num_vertices; ++head) {
+        int splitter = splitters[head];
+        in_queue[splitter] = false;
+
+        for(int i = splitter; i < p.cell_end[splitter]; ++i) {
+            const vector<int> &neighbors = graph.get_neighbors(p.elements[i]);
+            for(int j = 0; j < neighbors.size(); ++j) {
+                int w = neighbors[j];
+                if(counts[w] == 0)
+                    touched_vertices.push_back(w);
+                counts[w]++;
+            }
+        }
+        for(int i = 0; i < touched_vertices.size(); ++i) {
+            int cell = p.cell_of[touched_vertices[i]];
+            if(!cell_touched[cell] && p.cell_end[cell] - cell > 1) {
+                cell_touched[cell] = true;
+                touched_cells.push_back(cell);
+            }
+        }
+        // process cells in partition order, so the result does not depend on vertex numbers
+        sort(touched_cells.begin(), touched_cells.end());
+        for(int i = 0; i < touched_cells.size(); ++i) {
+            cell_touched[touched_cells[i]] = false;
+            split_cell(p, touched_cells[i], splitters, in_queue);
+        }
+        for(int i = 0; i < touched_vertices.size(); ++i)
+            counts[touched_vertices[i]] = 0;
+        touched_vertices.clear();
+        touched_cells.clear();
+    }
+    splitters.clear();
+}
+
+void AutomorphismFinder::individualize(Partition &p, int vertex, vector<int> &splitters) const
+{
+    int start = p.cell_of[vertex];
+    int end = p.cell_end[start];
+    if(end - start == 1)
+        return;
+    int other = p.elements[start];
+    int pos = p.position[vertex];
+    p.elements[start] = vertex;
+    p.elements[pos] = other;
+    p.position[vertex] = start;
+    p.position[other] = pos;
+
+    p.cell_end[start] = start + 1;
+    p.cell_end[start + 1] = end;
+    for(int i = start + 1; i < end; ++i)
+        p.cell_of[p.elements[i]] = start + 1;
+    p.num_cells++;
+    splitters.push_back(start);
+}
+
+int AutomorphismFinder::choose_target_cell(const Partition &p) const
+{
+    for(int i = 0; i < num_vertices; i = p.cell_end[i]) {
+        if(p.cell_end[i] - i > 1)
+            return i;
+    }
+    return -1;
+}
+
+bool AutomorphismFinder::same_cell_structure(const Partition &p1, const Partition &p2) const
+{
+    if(p1.num_cells != p2.num_cells)
+        return false;
+    for(int i = 0; i < num_vertices; i = p1.cell_end[i]) {
+        if(p2.cell_of[p2.elements[i]] != i || p2.cell_end[i] != p1.cell_end[i])
+            return false;
+        if(graph.get_color(p1.elements[i]) != graph.get_color(p2.elements[i]))
+            return false;
+    }
+    return true;
+}
+
+bool AutomorphismFinder::is_discrete(const Partition &p) const
+{
+    return p.num_cells == num_vertices;
+}
+
+bool AutomorphismFinder::search(Partition &p, int depth, vector<int> &automorphism)
+{
+    if(++search_nodes > max_search_nodes) {
+        limit_reached = true;
+        return false;
+    }
+    assert(depth < first_path.size());
+    if(!same_cell_structure(first_path[depth], p))
+        return false;
+
+    if(is_discrete(p)) {
+        const vector<int> &leaf = first_path.back().elements;
+        automorphism.resize(num_vertices);
+        for(int i = 0; i < num_vertices; ++i)
+            automorphism[leaf[i]] = p.elements[i];
+        return graph.is_automorphism(automorphism);
+    }
+
+    int cell = first_path_cells[depth];
+    assert(cell >= 0);
+    vector<int> splitters;
+    for(int i = cell; i < p.cell_end[cell]; ++i) {
+        Partition child = p;
+        individualize(child, p.elements[i], splitters);
+        refine(child, splitters);
+        if(search(child, depth + 1, automorphism))
+            return true;
+        if(limit_reached)
+            return false;
+    }
+    return false;
+}
+
+void AutomorphismFinder::find_generators(vector<vector<int> > &generators)
+{
+    generators.clear();
+    search_nodes = 0;
+    limit_reached = false;
+    first_path.clear();
+    first_path_cells.clear();
+    if(num_vertices == 0)
+        return;
+
+    int max_levels = max(1, MAX_FIRST_PATH_ENTRIES / (4 * num_vertices));
+    Partition p;
+    init_partition(p);
+    vector<int> splitters;
+    for(int i = 0; i < num_vertices; i = p.cell_end[i])
+        splitters.push_back(i);
+    refine(p, splitters);
+    for(;;) {
+        first_path.push_back(p);
+        int cell = choose_target_cell(p);
+        first_path_cells.push_back(cell);
+        if(cell == -1)
+            break;
+        if(first_path.size() > max_levels || ++search_nodes > max_search_nodes) {
+            limit_reached = true;
+            first_path.clear();
+            first_path_cells.clear();
+            return;
+        }
+        individualize(p, p.elements[cell], splitters);
+        refine(p, splitters);
+    }
+
+    // the found generators fix the first path above the current level,
+    // so their orbits can be used to skip equivalent branches
+    vector<int> orbit(num_vertices);
+    for(int i = 0; i < num_vertices; ++i)
+        orbit[i] = i;
+    for(int depth = first_path.size() - 2; depth >= 0; --depth) {
+        const Partition &node = first_path[depth];
+        int cell = first_path_cells[depth];
+        int first = node.elements[cell];
+        for(int i = cell + 1; i < node.cell_end[cell]; ++i) {
+            int vertex = node.elements[i];
+            if(find_orbit(orbit, vertex) == find_orbit(orbit, first))
+                continue;
+            Partition child = node;
+            individualize(child, vertex, splitters);
+            refine(child, splitters);
+            vector<int> automorphism;
+            if(search(child, depth + 1, automorphism)) {
+                generators.push_back(automorphism);
+                for(int v = 0; v < num_vertices; ++v) {
+                    int root1 = find_orbit(orbit, v);
+                    int root2 = find_orbit(orbit, automorphism[v]);
+                    if(root1 != root2)
+                        orbit[root1] = root2;
+                }
+            }
+            if(limit_reached)
+                break;
+        }
+        if(limit_reached)
+            break;
+    }
+    first_path.clear();
+    first_path_cells.clear();
+}
@@ -0,0 +1,81 @@
+#ifndef GRAPH_AUTOMORPHISM_H
+#define GRAPH_AUTOMORPHISM_H
+
+#include <vector>
+
+/// Undirected vertex colored graph.
+class ColoredGraph
+{
+    private:
+        std::vector<int> colors;
+        std::vector<std::vector<int> > adjacency;
+
+    public:
+        int add_vertex(int color);
+        void add_edge(int u, int v);
+        /// Sort adjacency lists and remove parallel edges, call before searching.
+        void finalize();
+
+        int get_num_vertices() const { return colors.size(); }
+        int get_color(int v) const { return colors[v]; }
+        const std::vector<int> &get_neighbors(int v) const { return adjacency[v]; }
+
+        /// Check that perm (vertex -> vertex) preserves colors and edges.
+        bool is_automorphism(const std::vector<int> &perm) const;
+};
+
+/// Computes generators of the automorphism group of a ColoredGraph.
+/**
+ * Individualization-refinement search: a first path of individualized
+ * vertices leads to a discrete leaf, other leaves are compared against it.
+ * Vertices in an orbit of the generators found so far are skipped.
+ * Every generator is checked to be an automorphism, so running into the
+ * search limit only loses generators, never soundness.
+ */
+class AutomorphismFinder
+{
+    private:
+        /// Ordered partition, cells are the ranges [start, cell_end[start]) of elements.
+        struct Partition
+        {
+            std::vector<int> elements;
+            std::vector<int> position;      ///< vertex -> index in elements
+            std::vector<int> cell_of;       ///< vertex -> start of its cell
+            std::vector<int> cell_end;      ///< cell start -> end of the cell
+            int num_cells;
+        };
+
+        const ColoredGraph &graph;
+        int num_vertices;
+        int max_search_nodes;
+        int search_nodes;
+        bool limit_reached;
+
+        std::vector<Partition> first_path;  ///< refined partitions along the first path
+        std::vector<int> first_path_cells;  ///< target cell at each level of the first path
+
+        std::vector<int> counts;            ///< refinement scratch space
+
+        void init_partition(Partition &p) const;
+        /// Refine p to an equitable partition using the given cells as splitters.
+        void refine(Partition &p, std::vector<int> &splitters);
+        int split_cell(Partition &p, int start, std::vector<int> &splitters,
+                std::vector<bool> &in_queue);
+        void individualize(Partition &p, int vertex, std::vector<int> &splitters) const;
+        int choose_target_cell(const Partition &p) const;
+        bool same_cell_structure(const Partition &p1, const Partition &p2) const;
+        bool is_discrete(const Partition &p) const;
+
+        bool search(Partition &p, int depth, std::vector<int> &automorphism);
+
+    public:
+        AutomorphismFinder(const ColoredGraph &g, int max_nodes);
+
+        /// Compute generators of the automorphism group (identity is never included).
+        void find_generators(std::vector<std::vector<int> > &generators);
+
+        bool reached_limit() const { return limit_reached; }
+        int get_search_nodes() const { return search_nodes; }
+};
+
+#endif
@@ -1,10 +1,12 @@
 #include "heuristic.h"
+#include "instrumentation.h"
 #include "operator.h"
 #include "plannerParameters.h"
 
 using namespace std;
 
-Heuristic::Heuristic()
+Heuristic::Heuristic(const SearchContext &context) :
+    context(context)
 {
     heuristic = NOT_INITIALIZED;
     num_computations = 0;
@@ -40,10 +42,10 @@ void Heuristic::set_preferred(const Operator *newOp, OpenListMode mode)
         assert(false);
         break;
     }
-    if(newOp->get_name().compare("wait") == 0) {
+    if(newOp->get_kind() == wait_op) {
         const ScheduledOperator *s_newOp = dynamic_cast<const ScheduledOperator*>(newOp);
         assert(s_newOp);
-        set_waiting_time(min(waiting_time, s_newOp->time_increment));
+        set_waiting_time(min(waiting_time, s_newOp->time));
         return;
     }
     for(int i = 0; i < pref_ops->size(); i++) {
@@ -67,7 +69,7 @@ void Heuristic::clearPreferredOperators()
 
 double Heuristic::evaluate(const TimeStampedState &state)
 {
-    
+    INSTRUMENT_PHASE(context.instrumentation, phase_heuristic_evaluation);
     if(heuristic == NOT_INITIALIZED)
         initialize();
     
@@ -82,6 +84,7 @@ double Heuristic::evaluate(const TimeStampedState &state)
         // selecting the first ones before it is clear that all goals
         // can be reached.
         clearPreferredOperators();
+        INSTRUMENT_COUNT(context.instrumentation, phase_heuristic_evaluation, 1);
     }
     
     
@@ -35,6 +35,7 @@ class Heuristic
     unsigned long num_computations;     ///< For stats, how often was compute_heuristic called
     
  protected:
+    const SearchContext &context;       ///< task and parameters the heuristic is computed for
     unsigned long num_cache_hits;     ///< For stats, how often was compute_heuristic called again for a same state
     enum
     {
@@ -55,7 +56,7 @@ class Heuristic
     std::vector<const Operator *> preferred_operators_concurrent;
     inline void set_waiting_time(double time_increment);
     void set_preferred(const Operator *op, OpenListMode mode);
-    Heuristic();
+    Heuristic(const SearchContext &context);
     virtual ~Heuristic();
     
     double evaluate(const TimeStampedState &state);
@@ -67,8 +68,14 @@ class Heuristic
     {
         return true;
     }
+    /// Forget the values cached for states that will not be evaluated again.
+    virtual void clear_cache()
+    {
+    }
     unsigned long get_num_computations() const { return num_computations; }
     unsigned long get_num_cache_hits() const { return num_cache_hits; }
+    /// The context the heuristic was created for.
+    const SearchContext &get_context() const { return context; }
 };
 
 inline void Heuristic::set_waiting_time(double time_increment)
@@ -0,0 +1,178 @@
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/// Started instrumentations that were not written yet, they are written
+/// when they are destroyed or the process exits.
+static vector<Instrumentation *> started_instrumentations;
+
+static const char *phase_names[NUM_INSTRUMENTATION_PHASES] = {
+    "successor_generation",
+    "applicability_check",
+    "consistency_check",
+    "state_construction",
+    "axiom_evaluation",
+    "heuristic_evaluation",
+    "stn_solving",
+    "closed_list",
+    "open_list"
+};
+
+/// What the items of a phase count, NULL if the phase counts none.
+static const char *item_names[NUM_INSTRUMENTATION_PHASES] = {
+    "operators",
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    "dead_ends",
+    "time_points",
+    "hits",
+    NULL
+};
+
+/// Number of SIGUSR1 seen, every instrumentation writes one snapshot per signal.
+static volatile sig_atomic_t snapshot_requests = 0;
+/// Whether the signal handler and the exit hook are installed.
+static bool hooks_installed = false;
+
+static void request_snapshot(int)
+{
+    snapshot_requests = snapshot_requests + 1;
+}
+
+static void write_at_exit()
+{
+    for(int i = 0; i < started_instrumentations.size(); i++)
+        started_instrumentations[i]->write("exit");
+    started_instrumentations.clear();
+}
+
+static double seconds_between(const timespec &begin, const timespec &end)
+{
+    return (end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) / 1e9;
+}
+
+Instrumentation::Instrumentation() :
+    started(false), seen_snapshot_requests(0)
+{
+    memset(records, 0, sizeof(records));
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+}
+
+Instrumentation::~Instrumentation()
+{
+    vector<Instrumentation *>::iterator pos =
+        find(started_instrumentations.begin(), started_instrumentations.end(), this);
+    if(pos != started_instrumentations.end()) {
+        write("exit");
+        started_instrumentations.erase(pos);
+    }
+}
+
+void Instrumentation::start(const string &name)
+{
+    file_name = name;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    if(started)
+        return;
+    started = true;
+    seen_snapshot_requests = snapshot_requests;
+    started_instrumentations.push_back(this);
+    if(hooks_installed)
+        return;
+    hooks_installed = true;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = request_snapshot;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, 0);
+    atexit(write_at_exit);
+}
+
+void Instrumentation::record(instrumentation_phase phase, const timespec &begin,
+        const timespec &end)
+{
+    PhaseRecord &rec = records[phase];
+    double seconds = seconds_between(begin, end);
+    rec.calls++;
+    rec.seconds += seconds;
+    if(seconds > rec.max_seconds)
+        rec.max_seconds = seconds;
+
+    // bucket b holds [2^b, 2^(b+1)) ns, bucket 0 everything below 2 ns
+    int bucket = 0;
+    double ns = seconds * 1e9;
+    if(ns >= 2.0) {
+        frexp(ns, &bucket);
+        bucket = min(bucket - 1, NUM_BUCKETS - 1);
+    }
+    rec.histogram[bucket]++;
+}
+
+void Instrumentation::poll()
+{
+    if(seen_snapshot_requests == snapshot_requests)
+        return;
+    seen_snapshot_requests = snapshot_requests;
+    if(write("signal"))
+        cout << "Wrote instrumentation snapshot to " << file_name << "." << endl;
+}
+
+bool Instrumentation::write(const char *reason) const
+{
+    if(!started)
+        return false;
+    // write a temporary file and rename it, so that readers never see a
+    // partial snapshot
+    string temp_name = file_name + ".tmp";
+    FILE *file = fopen(temp_name.c_str(), "w");
+    if(!file) {
+        cerr << "Could not write instrumentation file " << temp_name << "." << endl;
+        return false;
+    }
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    fprintf(file, "{\"reason\": \"%s\", \"time\": %.6f, \"phases\": {",
+            reason, seconds_between(start_time, now));
+    for(int i = 0; i < NUM_INSTRUMENTATION_PHASES; i++) {
+        const PhaseRecord &rec = records[i];
+        fprintf(file, "%s\n  \"%s\": {\"calls\": %lu, \"seconds\": %.9f, \"max_seconds\": %.9f",
+                i == 0 ? "" : ",", phase_names[i], rec.calls, rec.seconds, rec.max_seconds);
+        if(item_names[i])
+            fprintf(file, ", \"%s\": %lu", item_names[i], rec.items);
+        fprintf(file, ", \"histogram\": [");
+        bool first = true;
+        for(int bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+            if(rec.histogram[bucket] == 0)
+                continue;
+            fprintf(file, "%s{\"min_ns\": %.0f, \"calls\": %lu}", first ? "" : ", ",
+                    bucket == 0 ? 0.0 : ldexp(1.0, bucket), rec.histogram[bucket]);
+            first = false;
+        }
+        fprintf(file, "]}");
+    }
+    fprintf(file, "\n}}\n");
+
+    bool ok = !ferror(file);
+    if(fclose(file) != 0)
+        ok = false;
+    if(!ok || rename(temp_name.c_str(), file_name.c_str()) != 0) {
+        cerr << "Could not write instrumentation file " << file_name << "." << endl;
+        remove(temp_name.c_str());
+        return false;
+    }
+    return true;
+}
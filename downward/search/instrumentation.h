@@ -0,0 +1,128 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include "globals.h"
+
+#include <string>
+
+#include <time.h>
+
+/// Phases of the search that are timed by the instrumentation.
+enum instrumentation_phase {
+    phase_successor_generation,
+    phase_applicability_check,
+    phase_consistency_check,
+    phase_state_construction,
+    phase_axiom_evaluation,
+    phase_heuristic_evaluation,
+    phase_stn_solving,
+    phase_closed_list,
+    phase_open_list,
+    NUM_INSTRUMENTATION_PHASES
+};
+
+/// Timers, counters and histograms of the search phases.
+/**
+ * Only compiled in if TFD_INSTRUMENTATION is defined (see the Makefile),
+ * otherwise the INSTRUMENT_* macros expand to nothing and the search
+ * does not pay for them.
+ *
+ * Each phase records the number of calls, their total and maximal time
+ * on the monotonic clock, a histogram of the call times with power of
+ * two buckets and, for some phases, a count of items (generated
+ * operators, dead ends, ...). Times are inclusive: a phase that runs
+ * within another one, like the axioms within the state construction or
+ * the state construction within the consistency check, is counted in
+ * both.
+ *
+ * Every SearchContext has records of its own. They are written as one
+ * JSON object to the file of option I when the process exits (or the
+ * records are destroyed) and, as a snapshot, whenever the search of the
+ * context sees a SIGUSR1 (the file is replaced atomically):
+ *
+ *   {"reason": "exit" | "signal", "time": s, "phases": {
+ *     "successor_generation": {"calls": n, "seconds": s, "max_seconds": s,
+ *       "operators": n, "histogram": [{"min_ns": t, "calls": n}, ...]},
+ *     ...}}
+ *
+ * time is the number of seconds since the recording started. Only the
+ * non-empty buckets of a histogram are listed, a bucket holds the calls
+ * that took from min_ns up to twice that.
+ */
+class Instrumentation
+{
+    public:
+        static const int NUM_BUCKETS = 40;
+    private:
+        struct PhaseRecord
+        {
+            unsigned long calls;
+            unsigned long items;
+            double seconds;
+            double max_seconds;
+            unsigned long histogram[NUM_BUCKETS];
+        };
+
+        PhaseRecord records[NUM_INSTRUMENTATION_PHASES];
+        std::string file_name;
+        timespec start_time;
+        bool started;
+        int seen_snapshot_requests;     ///< SIGUSR1 count at the last snapshot
+    public:
+        Instrumentation();
+        ~Instrumentation();
+
+        /// Start recording, install the signal handler and write file_name at exit.
+        void start(const std::string &file_name);
+
+        void record(instrumentation_phase phase, const timespec &begin, const timespec &end);
+        void count(instrumentation_phase phase, unsigned long items)
+        {
+            records[phase].items += items;
+        }
+
+        /// Write a snapshot if a signal asked for one, cheap otherwise.
+        void poll();
+        /// Write the records to the file given to start().
+        bool write(const char *reason) const;
+};
+
+/// Records the time from its construction to its destruction for a phase.
+class PhaseTimer
+{
+    Instrumentation &instrumentation;
+    instrumentation_phase phase;
+    timespec begin;
+
+    PhaseTimer(const PhaseTimer &);
+    PhaseTimer &operator=(const PhaseTimer &);
+    public:
+        PhaseTimer(Instrumentation &i, instrumentation_phase p) :
+            instrumentation(i), phase(p)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &begin);
+        }
+        ~PhaseTimer()
+        {
+            timespec end;
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            instrumentation.record(phase, begin, end);
+        }
+};
+
+// The macros take the Instrumentation of the search context as first
+// argument, it is not evaluated if the instrumentation is compiled out.
+#ifdef TFD_INSTRUMENTATION
+/// Time the rest of the enclosing scope as phase.
+#define INSTRUMENT_PHASE(instrumentation, phase) PhaseTimer phase_timer(instrumentation, phase)
+/// Add items to the item count of phase.
+#define INSTRUMENT_COUNT(instrumentation, phase, items) (instrumentation).count(phase, items)
+/// Write a snapshot if one was requested by a signal.
+#define INSTRUMENT_POLL(instrumentation) (instrumentation).poll()
+#else
+#define INSTRUMENT_PHASE(instrumentation, phase) ((void) 0)
+#define INSTRUMENT_COUNT(instrumentation, phase, items) ((void) 0)
+#define INSTRUMENT_POLL(instrumentation) ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,16 @@
+#include "planner.h"
+#include "task_reader.h"
+
+#include <iostream>
+
+using namespace std;
+
+/// Search on the preprocessed task ("output" file) from stdin.
+/**
+ * tfd (tfd.cc) runs preprocessing and search in one process instead.
+ */
+int main(int argc, char **argv)
+{
+    int input_fd = 0;   // stdin, mapped if the task is a regular file
+    return run_planner(argc, argv, new TextTaskReader(cin, input_fd));
+}
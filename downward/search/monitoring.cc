@@ -15,16 +15,6 @@
 
 using namespace std;
 
-MonitorEngine* MonitorEngine::instance = 0;
-
-MonitorEngine* MonitorEngine::getInstance()
-{
-    if (instance == 0)
-        instance = new MonitorEngine();
-
-    return instance;
-}
-
 void MonitorEngine::readPlanFromFile(const string& filename, vector<string>& plan)
 {
     ifstream fin(filename.c_str(), ifstream::in);
@@ -37,18 +27,19 @@ void MonitorEngine::readPlanFromFile(const string& filename, vector<string>& pla
     fin.close();
 }
 
-bool MonitorEngine::validatePlan(const string & filename)
+bool MonitorEngine::validatePlan(const SearchContext &context, const string & filename)
 {
     vector<string> plan;
     MonitorEngine::readPlanFromFile(filename, plan);
 
-    MonitorEngine* mon = MonitorEngine::getInstance();
-    bool monitor = mon->validatePlan(plan);
+    MonitorEngine mon(context);
+    bool monitor = mon.validatePlan(plan);
     return monitor;
 }
 
 
-MonitorEngine::MonitorEngine()
+MonitorEngine::MonitorEngine(const SearchContext &context) :
+    context(context)
 {
 }
 
@@ -101,10 +92,10 @@ bool MonitorEngine::validatePlan(vector<string>& plan)
 
         // lookup op
         bool opFound = false;
-        for (unsigned int j = 0; j < g_operators.size(); j++) {
-            if (g_operators[j].get_name() == name) {
+        for (unsigned int j = 0; j < context.task.operators.size(); j++) {
+            if (context.task.operators[j].get_name() == name) {
                 // forward state? FIXME no state here, determined by next step
-                p.push_back(PlanStep(start,duration,&g_operators[j], NULL));
+                p.push_back(PlanStep(start,duration,&context.task.operators[j], NULL));
                 opFound = true;
                 break;
             }
@@ -144,12 +135,12 @@ bool MonitorEngine::validatePlan(vector<string>& plan)
 bool MonitorEngine::validatePlan(std::vector<PlanStep> & plan)
 {
     if(plan.empty()) {
-        return g_initial_state->satisfies(g_goal);
+        return context.task.initial_state->satisfies(context.task.goal);
     }
 
     deque< FullPlanTrace > currentTraces;
     // seed with init.
-    currentTraces.push_back(FullPlanTrace(*g_initial_state));
+    currentTraces.push_back(FullPlanTrace(*context.task.initial_state));
 
     for(int i = 0; i < plan.size(); i++) {
         //printf("CURRENT STATES ARE:\n");
@@ -165,7 +156,7 @@ bool MonitorEngine::validatePlan(std::vector<PlanStep> & plan)
             // if applicable apply the operator to every state in the queue
             FullPlanTrace curTrace = *it;
 
-            if(g_parameters.monitoring_verify_timestamps) {
+            if(context.parameters.monitoring_verify_timestamps) {
                 // this plan trace should now be at the start time of plan[i]
                 double dt = fabs(plan[i].start_time - curTrace.lastTimestamp());
                 if(dt > EPS_TIME) {     // timestamp doesn't match -> stop this trace
@@ -220,8 +211,8 @@ bool MonitorEngine::validatePlan(std::vector<PlanStep> & plan)
     if(best != NULL) {
         stringstream os;
         best->outputPlan(os);
-        if(!g_parameters.plan_name.empty()) {
-            string monitorPlanName = g_parameters.plan_name + ".monitored";
+        if(!context.parameters.plan_name.empty()) {
+            string monitorPlanName = context.parameters.plan_name + ".monitored";
             ofstream of(monitorPlanName.c_str());
             if(!of.good()) {
             } else {
@@ -237,19 +228,19 @@ bool MonitorEngine::validatePlan(std::vector<PlanStep> & plan)
 // TODO check this and use as verify-timestamps version if we can produce the plan for output
 bool MonitorEngine::validatePlanOld(const vector<PlanStep>& plan)
 {
-    TimeStampedState current = *g_initial_state;
+    TimeStampedState current = *context.task.initial_state;
 
     for (int i = 0; i < plan.size(); i++) {
         while (plan[i].start_time > current.timestamp) {
             double curren_time = current.timestamp;
             if (plan[i].start_time - 2 * EPS_TIME - EPSILON
                     <= current.timestamp) {
-                current.timestamp += EPS_TIME;
+                current.shift_time(EPS_TIME);
             } else {
                 current = current.let_time_pass();
             }
             if (double_equals(current.timestamp, curren_time)) {
-                current.timestamp += EPS_TIME;
+                current.shift_time(EPS_TIME);
             }
         }
         cout << "Current time_stamp: " << current.timestamp << endl;
@@ -267,7 +258,7 @@ bool MonitorEngine::validatePlanOld(const vector<PlanStep>& plan)
     while (!current.operators.empty())
         current = current.let_time_pass();
 
-    return current.satisfies(g_goal);
+    return current.satisfies(context.task.goal);
 }
 
 
@@ -322,7 +313,7 @@ bool FullPlanTrace::satisfiesGoal() const
     if(plan.empty())
         return false;
 
-    return plan.back().state.satisfies(g_goal);
+    return plan.back().state.satisfies(plan.back().state.get_task().goal);
 }
 
 double FullPlanTrace::lastTimestamp() const
@@ -48,7 +48,7 @@ class FullPlanTrace
        */
       FullPlanTrace letTimePass() const;
 
-      /// \returns true, if the last state satisfies g_goal.
+      /// \returns true, if the last state satisfies the goal of its task.
       bool satisfiesGoal() const;
 
       /// \returns the timestamp of the last state in the trace
@@ -71,18 +71,17 @@ class FullPlanTrace
 class MonitorEngine
 {
     protected:
-        MonitorEngine();
-        static MonitorEngine* instance;
+        const SearchContext &context;
 
         static void readPlanFromFile(const string & filename, vector<string> & plan);
 
     public:
+        /// Validates plans on the task of context.
+        MonitorEngine(const SearchContext &context);
         ~MonitorEngine();
 
-        static MonitorEngine* getInstance();
-
         /// Static convenience function to validate the plan from this file.
-        static bool validatePlan(const string & filename);
+        static bool validatePlan(const SearchContext &context, const string & filename);
 
         bool validatePlan(std::vector<std::string> & plan);
 
@@ -13,7 +13,7 @@ void NoHeuristic::initialize()
 
 double NoHeuristic::compute_heuristic(const TimeStampedState &state)
 {
-    if(state.satisfies(g_goal) && state.scheduled_effects.empty())
+    if(state.satisfies(context.task.goal) && state.scheduled_effects.empty())
         return 0.0;
 
     return (state.timestamp + 1.0);
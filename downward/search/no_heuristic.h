@@ -14,7 +14,7 @@ class NoHeuristic : public Heuristic
         virtual void initialize();
         virtual double compute_heuristic(const TimeStampedState &TimeStampedState);
     public:
-        NoHeuristic() {}
+        NoHeuristic(const SearchContext &context) : Heuristic(context) {}
         ~NoHeuristic() {}
         virtual bool dead_ends_are_reliable() {
             return true;
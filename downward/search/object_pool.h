@@ -0,0 +1,211 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <vector>
+
+/// Pool for objects that live as long as a search.
+/**
+ * Objects are constructed in blocks of slots that are allocated at once.
+ * Released objects are destroyed and their slots reused by the next
+ * create(). clear() destroys all objects of the pool in one go and keeps
+ * the blocks for reuse, only the destructor frees them.
+ */
+template<class T>
+class ObjectPool
+{
+    static const int BLOCK_SIZE = 64;
+
+    std::vector<T *> blocks;
+    int used_slots;                 ///< slots handed out from the blocks
+    std::vector<T *> free_slots;    ///< released slots among the used ones
+
+    unsigned long num_created;
+    unsigned long num_reused;
+    int peak_live;
+
+    ObjectPool(const ObjectPool &);
+    ObjectPool &operator=(const ObjectPool &);
+
+    T *slot(int index) const
+    {
+        return blocks[index / BLOCK_SIZE] + index % BLOCK_SIZE;
+    }
+
+    T *allocate_slot()
+    {
+        if(!free_slots.empty()) {
+            T *result = free_slots.back();
+            free_slots.pop_back();
+            num_reused++;
+            return result;
+        }
+        if(used_slots == blocks.size() * BLOCK_SIZE)
+            blocks.push_back(static_cast<T *>(::operator new(BLOCK_SIZE * sizeof(T))));
+        return slot(used_slots++);
+    }
+    public:
+        ObjectPool() :
+            used_slots(0), num_created(0), num_reused(0), peak_live(0)
+        {
+        }
+        ~ObjectPool()
+        {
+            clear();
+            for(int i = 0; i < blocks.size(); i++)
+                ::operator delete(blocks[i]);
+        }
+
+        /// Construct a copy of value in the pool.
+        T *create(const T &value)
+        {
+            T *result = new(allocate_slot()) T(value);
+            num_created++;
+            peak_live = std::max(peak_live, live());
+            return result;
+        }
+
+        /// Destroy an object of this pool and reuse its slot.
+        void release(T *object)
+        {
+            object->~T();
+            free_slots.push_back(object);
+        }
+
+        /// Destroy all objects of this pool.
+        void clear()
+        {
+            std::sort(free_slots.begin(), free_slots.end(), std::less<T *>());
+            for(int i = 0; i < used_slots; i++) {
+                if(!std::binary_search(free_slots.begin(), free_slots.end(), slot(i),
+                            std::less<T *>()))
+                    slot(i)->~T();
+            }
+            free_slots.clear();
+            used_slots = 0;
+        }
+
+        /// Number of objects currently in the pool.
+        int live() const
+        {
+            return used_slots - free_slots.size();
+        }
+
+        void dump_statistics(const char *name) const
+        {
+            std::cout << name << ": " << num_created << " created, "
+                << num_reused << " in reused slots, " << live() << " live (peak "
+                << peak_live << "), " << blocks.size() << " block(s) of "
+                << BLOCK_SIZE * sizeof(T) << " bytes" << std::endl;
+        }
+};
+
+/// Storage for NULL-terminated sequences of pointers.
+/**
+ * For data that is created in large numbers and short-lived, like the
+ * operators of open list entries. A sequence is referred to by its index,
+ * so whatever refers to it stays cheap to copy. Released sequences are
+ * kept in free lists by their length and their ranges reused by the next
+ * sequence of the same length, clear() releases all sequences at once.
+ */
+template<class T>
+class PointerArena
+{
+    std::vector<T *> items;
+    std::vector<std::vector<int> > free_ranges;   ///< released indices by sequence length
+
+    unsigned long num_sequences;
+    unsigned long num_reused;
+    std::size_t peak_size;
+
+    PointerArena(const PointerArena &);
+    PointerArena &operator=(const PointerArena &);
+
+    /// Index of a released range for a sequence of length, -1 if none.
+    int reuse_range(int length)
+    {
+        num_sequences++;
+        if(length >= free_ranges.size() || free_ranges[length].empty())
+            return -1;
+        int index = free_ranges[length].back();
+        free_ranges[length].pop_back();
+        num_reused++;
+        return index;
+    }
+    public:
+        PointerArena() :
+            num_sequences(0), num_reused(0), peak_size(0)
+        {
+        }
+
+        /// Store a sequence of a single pointer, return its index.
+        int add(T *item)
+        {
+            int index = reuse_range(1);
+            if(index != -1) {
+                items[index] = item;
+                return index;
+            }
+            index = items.size();
+            items.push_back(item);
+            items.push_back(NULL);
+            return index;
+        }
+
+        /// Store a sequence, return its index.
+        int add(const std::vector<T *> &sequence)
+        {
+            int index = reuse_range(sequence.size());
+            if(index != -1) {
+                std::copy(sequence.begin(), sequence.end(), items.begin() + index);
+                return index;
+            }
+            index = items.size();
+            items.insert(items.end(), sequence.begin(), sequence.end());
+            items.push_back(NULL);
+            return index;
+        }
+
+        /// Copy the sequence stored at index to sequence.
+        void get(int index, std::vector<T *> &sequence) const
+        {
+            sequence.clear();
+            for(int i = index; items[i] != NULL; i++)
+                sequence.push_back(items[i]);
+        }
+
+        /// Release the sequence stored at index, its range is reused.
+        void release(int index)
+        {
+            int length = 0;
+            while(items[index + length] != NULL)
+                length++;
+            if(length >= free_ranges.size())
+                free_ranges.resize(length + 1);
+            free_ranges[length].push_back(index);
+        }
+
+        /// Release all sequences, keep the memory for reuse.
+        void clear()
+        {
+            peak_size = std::max(peak_size, items.size());
+            items.clear();
+            for(int i = 0; i < free_ranges.size(); i++)
+                free_ranges[i].clear();
+        }
+
+        void dump_statistics(const char *name) const
+        {
+            std::cout << name << ": " << num_sequences << " sequence(s) stored, "
+                << num_reused << " in reused ranges, "
+                << items.size() << " pointers stored (peak "
+                << std::max(peak_size, items.size()) << "), "
+                << items.capacity() * sizeof(T *) << " bytes reserved" << std::endl;
+        }
+};
+
+#endif
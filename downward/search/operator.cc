@@ -1,23 +1,25 @@
 #include "globals.h"
+#include "instrumentation.h"
 #include "operator.h"
 #include "plannerParameters.h"
+#include "task_reader.h"
 
 #include <iostream>
 using namespace std;
 
-Prevail::Prevail(istream &in)
+Prevail::Prevail(TaskReader &in)
 {
     in >> var >> prev;
 }
 
 bool Prevail::is_applicable(const TimeStampedState &state) const
 {
-    assert(var >= 0 && var < g_variable_name.size());
-    assert(prev >= 0 && prev < g_variable_domain[var]);
+    assert(var >= 0 && var < state.get_task().variable_name.size());
+    assert(prev >= 0 && prev < state.get_task().variable_domain[var]);
     return double_equals(state[var], prev);
 }
 
-PrePost::PrePost(istream &in)
+PrePost::PrePost(TaskReader &in, const Task &task)
 {
     int cond_count;
     in >> cond_count;
@@ -30,7 +32,7 @@ PrePost::PrePost(istream &in)
     for(int i = 0; i < cond_count; i++)
         cond_end.push_back(Prevail(in));
     in >> var;
-    if(is_functional(var)) {
+    if(task.is_functional(var)) {
         in >> fop >> var_post;
         // HACK: just use some arbitrary values for pre and post
         // s.t. they do not remain uninitialized
@@ -46,16 +48,16 @@ PrePost::PrePost(istream &in)
 
 bool PrePost::is_applicable(const TimeStampedState &state) const
 {
-    assert(var >= 0 && var < g_variable_name.size());
-    assert(pre == -1 || (pre >= 0 && pre < g_variable_domain[var]));
+    assert(var >= 0 && var < state.get_task().variable_name.size());
+    assert(pre == -1 || (pre >= 0 && pre < state.get_task().variable_domain[var]));
     return pre == -1 || (double_equals(state[var], pre));
 }
 
-Operator::Operator(istream &in)
+Operator::Operator(TaskReader &in, int op_id, Task &task) :
+    id(op_id), kind(regular_op)
 {
     check_magic(in, "begin_operator");
-    in >> ws;
-    getline(in, name);
+    name = in.read_line();
     int count;
     binary_op bop;
     in >> bop >> duration_var;
@@ -76,20 +78,24 @@ Operator::Operator(istream &in)
         prevail_end.push_back(Prevail(in));
     in >> count; //number of pre_post_start conditions (symbolical)
     for(int i = 0; i < count; i++)
-        pre_post_start.push_back(PrePost(in));
+        pre_post_start.push_back(PrePost(in, task));
     in >> count; //number of pre_post_end conditions (symbolical)
     for(int i = 0; i < count; i++)
-        pre_post_end.push_back(PrePost(in));
+        pre_post_end.push_back(PrePost(in, task));
     in >> count; //number of pre_post_start conditions (functional)
     for(int i = 0; i < count; i++)
-        pre_post_start.push_back(PrePost(in));
+        pre_post_start.push_back(PrePost(in, task));
     in >> count; //number of pre_post_end conditions (functional)
     for(int i = 0; i < count; i++)
-        pre_post_end.push_back(PrePost(in));
+        pre_post_end.push_back(PrePost(in, task));
     check_magic(in, "end_operator");
+
+    for(int i = 0; i < pre_post_end.size(); i++)
+        end_effects.push_back(task.effect_pool->intern(pre_post_end[i]));
 }
 
-Operator::Operator(bool uses_concrete_time_information)
+Operator::Operator(bool uses_concrete_time_information) :
+    id(-1)
 {
     prevail_start   = vector<Prevail>();
     prevail_overall = vector<Prevail>();
@@ -99,57 +105,61 @@ Operator::Operator(bool uses_concrete_time_information)
     if(!uses_concrete_time_information) {
         name = "let_time_pass";
         duration_var = -1;
+        kind = let_time_pass_op;
     } else {
         name = "wait";
         duration_var = -2;
+        kind = wait_op;
     }
 }
 
-void Prevail::dump() const
+void Prevail::dump(const Task &task) const
 {
-    cout << g_variable_name[var] << ": " << prev << endl;
+    cout << task.variable_name[var] << ": " << prev << endl;
 }
 
-void PrePost::dump() const
+void PrePost::dump(const Task &task) const
 {
-    cout << "var: " << g_variable_name[var] << ", pre: " << pre
+    cout << "var: " << task.variable_name[var] << ", pre: " << pre
         << " , var_post: " << var_post << ", post: " << post << endl;
 }
 
-void Operator::dump() const
+void Operator::dump(const Task &task) const
 {
     cout << name << endl;
     cout << "Prevails start:" << endl;
     for(int i = 0; i < prevail_start.size(); ++i) {
-        prevail_start[i].dump();
+        prevail_start[i].dump(task);
     }
     cout << "Prevails overall:" << endl;
     for(int i = 0; i < prevail_overall.size(); ++i) {
-        prevail_overall[i].dump();
+        prevail_overall[i].dump(task);
     }
     cout << "Prevails end:" << endl;
     for(int i = 0; i < prevail_end.size(); ++i) {
-        prevail_end[i].dump();
+        prevail_end[i].dump(task);
     }
     cout << "Preposts start:" << endl;
     for(int i = 0; i < pre_post_start.size(); ++i) {
-        pre_post_start[i].dump();
+        pre_post_start[i].dump(task);
     }
     cout << "Preposts end:" << endl;
     for(int i = 0; i < pre_post_end.size(); ++i) {
-        pre_post_end[i].dump();
+        pre_post_end[i].dump(task);
     }
     cout << endl;
 }
 
 bool Operator::is_applicable(const TimeStampedState & state,
-        TimedSymbolicStates* timedSymbolicStates) const
+        TimedSymbolicStates* timedSymbolicStates, bool start_conditions_hold) const
 {
+    const SearchContext &context = state.get_context();
+    INSTRUMENT_PHASE(context.instrumentation, phase_applicability_check);
     double duration = get_duration(&state);
 
-    if(g_parameters.epsilonize_internally) {
+    if(context.parameters.epsilonize_internally) {
     for(unsigned int i = 0; i < state.operators.size(); ++i) {
-        double time_increment = state.operators[i].time_increment;
+        double time_increment = state.time_increment(state.operators[i]);
             if(double_equals(time_increment,EPS_TIME)) {
                 return false;
             }
@@ -160,19 +170,21 @@ bool Operator::is_applicable(const TimeStampedState & state,
         return false;
 
 
-    for(int i = 0; i < prevail_start.size(); i++)
-        if(!prevail_start[i].is_applicable(state))
-            return false;
-    for(int i = 0; i < pre_post_start.size(); i++)
-        if(!pre_post_start[i].is_applicable(state))
-            return false;
+    if(!start_conditions_hold) {
+        for(int i = 0; i < prevail_start.size(); i++)
+            if(!prevail_start[i].is_applicable(state))
+                return false;
+        for(int i = 0; i < pre_post_start.size(); i++)
+            if(!pre_post_start[i].is_applicable(state))
+                return false;
+    }
 
     // There may be no simultaneous applications of two instances of the
     // same ground operator (for technical reasons, to simplify the task
     // of keeping track of durations committed to at the start of the
     // operator application)
     for(int i = 0; i < state.operators.size(); i++)
-        if(state.operators[i].get_name() == get_name())
+        if(state.operators[i].id == id)
             return false;
 
     return TimeStampedState(state, *this).is_consistent_when_progressed(timedSymbolicStates);
@@ -180,7 +192,7 @@ bool Operator::is_applicable(const TimeStampedState & state,
 
 bool Operator::isDisabledBy(const Operator* other) const
 {
-    if(name.compare(other->name) == 0)
+    if(kind == other->kind && id == other->id)
         return false;
     if(deletesPrecond(prevail_start, other->pre_post_start))
         return true;
@@ -212,7 +224,7 @@ bool Operator::isDisabledBy(const Operator* other) const
 
 bool Operator::enables(const Operator* other) const
 {
-    if(name.compare(other->name) == 0)
+    if(kind == other->kind && id == other->id)
         return false;
     if(achievesPrecond(pre_post_start, other->prevail_start))
         return true;
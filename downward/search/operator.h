@@ -11,6 +11,14 @@
 #include "globals.h"
 #include "state.h"
 
+/// What an operator of the search stands for.
+enum operator_kind
+{
+    regular_op,         ///< an operator of the task (in Task::operators)
+    let_time_pass_op,   ///< let time pass until the next happening
+    wait_op             ///< wait for a fixed time
+};
+
 class Operator
 {
         vector<Prevail> prevail_start; // var, val
@@ -18,8 +26,11 @@ class Operator
         vector<Prevail> prevail_end; // var, val
         vector<PrePost> pre_post_start; // var, old-val, new-val
         vector<PrePost> pre_post_end; // var, old-val, new-val
+        vector<const PrePost *> end_effects; // pre_post_end interned in the effect_pool of the task
         int duration_var;
         string name;
+        int id;             ///< index in Task::operators, -1 if not regular
+        operator_kind kind;
 
         bool deletesPrecond(const vector<Prevail>& conds,
                 const vector<PrePost>& effects) const;
@@ -33,9 +44,9 @@ class Operator
                 const vector<PrePost>& effects) const;
 
     public:
-        Operator(std::istream &in);
+        Operator(TaskReader &in, int op_id, Task &task);
         explicit Operator(bool uses_concrete_time_information);
-        void dump() const;
+        void dump(const Task &task) const;
         const vector<Prevail> &get_prevail_start() const {
             return prevail_start;
         }
@@ -51,12 +62,22 @@ class Operator
         const vector<PrePost> &get_pre_post_end() const {
             return pre_post_end;
         }
+        /// The effects of pre_post_end as they are scheduled in states.
+        const vector<const PrePost *> &get_end_effects() const {
+            return end_effects;
+        }
         const int &get_duration_var() const {
             return duration_var;
         }
         const string &get_name() const {
             return name;
         }
+        int get_id() const {
+            return id;
+        }
+        operator_kind get_kind() const {
+            return kind;
+        }
 
         bool operator<(const Operator &other) const;
 
@@ -69,9 +90,12 @@ class Operator
         /// Compute applicability of this operator in state.
         /**
          * \param [out] timedSymbolicStates if not NULL the timedSymbolicStates will be computed
+         * \param start_conditions_hold skip checking prevail_start and pre_post_start,
+         *        e.g. for operators from a successor generator that checks them
          */
         bool is_applicable(const TimeStampedState & state,
-            TimedSymbolicStates* timedSymbolicStates = NULL) const;
+            TimedSymbolicStates* timedSymbolicStates = NULL,
+            bool start_conditions_hold = false) const;
 
         bool isDisabledBy(const Operator* other) const;
 
@@ -85,14 +109,15 @@ class Operator
 class ScheduledOperator : public Operator
 {
     public:
-        double time_increment;
-        ScheduledOperator(double t, const Operator& op) : Operator(op), time_increment(t)
+        /// Absolute end time point of a running operator, the time to wait for a wait operator.
+        double time;
+        ScheduledOperator(double t, const Operator& op) : Operator(op), time(t)
         {
         }
-        ScheduledOperator(double t) : Operator(true), time_increment(t)
+        ScheduledOperator(double t) : Operator(true), time(t)
         {
-            if (time_increment >= HUGE_VAL) {
-                printf("WARNING: Created scheduled operator with time_increment %f\n", t);
+            if (time >= HUGE_VAL) {
+                printf("WARNING: Created scheduled operator with time %f\n", t);
             }
         }
 };
@@ -53,7 +53,8 @@ Plan PartialOrderLifter::createAndSolveSTN() {
         variable_names.push_back(instant_plan[i].name);
     }
 
-    SimpleTemporalProblem stn(variable_names);
+    SimpleTemporalProblem stn(trace.front()->get_context().instrumentation,
+            variable_names);
 
     // assert that causal relationships are preserved
     for(set<Ordering>::iterator it = partial_order.begin(); it != partial_order.end(); ++it) {
@@ -310,7 +311,7 @@ void PartialOrderLifter::buildPartialOrder() {
         // two instances of the same action may not overlap in time!
         for(int k = i-1; k >= 0; --k) {
             InstantPlanStep &temp_step = instant_plan[k];
-            if(step.op->get_name().compare(temp_step.op->get_name())==0) {
+            if(step.op->get_id() == temp_step.op->get_id()) {
 //                step.print_name();
 //                cout << " (" << i << ")";
 //                cout << " is the same as ";
@@ -531,7 +532,7 @@ int PartialOrderLifter::getIndexOfPlanStep(const ScheduledOperator& op, double t
 //    cout << "Searching for " << op.get_name() << ", timestamp: " << timestamp << endl;
     for(int i = 0; i < plan.size(); ++i) {
 //        cout << "  This is " << plan[i].op->get_name() << ", plan[i].start_time: " << plan[i].start_time << endl;
-        if(plan[i].op->get_name().compare(op.get_name()) == 0 && abs(plan[i].start_time - timestamp)-EPSILON <= EPS_TIME) {
+        if(plan[i].op->get_id() == op.get_id() && abs(plan[i].start_time - timestamp)-EPSILON <= EPS_TIME) {
             return i;
         }
     }
@@ -604,7 +605,7 @@ void PartialOrderLifter::buildInstantPlan() {
         const ScheduledOperator* tmpOp = NULL;
         for(unsigned int j = 0; j < actualEndingTimeOfRunningActions.size(); ++j) {
             tmpOp = actualEndingTimeOfRunningActions[j].first;
-            if(tmpOp->get_name().compare(new_op.get_name())==0) {
+            if(tmpOp->get_id() == new_op.get_id()) {
                 isAlreadyRunning = true;
                 break;
             }
@@ -615,7 +616,7 @@ void PartialOrderLifter::buildInstantPlan() {
             startPoints++;
 //            cout << "  STARTING: " << new_op.get_name() << endl;
             double startTime = currentTimeStamp;
-            double time_increment = new_op.time_increment;
+            double time_increment = stateAfterHappening->time_increment(new_op);
             double endTime = startTime + time_increment;
             vector<Prevail> preconditions;
             findPreconditions(new_op, preconditions, start_action);
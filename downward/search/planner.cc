@@ -1,13 +1,22 @@
 #include "best_first_search.h"
+#include "enforced_hill_climbing.h"
+#include "beam_search.h"
+#include "best_first_width_search.h"
 #include "cyclic_cg_heuristic.h"
 #include "no_heuristic.h"
 #include "monitoring.h"
 
+#include "axioms.h"
 #include "globals.h"
 #include "operator.h"
 #include "partial_order_lifter.h"
+#include "epsilonize.h"
+#include "event_stream.h"
+#include "instrumentation.h"
 
 #include "plannerParameters.h"
+#include "planner.h"
+#include "task_reader.h"
 
 #include <cstdlib>
 #include <cstring>
@@ -24,47 +33,28 @@ using namespace std;
 #include <sys/times.h>
 #include <sys/time.h>
 
-double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_number, string &plan_name);
+double save_plan(SearchEngine& engine, double best_makespan, int &plan_number, string &plan_name,
+        Plan &best_plan);
+string write_plan(const SearchContext &context, const Plan &plan, int &plan_number,
+        const string &plan_name);
+SearchEngine::status run_first_stage(SearchEngine& stage_engine, BestFirstSearchEngine& engine,
+        const string &stage_name, double &best_makespan, int &plan_number, Plan &best_plan);
 //std::string getTimesName(const string & plan_name);    ///< returns the file name of the .times file for plan_name
 double getCurrentTime();            ///< returns the system time in seconds
 
-int main(int argc, char **argv)
+int run_planner(int argc, char **argv, TaskReader *task_reader)
 {
-    srand(1);
-    ifstream file("../preprocess/output");
-    if(strcmp(argv[argc - 1], "-eclipserun") == 0) {
-        cin.rdbuf(file.rdbuf());
-        cerr.rdbuf(cout.rdbuf());
-        argc--;
-    }
-
-    struct tms start, search_start, search_end;
+    struct tms start, end;
     times(&start);
-    double start_walltime, search_start_walltime, search_end_walltime;
-    start_walltime = getCurrentTime();
-
-    if(!g_parameters.readParameters(argc, argv)) {
-        cerr << "Error in reading parameters.\n";
+    double start_walltime = getCurrentTime();
+
+    Task task;
+    PlannerParameters parameters;
+    EventStream events;
+    Instrumentation instrumentation;
+    SearchContext context(task, parameters, events, instrumentation);
+    if(!load_task(context, argc, argv, task_reader))
         return 2;
-    }
-    g_parameters.dump();
-
-    bool poly_time_method = false;
-    cin >> poly_time_method;
-    if(poly_time_method) {
-        cout << "Poly-time method not implemented in this branch." << endl;
-        cout << "Starting normal solver." << endl;
-    }
-
-    read_everything(cin);
-
-    cout << "Contains universal conditions: " << g_contains_universal_conditions << endl;
-    if(g_parameters.reschedule_plans && g_contains_universal_conditions) {
-        cout << "Disabling rescheduling because of universal conditions in original task!" << endl;
-    }
-
-    g_let_time_pass = new Operator(false);
-    g_wait_operator = new Operator(true);
 
     //    FILE* timeDebugFile = NULL;
     // if(!getTimesName(g_parameters.plan_name).empty()) {
@@ -82,39 +72,242 @@ int main(int argc, char **argv)
 
 
     // Monitoring mode
-    if (!g_parameters.planMonitorFileName.empty()) {
-        bool ret = MonitorEngine::validatePlan(g_parameters.planMonitorFileName);
+    if (!context.parameters.planMonitorFileName.empty()) {
+        bool ret = MonitorEngine::validatePlan(context, context.parameters.planMonitorFileName);
         if(ret)
             exit(0);
         exit(1);
     }
 
+    // Benchmark mode
+    if(context.parameters.benchmark_axiom_runs > 0) {
+        context.task.axiom_evaluator->benchmark_numeric_axioms(*context.task.initial_state,
+                context.parameters.benchmark_axiom_runs);
+        return 0;
+    }
+
+    PlannerHeuristics heuristics;
+    create_heuristics(context, heuristics);
+    Plan best_plan;
+    int exit_code = run_search(context, heuristics, Plan(), best_plan);
+
+    times(&end);
+    int total_ms = (end.tms_utime - start.tms_utime) * 10;
+    double total_time = 0.001 * (double)total_ms;
+    double total_time_wall = getCurrentTime() - start_walltime;
+    cout << "Total time: " << total_time << " seconds - Walltime: " 
+        << total_time_wall << " seconds" << endl;
+
+    // if(timeDebugFile) {
+    //     fprintf(timeDebugFile, "%f %f %f %f %f\n", -1.0, search_time, total_time, 
+    //             search_time_wall, total_time_wall);
+    //     fclose(timeDebugFile);
+    // }
+
+    return exit_code;
+}
+
+bool load_task(const SearchContext &context, int argc, char **argv, TaskReader *task_reader)
+{
+    srand(1);
+
+    if(!context.parameters.readParameters(argc, argv)) {
+        cerr << "Error in reading parameters.\n";
+        delete task_reader;
+        return false;
+    }
+    context.parameters.dump();
+    if(!context.parameters.event_stream.empty() && !context.events.open(context.parameters.event_stream)) {
+        cerr << "Could not open event stream " << context.parameters.event_stream << ".\n";
+        delete task_reader;
+        return false;
+    }
+#ifdef TFD_INSTRUMENTATION
+    context.instrumentation.start(context.parameters.instrumentation_file);
+#endif
+
+    bool poly_time_method = false;
+    *task_reader >> poly_time_method;
+    if(poly_time_method) {
+        cout << "Poly-time method not implemented in this branch." << endl;
+        cout << "Starting normal solver." << endl;
+    }
+
+    read_everything(context, *task_reader);
+    delete task_reader;
+
+    cout << "Contains universal conditions: " << context.task.contains_universal_conditions << endl;
+    cout << "Task class: " << task_class_name(context.task.progression_class) << endl;
+    if(context.parameters.reschedule_plans && context.task.contains_universal_conditions) {
+        cout << "Disabling rescheduling because of universal conditions in original task!" << endl;
+    }
+
+    context.task.let_time_pass = new Operator(false);
+    context.task.wait_operator = new Operator(true);
+    return true;
+}
+
+PlannerHeuristics::PlannerHeuristics() :
+    makespan_heuristic(0), cea_heuristic(0), no_heuristic(0)
+{
+}
+
+PlannerHeuristics::~PlannerHeuristics()
+{
+    delete makespan_heuristic;
+    delete cea_heuristic;
+    delete no_heuristic;
+}
+
+void create_heuristics(const SearchContext &context, PlannerHeuristics &heuristics)
+{
+    if(context.parameters.makespan_heuristic || context.parameters.makespan_heuristic_preferred_operators)
+        heuristics.makespan_heuristic = new CyclicCGHeuristic(context,
+                CyclicCGHeuristic::REMAINING_MAKESPAN);
+    if(context.parameters.cyclic_cg_heuristic || context.parameters.cyclic_cg_preferred_operators)
+        heuristics.cea_heuristic = new CyclicCGHeuristic(context, CyclicCGHeuristic::CEA);
+    if(context.parameters.no_heuristic)
+        heuristics.no_heuristic = new NoHeuristic(context);
+}
+
+void PlannerHeuristics::reset_goal()
+{
+    if(makespan_heuristic)
+        makespan_heuristic->reset_goal();
+    if(cea_heuristic)
+        cea_heuristic->reset_goal();
+}
+
+/// Start a search with the previous plan if it still solves the task.
+/**
+ * The plan is written as first plan and its makespan becomes the bound of
+ * engine, so that the search only looks for better plans. Returns false if
+ * the plan is not valid for the current initial state and goal.
+ */
+static bool warm_start(const Plan &warm_start_plan, BestFirstSearchEngine &engine,
+        double &best_makespan, int &plan_number, Plan &best_plan)
+{
+    const SearchContext &context = engine.get_context();
+    Plan plan = warm_start_plan;
+    MonitorEngine monitor(context);
+    if(!monitor.validatePlan(plan)) {
+        cout << "Previous plan is not valid for this task." << endl;
+        return false;
+    }
+    double makespan = 0;
+    for(int i = 0; i < plan.size(); i++)
+        makespan = max(makespan, plan[i].start_time + plan[i].duration);
+    cout << "Previous plan is still valid." << endl;
+    cout << "Plan length: " << plan.size() << " step(s)." << endl;
+    cout << "Makespan   : " << makespan << endl;
+    write_plan(context, warm_start_plan, plan_number, context.parameters.plan_name);
+    best_plan = warm_start_plan;
+    best_makespan = makespan;
+    engine.bestMakespan = makespan;
+    if(context.parameters.use_subgoals_to_break_makespan_ties)
+        engine.bestSumOfGoals = getSumOfSubgoals(warm_start_plan);
+    engine.mark_solution_found_elsewhere();
+    return true;
+}
+
+int run_search(const SearchContext &context, PlannerHeuristics &heuristics,
+        const Plan &warm_start_plan, Plan &best_plan)
+{
+    struct tms search_start, search_end;
+    double search_start_walltime, search_end_walltime;
+
     // Initialize search engine and heuristics
-    BestFirstSearchEngine* engine = new BestFirstSearchEngine(g_parameters.queueManagementMode);
-
-    if(g_parameters.makespan_heuristic || g_parameters.makespan_heuristic_preferred_operators)
-        engine->add_heuristic(new CyclicCGHeuristic(CyclicCGHeuristic::REMAINING_MAKESPAN),
-            g_parameters.makespan_heuristic, g_parameters.makespan_heuristic_preferred_operators);
-    if(g_parameters.cyclic_cg_heuristic || g_parameters.cyclic_cg_preferred_operators)
-        engine->add_heuristic(new CyclicCGHeuristic(CyclicCGHeuristic::CEA), g_parameters.cyclic_cg_heuristic,
-            g_parameters.cyclic_cg_preferred_operators, g_parameters.pref_ops_cheapest_mode,
-            g_parameters.pref_ops_most_expensive_mode, g_parameters.pref_ops_ordered_mode,
-            g_parameters.pref_ops_rand_mode, g_parameters.pref_ops_concurrent_mode);
-    if(g_parameters.no_heuristic)
-        engine->add_heuristic(new NoHeuristic, g_parameters.no_heuristic, false);
+    BestFirstSearchEngine* engine = new BestFirstSearchEngine(context,
+            context.parameters.queueManagementMode);
+
+    // heuristic used by beam search: CEA if available, the first one otherwise
+    Heuristic* beam_heuristic = NULL;
+    if(heuristics.makespan_heuristic) {
+        beam_heuristic = heuristics.makespan_heuristic;
+        engine->add_heuristic(beam_heuristic,
+            context.parameters.makespan_heuristic, context.parameters.makespan_heuristic_preferred_operators);
+    }
+    CyclicCGHeuristic* cea_heuristic = heuristics.cea_heuristic;
+    if(cea_heuristic) {
+        engine->add_heuristic(cea_heuristic, context.parameters.cyclic_cg_heuristic,
+            context.parameters.cyclic_cg_preferred_operators, context.parameters.pref_ops_cheapest_mode,
+            context.parameters.pref_ops_most_expensive_mode, context.parameters.pref_ops_ordered_mode,
+            context.parameters.pref_ops_rand_mode, context.parameters.pref_ops_concurrent_mode);
+        beam_heuristic = cea_heuristic;
+    }
+    if(heuristics.no_heuristic) {
+        engine->add_heuristic(heuristics.no_heuristic, context.parameters.no_heuristic, false);
+        if(!beam_heuristic)
+            beam_heuristic = heuristics.no_heuristic;
+    }
 
     double best_makespan = REALLYBIG;
     times(&search_start);
     search_start_walltime = getCurrentTime();
+    search_end = search_start;
+    search_end_walltime = search_start_walltime;
     int plan_number = 1;
+    best_plan.clear();
+    int expanded_nodes = 0;     // by all stages that ran, the best first search is added last
 
     SearchEngine::status search_result = SearchEngine::IN_PROGRESS;
-    if(g_parameters.reset_after_solution_was_found) {
+    if(context.parameters.reset_after_solution_was_found) {
         cout << "Giving prior boost to open list " << engine->queueStartedLastWith << endl;
         engine->open_lists[engine->queueStartedLastWith].priority -= 5000;
     }
 
-    while(true) {
+    if(!warm_start_plan.empty()
+            && warm_start(warm_start_plan, *engine, best_makespan, plan_number, best_plan))
+        search_result = SearchEngine::SOLVED;
+
+    // Enforced hill-climbing and beam search can be run before the best
+    // first search. The best first search is only run if they fail or to
+    // improve the plan in anytime mode.
+    if(context.parameters.enforced_hill_climbing) {
+        assert(cea_heuristic);
+        EnforcedHillClimbingSearchEngine ehc_engine(context, cea_heuristic);
+        search_result = run_first_stage(ehc_engine, *engine, "enforced hill-climbing",
+            best_makespan, plan_number, best_plan);
+        expanded_nodes += ehc_engine.get_number_of_expanded_nodes();
+        times(&search_end);
+        search_end_walltime = getCurrentTime();
+    }
+    if(context.parameters.beam_width > 0 && !engine->found_at_least_one_solution()
+            && search_result != SearchEngine::FAILED_TIMEOUT) {
+        BeamSearchEngine beam_engine(context, beam_heuristic, context.parameters.beam_width);
+        search_result = run_first_stage(beam_engine, *engine, "beam search",
+            best_makespan, plan_number, best_plan);
+        expanded_nodes += beam_engine.get_number_of_expanded_nodes();
+        times(&search_end);
+        search_end_walltime = getCurrentTime();
+    }
+
+    // beam search without F is memory bounded, so the width search with its
+    // closed list is not run after it either
+    if(context.parameters.novelty_width > 0 && !engine->found_at_least_one_solution()
+            && search_result != SearchEngine::FAILED_TIMEOUT
+            && (context.parameters.beam_width == 0 || context.parameters.beam_search_first_stage)) {
+        BestFirstWidthSearchEngine width_engine(context, cea_heuristic, context.parameters.novelty_width);
+        search_result = run_first_stage(width_engine, *engine, "best first width search",
+            best_makespan, plan_number, best_plan);
+        expanded_nodes += width_engine.get_number_of_expanded_nodes();
+        times(&search_end);
+        search_end_walltime = getCurrentTime();
+    }
+
+    bool run_best_first_search = true;
+    if(context.parameters.beam_width > 0 && !context.parameters.beam_search_first_stage)
+        run_best_first_search = false;      // memory bounded: never fall back
+    if(context.parameters.novelty_width > 0 && search_result == SearchEngine::FAILED)
+        run_best_first_search = false;      // complete: state space explored
+    if(search_result == SearchEngine::FAILED_TIMEOUT)
+        run_best_first_search = false;
+    if(engine->found_at_least_one_solution() && !context.parameters.anytime_search)
+        run_best_first_search = false;
+    if(search_result == SearchEngine::FAILED && run_best_first_search)
+        cout << "Falling back to best first search." << endl;
+
+    while(run_best_first_search) {
         engine->initialize();
         search_result = engine->search();
 
@@ -124,7 +317,8 @@ int main(int argc, char **argv)
             cout << "New solution has been found." << endl;
             if(search_result == SearchEngine::SOLVED) {
                 // FIXME only save_plan if return value is SOLVED, otherwise no new plan was found
-                best_makespan = save_plan(*engine, best_makespan, plan_number, g_parameters.plan_name);
+                best_makespan = save_plan(*engine, best_makespan, plan_number, context.parameters.plan_name,
+                    best_plan);
                 // write plan length and search time to file
                 // if(timeDebugFile && search_result == SearchEngine::SOLVED) {    // don't write info for timeout
                 //     int search_ms = (search_end.tms_utime - search_start.tms_utime) * 10;
@@ -142,9 +336,9 @@ int main(int argc, char **argv)
             }
             // to continue searching we need to be in anytime search and the ret value is SOLVED
             // all other possibilities are either a timeout or completely explored search space
-            if(g_parameters.anytime_search) {
+            if(context.parameters.anytime_search) {
                 if (search_result == SearchEngine::SOLVED) {
-                    if(g_parameters.reset_after_solution_was_found && engine->mode == BestFirstSearchEngine::PRIORITY_BASED) {
+                    if(context.parameters.reset_after_solution_was_found && engine->mode == BestFirstSearchEngine::PRIORITY_BASED) {
 //                        engine->reset();
                     } else {
                         engine->fetch_next_state();
@@ -159,96 +353,59 @@ int main(int argc, char **argv)
             break;
         }
     }
+    engine->dump_pruning_statistics();
+    if(context.parameters.verbose)
+        engine->dump_allocation_statistics();
+    expanded_nodes += engine->get_number_of_expanded_nodes();
+    cout << "Expanded nodes: " << expanded_nodes << " state(s)." << endl;
 
     double search_time_wall = search_end_walltime - search_start_walltime;
-    double total_time_wall = search_end_walltime - start_walltime;
-
     int search_ms = (search_end.tms_utime - search_start.tms_utime) * 10;
-    int total_ms = (search_end.tms_utime - start.tms_utime) * 10;
     double search_time = 0.001 * (double)search_ms;
-    double total_time = 0.001 * (double)total_ms;
     cout << "Search time: " << search_time << " seconds - Walltime: "
         << search_time_wall << " seconds" << endl;
-    cout << "Total time: " << total_time << " seconds - Walltime: " 
-        << total_time_wall << " seconds" << endl;
-
-    // if(timeDebugFile) {
-    //     fprintf(timeDebugFile, "%f %f %f %f %f\n", -1.0, search_time, total_time, 
-    //             search_time_wall, total_time_wall);
-    //     fclose(timeDebugFile);
-    // }
 
+    int exit_code = 2;
+    string termination_reason = "error";
     switch(search_result) {
         case SearchEngine::SOLVED_TIMEOUT:
         case SearchEngine::FAILED_TIMEOUT:
-            return 137;
+            exit_code = 137;
+            termination_reason = "timeout";
+            break;
         case SearchEngine::SOLVED:
+            exit_code = 0;
+            termination_reason = "solved";
+            break;
         case SearchEngine::SOLVED_COMPLETE:
-            return 0;
+            exit_code = 0;
+            termination_reason = "solved_complete";
+            break;
         case SearchEngine::FAILED:
             assert (!engine->found_at_least_one_solution());
-            return 1;
+            exit_code = 1;
+            termination_reason = "unsolved";
+            break;
         default:
             cerr << "Invalid Search return value: " << search_result << endl;
     }
+    context.events.termination(termination_reason, exit_code, plan_number - 1, best_makespan);
+    delete engine;
 
-    return 2;
+    return exit_code;
 }
 
-/// Epsilonize the plan at filename
-/**
- * Uses a syscall to epsilonize_plan in tfd_modules package.
- *
- * This will result in the file "filename" copied at "filename.orig" and
- * "filename" being the epsilonized version.
- *
- * \returns true, if the syscall was successfull.
- */
-bool epsilonize_plan(const std::string & filename, bool keepOriginalPlan = true)
-{
-    // get a temp file name
-    std::string orig_file = filename + ".orig";
-
-    // first move filename to ...orig file, FIXME copy better?
-    int retMove = rename(filename.c_str(), orig_file.c_str());
-    if(retMove != 0) {
-        cerr << __func__ << ": Error moving to orig file: " << orig_file << " from: " << filename << endl;
-        return false;
-    }
-
-    // create the syscall to write the epsilonized plan
-    std::string syscall = "epsilonize_plan.py";
-    // read in the orig plan filename and output to filename
-    syscall += " < " + orig_file + " > " + filename;  
-
-    // execute epsilonize
-    int ret = system(syscall.c_str());
-    if(ret != 0) {
-        cerr << __func__ << ": Error executing epsilonize_plan as: " << syscall << endl;
-        // move back instead of copying/retaining .orig although not epsilonized
-        int retMove = rename(orig_file.c_str(), filename.c_str());
-        if(retMove != 0) {
-            cerr << __func__ << ": Error moving orig file: " << orig_file << " back to: " << filename << endl;
-        }
-        return false;
-    }
-
-    if(!keepOriginalPlan) {
-        remove(orig_file.c_str());  // don't care about return value, can't do anything if it fails
-    }
-
-    return true;
-}
-
-double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_number, string &plan_name)
+double save_plan(SearchEngine& engine, double best_makespan, int &plan_number, string &plan_name,
+        Plan &best_plan)
 {
+    const SearchContext &context = engine.get_context();
     const vector<PlanStep> &plan = engine.get_plan();
     const PlanTrace &path = engine.get_path();
 
     PartialOrderLifter partialOrderLifter(plan, path);
 
     Plan rescheduled_plan = plan;
-    if(!g_contains_universal_conditions && g_parameters.reschedule_plans)
+    if(!context.task.contains_universal_conditions && context.parameters.reschedule_plans)
         rescheduled_plan = partialOrderLifter.lift();
 
     double makespan = 0;
@@ -262,7 +419,7 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
         original_makespan = max(original_makespan, end_time);
     }
 
-    if(g_parameters.use_subgoals_to_break_makespan_ties) {
+    if(context.parameters.use_subgoals_to_break_makespan_ties) {
         if(makespan > best_makespan)
             return best_makespan;
 
@@ -292,7 +449,7 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
         const PlanStep& step = plan[i];
         printf("%.8f: (%s) [%.8f]\n", step.start_time, step.op->get_name().c_str(), step.duration);
     }
-    if(!g_contains_universal_conditions && g_parameters.reschedule_plans) {
+    if(!context.task.contains_universal_conditions && context.parameters.reschedule_plans) {
         cout << "Rescheduled Plan:" << endl;
         for (int i = 0; i < rescheduled_plan.size(); i++) {
             const PlanStep& step = rescheduled_plan[i];
@@ -302,6 +459,40 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
     cout << "Solution with original makespan " << original_makespan
         << " found (ignoring no-moving-targets-rule)." << endl;
 
+    std::string plan_filename = write_plan(context, rescheduled_plan, plan_number, plan_name);
+    best_plan = rescheduled_plan;
+    for(int i = 0; i < best_plan.size(); i++)
+        best_plan[i].pred = 0;  // states are freed with the engine
+
+    cout << "Plan length: " << rescheduled_plan.size() << " step(s)." << endl;
+    cout << "Makespan   : " << makespan << endl;
+    if(!context.task.contains_universal_conditions && context.parameters.reschedule_plans)
+        cout << "Rescheduled Makespan   : " << makespan << endl;
+    else
+        cout << "Makespan   : " << makespan << endl;
+
+    return makespan;
+}
+
+static void write_plan_steps(FILE *file, const Plan &plan)
+{
+    for(int i = 0; i < plan.size(); i++) {
+        const PlanStep& step = plan[i];
+        fprintf(file, "%.8f: (%s) [%.8f]\n", step.start_time, step.op->get_name().c_str(), step.duration);
+    }
+}
+
+/// Write plan to the file for plan_number (or stdout if plan_name is "-").
+/**
+ * With epsilonize_externally the epsilonized plan is written (and the
+ * original one to "<file>.orig" if keep_original_plans is set).
+ *
+ * \returns the name of the written file, empty if it was written to stdout
+ * or could not be opened.
+ */
+string write_plan(const SearchContext &context, const Plan &plan, int &plan_number,
+        const string &plan_name)
+{
     // Determine filenames to write to
     FILE *file = 0;
     //    FILE *unscheduled_plan_file = 0;
@@ -319,7 +510,7 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
 
         // Construct filenames
         //        best_plan_filename = plan_name + ".best";
-        if (g_parameters.anytime_search)
+        if (context.parameters.anytime_search)
             plan_filename = plan_name + "." + planNrStr;
         else
             plan_filename = plan_name;
@@ -333,7 +524,7 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
         if(file == NULL) {
             fprintf(stderr, "%s:\n  Could not open plan file %s for writing.\n", 
                     __PRETTY_FUNCTION__, plan_filename.c_str());
-            return makespan;
+            return std::string();
         }
     } else {
         file = stdout;
@@ -341,14 +532,30 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
 
     // Actually write the plan
     plan_number++;
-    for(int i = 0; i < rescheduled_plan.size(); i++) {
-        const PlanStep& step = rescheduled_plan[i];
-        fprintf(file, "%.8f: (%s) [%.8f]\n", step.start_time, step.op->get_name().c_str(), step.duration);
-        // if (best_file) {
-        //     fprintf(best_file, "%.8f: (%s) [%.8f]\n", 
-        //         step.start_time, step.op->get_name().c_str(), step.duration);
-        // }
+    EpsilonizedPlan epsilonized_plan;
+    bool epsilonized = false;
+    if(context.parameters.epsilonize_externally) {
+        epsilonized = epsilonize_plan(plan, epsilonized_plan);
+        if(!epsilonized)
+            cout << "Error while epsilonizing plan, writing it unchanged." << endl;
+    }
+    if(epsilonized) {
+        write_epsilonized_plan(file, epsilonized_plan);
+        if(context.parameters.keep_original_plans && !plan_filename.empty()) {
+            string orig_filename = plan_filename + ".orig";
+            FILE *orig_file = fopen(orig_filename.c_str(), "w");
+            if(orig_file) {
+                write_plan_steps(orig_file, plan);
+                fclose(orig_file);
+            } else {
+                fprintf(stderr, "%s:\n  Could not open plan file %s for writing.\n",
+                        __PRETTY_FUNCTION__, orig_filename.c_str());
+            }
+        }
+    } else {
+        write_plan_steps(file, plan);
     }
+    context.events.incumbent(epsilonized ? epsilonized_plan.plan : plan, plan_number - 1, plan_filename);
 
     // for(int i = 0; i < plan.size(); i++) {
     //     const PlanStep& step = plan[i];
@@ -362,28 +569,34 @@ double save_plan(BestFirstSearchEngine& engine, double best_makespan, int &plan_
         //     fclose(best_file);
     }
 
-    cout << "Plan length: " << rescheduled_plan.size() << " step(s)." << endl;
-    cout << "Makespan   : " << makespan << endl;
-    if(!g_contains_universal_conditions && g_parameters.reschedule_plans)
-        cout << "Rescheduled Makespan   : " << makespan << endl;
-    else
-        cout << "Makespan   : " << makespan << endl;
+    return plan_filename;
+}
 
-    if(g_parameters.epsilonize_externally) {
-    // Perform epsilonize
-    if(!plan_filename.empty()) {
-        bool ret_of_epsilonize_plan = epsilonize_plan(plan_filename, g_parameters.keep_original_plans);
-        if(!ret_of_epsilonize_plan)
-            cout << "Error while calling epsilonize plan! File: " << plan_filename << endl;
-    }
-    // if(!best_plan_filename.empty()) {
-    //     bool ret_of_epsilonize_best_plan = epsilonize_plan(best_plan_filename, g_parameters.keep_original_plans);
-    //     if(!ret_of_epsilonize_best_plan)
-    //         cout << "Error while calling epsilonize best_plan! File: " << best_plan_filename << endl;
-    //     }
+/// Run stage_engine as a first stage before the best first search engine.
+/**
+ * A plan found by stage_engine is saved and its makespan is given to engine
+ * as bound, so that engine only searches for better plans.
+ */
+SearchEngine::status run_first_stage(SearchEngine& stage_engine, BestFirstSearchEngine& engine,
+        const string &stage_name, double &best_makespan, int &plan_number, Plan &best_plan)
+{
+    const SearchContext &context = engine.get_context();
+    stage_engine.bestMakespan = engine.bestMakespan;
+    stage_engine.bestSumOfGoals = engine.bestSumOfGoals;
+    stage_engine.initialize();
+    SearchEngine::status search_result = stage_engine.search();
+
+    if(stage_engine.found_solution()) {
+        cout << "New solution has been found by " << stage_name << "." << endl;
+        best_makespan = save_plan(stage_engine, best_makespan, plan_number, context.parameters.plan_name,
+            best_plan);
+        engine.bestMakespan = best_makespan;
+        engine.bestSumOfGoals = stage_engine.bestSumOfGoals;
+        engine.mark_solution_found_elsewhere();
+    } else {
+        cout << "No solution found by " << stage_name << "." << endl;
     }
-
-    return makespan;
+    return search_result;
 }
 
 // std::string getTimesName(const string & plan_name)
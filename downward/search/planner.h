@@ -0,0 +1,53 @@
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#include "globals.h"
+
+class TaskReader;
+class CyclicCGHeuristic;
+class NoHeuristic;
+
+/// Read the task from task_reader and run the search configured by the command line.
+/**
+ * Takes ownership of task_reader, which is deleted as soon as the task
+ * has been read. Returns the exit code of the search binary.
+ */
+int run_planner(int argc, char **argv, TaskReader *task_reader);
+
+/// Read the search options and the task of context, the first part of run_planner.
+/**
+ * Takes ownership of task_reader. Returns false if the options are invalid.
+ */
+bool load_task(const SearchContext &context, int argc, char **argv, TaskReader *task_reader);
+
+/// Heuristics of the configured search, NULL if not used.
+/**
+ * The heuristics do not depend on a search engine, so they (and their
+ * local problems and caches) can be reused by several searches on the
+ * same task.
+ */
+struct PlannerHeuristics
+{
+    CyclicCGHeuristic *makespan_heuristic;
+    CyclicCGHeuristic *cea_heuristic;
+    NoHeuristic *no_heuristic;
+
+    PlannerHeuristics();
+    ~PlannerHeuristics();
+
+    /// Invalidate everything that depends on the goal of the task.
+    void reset_goal();
+};
+
+void create_heuristics(const SearchContext &context, PlannerHeuristics &heuristics);
+
+/// Search a plan from the initial state to the goal of the task of context.
+/**
+ * If warm_start_plan is not empty and still solves the task, it is saved as
+ * first plan and the search only looks for better plans. best_plan is set
+ * to the last plan saved. Returns the exit code of the search binary.
+ */
+int run_search(const SearchContext &context, PlannerHeuristics &heuristics,
+        const Plan &warm_start_plan, Plan &best_plan);
+
+#endif
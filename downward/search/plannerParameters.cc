@@ -6,6 +6,10 @@ PlannerParameters::PlannerParameters()
 {
     // set defaults
     anytime_search = false;
+    enforced_hill_climbing = false;
+    beam_width = 0;
+    beam_search_first_stage = false;
+    novelty_width = 0;
     timeout_while_no_plan_found = 0;
     timeout_if_plan_found = 0;
 
@@ -33,6 +37,11 @@ PlannerParameters::PlannerParameters()
 
     use_known_by_logical_state_only = false;
 
+    check_start_conditions_in_successor_generator = false;
+
+    use_stubborn_sets = false;
+    use_symmetries = false;
+
     use_subgoals_to_break_makespan_ties = false;
 
     reschedule_plans = false;
@@ -55,8 +64,11 @@ PlannerParameters::PlannerParameters()
 
     plan_name = "sas_plan";
     planMonitorFileName = "";
+    instrumentation_file = "instrumentation.json";
 
     monitoring_verify_timestamps = false;
+
+    benchmark_axiom_runs = 0;
 }
 
 PlannerParameters::~PlannerParameters()
@@ -75,6 +87,24 @@ bool PlannerParameters::readParameters(int argc, char** argv)
             ret = false;
         }
     }
+    if(enforced_hill_climbing && !cyclic_cg_heuristic && !cyclic_cg_preferred_operators) {
+        cerr << "Error: enforced hill-climbing requires the cyclic_cg heuristic (\"y\" or \"Y\")!" << endl;
+        ret = false;
+    }
+    if(beam_width < 0) {
+        cerr << "Error: beam_width < 0, have: " << beam_width << endl;
+        beam_width = 0;
+        ret = false;
+    }
+    if(beam_search_first_stage && beam_width == 0) {
+        cerr << "Error: beam search as first stage requires a beam width (\"B <width>\")!" << endl;
+        ret = false;
+    }
+    if(novelty_width < 0 || novelty_width > 2) {
+        cerr << "Error: novelty width must be 1 or 2, have: " << novelty_width << endl;
+        novelty_width = 0;
+        ret = false;
+    }
     if(timeout_if_plan_found < 0) {
         cerr << "Error: timeout_if_plan_found < 0, have: " << timeout_if_plan_found << endl;
         timeout_if_plan_found = 0;
@@ -96,6 +126,21 @@ void PlannerParameters::dump() const
 {
     cout << endl << "Planner Paramters:" << endl;
     cout << "Anytime Search: " << (anytime_search ? "Enabled" : "Disabled") << endl;
+    cout << "Enforced Hill-Climbing: " << (enforced_hill_climbing ? "Enabled" : "Disabled") << endl;
+    cout << "Beam Search: ";
+    if(beam_width > 0) {
+        cout << "Enabled with width " << beam_width
+            << (beam_search_first_stage ? " (first stage before best first search)" : "");
+    } else {
+        cout << "Disabled";
+    }
+    cout << endl;
+    cout << "Best First Width Search: ";
+    if(novelty_width > 0)
+        cout << "Enabled with width " << novelty_width;
+    else
+        cout << "Disabled";
+    cout << endl;
     cout << "Timeout if plan was found: " << timeout_if_plan_found << " seconds";
     if(timeout_if_plan_found == 0)
         cout << " (no timeout)";
@@ -164,6 +209,11 @@ void PlannerParameters::dump() const
     cout << "Known by logical state only filtering: "
         << (use_known_by_logical_state_only ? "Enabled" : "Disabled") << endl;
 
+    cout << "Check start conditions in successor generator: "
+        << (check_start_conditions_in_successor_generator ? "Enabled" : "Disabled") << endl;
+    cout << "Stubborn sets: " << (use_stubborn_sets ? "Enabled" : "Disabled") << endl;
+    cout << "Symmetry pruning: " << (use_symmetries ? "Enabled" : "Disabled") << endl;
+
     cout << "use_subgoals_to_break_makespan_ties: "
         << (use_subgoals_to_break_makespan_ties ? "Enabled" : "Disabled") << endl;
 
@@ -179,7 +229,21 @@ void PlannerParameters::dump() const
     }
     cout << endl;
 
+    cout << "Event stream: \"" << event_stream << "\"";
+    if(event_stream.empty()) {
+        cout << " (disabled)";
+    }
+    cout << endl;
+
+    cout << "Instrumentation file: \"" << instrumentation_file << "\"";
+#ifndef TFD_INSTRUMENTATION
+    cout << " (not compiled in)";
+#endif
+    cout << endl;
+
     cout << "Monitoring verify timestamps: " << (monitoring_verify_timestamps ? "Enabled" : "Disabled") << endl;
+    if(benchmark_axiom_runs > 0)
+        cout << "Benchmark numeric axioms: " << benchmark_axiom_runs << " runs" << endl;
 
     cout << endl;
 }
@@ -189,6 +253,11 @@ void PlannerParameters::printUsage() const
     printf("Usage: search <option characters>  (input read from stdin)\n");
     printf("Options are:\n");
     printf("  a - enable anytime search (otherwise finish on first plan found)\n");
+    printf("  H - run enforced hill-climbing first (falls back to best first search)\n");
+    printf("  B <width> - beam search with the given width instead of best first search\n");
+    printf("  F - use beam search only as first stage (falls back to best first search)\n");
+    printf("  W <width> - best first width search with novelty width 1 or 2 (secondary key: CEA or goal count),\n");
+    printf("              after beam search only with F\n");
     printf("  t <timeout secs> - total timeout in seconds for anytime search (when plan found)\n");
     printf("  T <timeout secs> - total timeout in seconds for anytime search (when no plan found)\n");
     printf("  m <monitor file> - monitor plan, validate a given plan\n");
@@ -202,6 +271,9 @@ void PlannerParameters::printUsage() const
     printf("  G [m|c|t|w] - G value evaluation, one of m - makespan, c - pathcost, t - timestamp, w [weight] - weighted / Note: One of those has to be set!\n");
     printf("  Q [r|p|h] - queue mode, one of r - round robin, p - priority, h - hierarchical\n");
     printf("  K - use tss known filtering (might crop search space)!\n");
+    printf("  P - prune operator starts by stubborn sets (partial order reduction)\n");
+    printf("  c - check start conditions in the successor generator (no recheck when applying)\n");
+    printf("  D - prune states symmetric to closed states (structural symmetries)\n");
     printf("  n - no_heuristic\n");
     printf("  r - reschedule_plans\n");
     printf("  O [n] - prefOpsOrderedMode, with n being the number of pref ops used\n");
@@ -210,8 +282,11 @@ void PlannerParameters::printUsage() const
     printf("  e - epsilonize internally\n");
     printf("  f - epsilonize externally\n");
     printf("  p <plan file> - plan filename prefix\n");
+    printf("  J <fd|unix:socket|file> - write progress events as JSON lines to the target\n");
+    printf("  I <file> - write the phase timers as JSON to the file (if compiled in)\n");
     printf("  M v - monitoring: verify timestamps\n");
     printf("  u - do not use cachin in heuristic\n");
+    printf("  A <n> - only benchmark the numeric axioms with n evaluations of the initial state\n");
 }
 
 bool PlannerParameters::readCmdLineParameters(int argc, char** argv)
@@ -220,6 +295,16 @@ bool PlannerParameters::readCmdLineParameters(int argc, char** argv)
         for (const char *c = argv[i]; *c != 0; c++) {
             if (*c == 'a') {
                 anytime_search = true;
+            } else if (*c == 'H') {
+                enforced_hill_climbing = true;
+            } else if (*c == 'B') {
+                assert(i + 1 < argc);
+                beam_width = atoi(string(argv[++i]).c_str());
+            } else if (*c == 'F') {
+                beam_search_first_stage = true;
+            } else if (*c == 'W') {
+                assert(i + 1 < argc);
+                novelty_width = atoi(string(argv[++i]).c_str());
             } else if (*c == 't') {
                 assert(i + 1 < argc);
                 timeout_if_plan_found = atoi(string(argv[++i]).c_str());
@@ -296,15 +381,30 @@ bool PlannerParameters::readCmdLineParameters(int argc, char** argv)
                 }
             } else if (*c == 'K') {
                 use_known_by_logical_state_only = true;
+            } else if (*c == 'P') {
+                use_stubborn_sets = true;
+            } else if (*c == 'c') {
+                check_start_conditions_in_successor_generator = true;
+            } else if (*c == 'D') {
+                use_symmetries = true;
             } else if (*c == 'p') {
                 assert(i + 1 < argc);
                 plan_name = string(argv[++i]);
+            } else if (*c == 'J') {
+                assert(i + 1 < argc);
+                event_stream = string(argv[++i]);
+            } else if (*c == 'I') {
+                assert(i + 1 < argc);
+                instrumentation_file = string(argv[++i]);
             } else if (*c == 'r') {
                 reschedule_plans = true;
             } else if (*c == 'e') {
                 epsilonize_internally = true;
             } else if (*c == 'f') {
                 epsilonize_externally = true;
+            } else if (*c == 'A') {
+                assert(i + 1 < argc);
+                benchmark_axiom_runs = atoi(string(argv[++i]).c_str());
             } else if (*c == 'M') {
                 assert(i + 1 < argc);
                 const char *g = argv[++i];
@@ -17,6 +17,10 @@ class PlannerParameters
 
    public:
       bool anytime_search;          ///< Perform anytime search (don't stop at first plan)
+      bool enforced_hill_climbing;  ///< Run enforced hill-climbing first, fall back to best first search on failure
+      int beam_width;               ///< Use beam search with this width instead of best first search (0 - disabled)
+      bool beam_search_first_stage; ///< Run beam search only as first stage before best first search
+      int novelty_width;            ///< Use best first width search with this max. novelty (0 - disabled)
       
       int timeout_if_plan_found;          ///< Timeout if a plan was found (0 - inf).
       int timeout_while_no_plan_found;    ///< Timeout while no plan found (0 - inf).
@@ -63,21 +67,30 @@ class PlannerParameters
 
       BestFirstSearchEngine::QueueManagementMode queueManagementMode;
 
+      bool check_start_conditions_in_successor_generator;  ///< Successor generator only returns operators whose start conditions hold
+
       bool use_known_by_logical_state_only;         ///< Enable tss known filtering (might crop search space!)
 
+      bool use_stubborn_sets;       ///< Prune operator starts by strong stubborn sets (partial order reduction)
+      bool use_symmetries;          ///< Prune states symmetric to closed states
+
       /** when enabled: if two plans have the same makespan, consider one better 
           if it has lower number of subgoals, otherwise same */
       bool use_subgoals_to_break_makespan_ties;     
  
       bool reschedule_plans;        ///< Use scheduler to reschedule found plans
       bool epsilonize_internally;   ///< add eps_time when applying an operator
-      bool epsilonize_externally;   ///< Add epsilon steps in between plan steps by calling epsilonize_plan.
+      bool epsilonize_externally;   ///< Add epsilon steps in between plan steps of the written plans (see epsilonize.h).
       bool keep_original_plans;     ///< Store non-epsilonized plans as "...orig" files (if epsilonize_externally on)
 
       string plan_name;             ///< File prefix for outputting plans
       string planMonitorFileName;   ///< Filename for monitoring (if set, implies monitoring mode)
+      string event_stream;          ///< Target of the JSON lines event stream (see event_stream.h), empty if disabled
+      string instrumentation_file;  ///< File for the phase timers and counters (see instrumentation.h), if compiled in
 
       bool monitoring_verify_timestamps;     ///< During monitoring only accept the monitored plan if the timestamps match the original one.
+
+      int benchmark_axiom_runs;     ///< Only benchmark the numeric axioms with this many evaluations of the initial state (0 - disabled)
    
    protected:
       /// Read parameters from command line.
@@ -0,0 +1,210 @@
+#include "replanner.h"
+
+#include "axioms.h"
+#include "event_stream.h"
+#include "instrumentation.h"
+#include "plannerParameters.h"
+#include "state.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+/// Index of the variable with the given name, -1 if there is none.
+static int lookup_variable(const Task &task, const string &name)
+{
+    for(int var = 0; var < task.variable_name.size(); var++)
+        if(task.variable_name[var] == name)
+            return var;
+    return -1;
+}
+
+static void request_syntax_error(const string &message)
+{
+    cerr << "Malformed replanning request: " << message << endl;
+    exit(2);
+}
+
+bool ReplanRequest::read(const Task &task, istream &in)
+{
+    state_changes.clear();
+    goal_changes.clear();
+    goal_removals.clear();
+
+    string word;
+    if(!(in >> word))
+        return false;
+    if(word != "begin_request")
+        request_syntax_error("expected begin_request, got " + word);
+    while(in >> word && word != "end_request") {
+        string variable, value;
+        if(!(in >> variable >> value))
+            break;
+        int var = lookup_variable(task, variable);
+        if(word == "init") {
+            state_changes.push_back(make_pair(var, strtod(value.c_str(), 0)));
+        } else if(word == "goal") {
+            if(value == "-")
+                goal_removals.push_back(var);
+            else
+                goal_changes.push_back(make_pair(var, strtod(value.c_str(), 0)));
+        } else {
+            request_syntax_error("unknown change " + word);
+        }
+    }
+    if(word != "end_request")
+        request_syntax_error("missing end_request");
+    return true;
+}
+
+Replanner::Replanner(const SearchContext &context) :
+    context(context)
+{
+    create_heuristics(context, heuristics);
+}
+
+/// Check that a discrete variable can have value.
+static bool is_value_of(const Task &task, int var, double value)
+{
+    if(task.variable_domain[var] == -1)
+        return true;
+    return value >= 0 && value < task.variable_domain[var] && value == static_cast<int>(value);
+}
+
+bool Replanner::is_valid(const ReplanRequest &request) const
+{
+    const Task &task = context.task;
+    for(int i = 0; i < request.state_changes.size(); i++) {
+        int var = request.state_changes[i].first;
+        if(var == -1 || !is_value_of(task, var, request.state_changes[i].second)) {
+            cout << "Invalid initial state change." << endl;
+            return false;
+        }
+        if(task.axiom_layers[var] != -1) {
+            cout << "Derived variable " << task.variable_name[var]
+                << " cannot be set in the initial state." << endl;
+            return false;
+        }
+    }
+    for(int i = 0; i < request.goal_changes.size(); i++) {
+        int var = request.goal_changes[i].first;
+        if(var == -1 || task.variable_domain[var] == -1
+                || !is_value_of(task, var, request.goal_changes[i].second)) {
+            cout << "Invalid goal change." << endl;
+            return false;
+        }
+    }
+    for(int i = 0; i < request.goal_removals.size(); i++) {
+        if(request.goal_removals[i] == -1) {
+            cout << "Invalid goal removal." << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void Replanner::apply_state_changes(const ReplanRequest &request)
+{
+    for(int i = 0; i < request.state_changes.size(); i++) {
+        const pair<int, double> &change = request.state_changes[i];
+        (*context.task.initial_state)[change.first] = change.second;
+    }
+    if(!request.state_changes.empty())
+        context.task.axiom_evaluator->evaluate(*context.task.initial_state);
+}
+
+bool Replanner::apply_goal_changes(const ReplanRequest &request)
+{
+    vector<pair<int, double> > goal = context.task.goal;
+    for(int i = 0; i < request.goal_removals.size(); i++) {
+        for(int j = 0; j < goal.size(); j++) {
+            if(goal[j].first == request.goal_removals[i]) {
+                goal.erase(goal.begin() + j);
+                break;
+            }
+        }
+    }
+    for(int i = 0; i < request.goal_changes.size(); i++) {
+        const pair<int, double> &change = request.goal_changes[i];
+        bool found = false;
+        for(int j = 0; j < goal.size(); j++) {
+            if(goal[j].first == change.first) {
+                goal[j].second = change.second;
+                found = true;
+            }
+        }
+        if(!found)
+            goal.push_back(change);
+    }
+    if(goal == context.task.goal)
+        return false;
+    context.task.goal = goal;
+    return true;
+}
+
+int Replanner::replan(const ReplanRequest &request, const string &plan_name)
+{
+    if(!is_valid(request))
+        return 2;
+    apply_state_changes(request);
+    if(apply_goal_changes(request)) {
+        cout << "Goal changed, resetting heuristic caches." << endl;
+        heuristics.reset_goal();
+    }
+
+    string saved_plan_name = context.parameters.plan_name;
+    context.parameters.plan_name = plan_name;
+    Plan best_plan;
+    int exit_code = run_search(context, heuristics, previous_plan, best_plan);
+    context.parameters.plan_name = saved_plan_name;
+
+    previous_plan = best_plan;
+    return exit_code;
+}
+
+double Replanner::get_makespan() const
+{
+    if(previous_plan.empty())
+        return -1;
+    double makespan = 0;
+    for(int i = 0; i < previous_plan.size(); i++)
+        makespan = max(makespan, previous_plan[i].start_time + previous_plan[i].duration);
+    return makespan;
+}
+
+int run_replanner(int argc, char **argv, TaskReader *task_reader, istream &requests)
+{
+    Task task;
+    PlannerParameters parameters;
+    EventStream events;
+    Instrumentation instrumentation;
+    SearchContext context(task, parameters, events, instrumentation);
+    if(!load_task(context, argc, argv, task_reader))
+        return 2;
+    Replanner replanner(context);
+
+    int exit_code = 0;
+    ReplanRequest request;
+    for(int number = 1; request.read(task, requests); number++) {
+        ostringstream plan_name;
+        plan_name << context.parameters.plan_name;
+        if(context.parameters.plan_name != "-")
+            plan_name << "." << number;
+        cout << "Replanning request " << number << "." << endl;
+        exit_code = replanner.replan(request, plan_name.str());
+
+        string status = "error";
+        if(exit_code == 0)
+            status = "solved";
+        else if(exit_code == 1)
+            status = "unsolved";
+        else if(exit_code == 137)
+            status = "timeout";
+        cout << "request " << number << " " << status << " " << exit_code << " "
+            << (exit_code == 0 ? max(0.0, replanner.get_makespan()) :
+                exit_code == 2 ? -1 : replanner.get_makespan()) << endl;
+    }
+    return exit_code;
+}
@@ -0,0 +1,82 @@
+#ifndef REPLANNER_H
+#define REPLANNER_H
+
+#include "globals.h"
+#include "planner.h"
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TaskReader;
+
+/// Changes of the initial state and the goal relative to the previous request.
+struct ReplanRequest
+{
+    std::vector<std::pair<int, double> > state_changes;    ///< (variable, new value)
+    std::vector<std::pair<int, double> > goal_changes;     ///< (variable, new goal value)
+    std::vector<int> goal_removals;                         ///< variables without goal
+
+    /// Read the next request, see run_replanner for the format.
+    /**
+     * Unknown variables are stored as -1 and rejected by Replanner::replan.
+     * Returns false at the end of the input, exits on syntax errors.
+     */
+    bool read(const Task &task, std::istream &in);
+};
+
+/// Replans on a task that has been loaded once.
+/**
+ * Requests change the initial state and the goal of the task. The
+ * successor generator, the DTGs, the causal graph and the local problems of
+ * the heuristics are kept between requests. The heuristic caches are only
+ * valid for one goal and are kept as long as the goal does not change.
+ * The best plan of the previous request is tried first on the new task
+ * and, if it still solves it, bounds the search.
+ */
+class Replanner
+{
+    const SearchContext &context;
+    PlannerHeuristics heuristics;
+    Plan previous_plan;
+
+    bool is_valid(const ReplanRequest &request) const;
+    void apply_state_changes(const ReplanRequest &request);
+    bool apply_goal_changes(const ReplanRequest &request);
+    public:
+        /// Replan on the task of context loaded by load_task.
+        Replanner(const SearchContext &context);
+
+        /// Solve the task changed by request, writing plans as plan_name.
+        /**
+         * Returns the exit code of the search binary for that task, 2 for
+         * invalid requests (which change nothing).
+         */
+        int replan(const ReplanRequest &request, const std::string &plan_name);
+
+        /// Makespan of the best plan of the last request, -1 if none was found.
+        double get_makespan() const;
+};
+
+/// Load the task and answer the replanning requests read from requests (tfd --replan).
+/**
+ * Takes ownership of task_reader. A request is given as
+ *
+ *   begin_request
+ *   init <variable> <value>
+ *   goal <variable> <value>
+ *   goal <variable> -
+ *   end_request
+ *
+ * with any number of init and goal lines. Variables are given by their
+ * names in the translated task (output.sas); their numbers change with the
+ * variable order of the preprocessor. "-" removes the goal of a variable.
+ * The plans of request n are written as <plan name>.<n> (and
+ * <plan name>.<n>.<k> in anytime mode). After each request a line
+ *   request <n> <solved|unsolved|timeout|error> <exit code> <makespan>
+ * is printed. Returns the exit code of the last request.
+ */
+int run_replanner(int argc, char **argv, TaskReader *task_reader, std::istream &requests);
+
+#endif
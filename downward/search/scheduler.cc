@@ -1,4 +1,5 @@
 #include "scheduler.h"
+#include "instrumentation.h"
 
 #include <cassert>
 #include <iostream>
@@ -6,9 +7,9 @@
 #include <sstream>
 #include <algorithm>
 
-SimpleTemporalProblem::SimpleTemporalProblem(
+SimpleTemporalProblem::SimpleTemporalProblem(Instrumentation &instrumentation,
         std::vector<std::string> _variable_names) :
-    variable_names(_variable_names)
+    instrumentation(instrumentation), variable_names(_variable_names)
 {
     variable_names.push_back("X0");
     number_of_nodes = variable_names.size();
@@ -84,6 +85,8 @@ void SimpleTemporalProblem::setUnboundedIntervalFromXZero(int to, double lower)
 // solve the STP using the Floyd-Warshall algorithm with running time O(n^3)
 void SimpleTemporalProblem::solve()
 {
+    INSTRUMENT_PHASE(instrumentation, phase_stn_solving);
+    INSTRUMENT_COUNT(instrumentation, phase_stn_solving, number_of_nodes);
     double triangle_length;
 
     for(size_t k = 0; k < number_of_nodes; k++) {
@@ -107,6 +110,8 @@ void SimpleTemporalProblem::solve()
 
 bool SimpleTemporalProblem::solveWithP3C()
 {
+  INSTRUMENT_PHASE(instrumentation, phase_stn_solving);
+  INSTRUMENT_COUNT(instrumentation, phase_stn_solving, number_of_nodes);
   makeGraphChordal();
   initializeArcVectors();
     if (!performDPC()) {
@@ -10,6 +10,8 @@ const double INF = 10000000.0;
 
 typedef std::pair<double,int> Happening;
 
+class Instrumentation;
+
 class SimpleTemporalProblem
 {
 private:
@@ -29,6 +31,7 @@ private:
   typedef std::vector<double> MatrixLine;
   typedef std::vector<MatrixLine> DistanceMatrix;
 
+  Instrumentation &instrumentation;   ///< of the search the problem is solved for
   int number_of_nodes;
   std::vector<std::string> variable_names;
   DistanceMatrix m_defaultDistances;
@@ -47,7 +50,8 @@ private:
   std::vector<double> m_minimalDistances;
 
 public:
-    SimpleTemporalProblem(std::vector<std::string> _variable_names);
+    SimpleTemporalProblem(Instrumentation &instrumentation,
+            std::vector<std::string> _variable_names);
 
   void setInterval(int from, int to, double lower, double upper);
 
@@ -1,14 +1,21 @@
 #include <cassert>
+#include <cmath>
+#include <ctime>
 using namespace std;
 
 #include "search_engine.h"
+#include "instrumentation.h"
 #include "state.h"
 #include "operator.h"
+#include "plannerParameters.h"
 
-SearchEngine::SearchEngine()
+SearchEngine::SearchEngine(const SearchContext &context) :
+    last_stat_time(time(NULL)), context(context)
 {
     solved = false;
     solved_at_least_once = false;
+    bestMakespan = HUGE_VAL;
+    bestSumOfGoals = HUGE_VAL;
 }
 
 SearchEngine::~SearchEngine()
@@ -19,6 +26,14 @@ void SearchEngine::statistics(time_t &) const
 {
 }
 
+void SearchEngine::report_statistics(time_t current_time)
+{
+    if(context.parameters.verbose && current_time - last_stat_time >= 10) {
+        statistics(current_time);
+        last_stat_time = current_time;
+    }
+}
+
 bool SearchEngine::found_solution() const
 {
     return solved;
@@ -29,6 +44,11 @@ bool SearchEngine::found_at_least_one_solution() const
     return solved_at_least_once;
 }
 
+void SearchEngine::mark_solution_found_elsewhere()
+{
+    solved_at_least_once = true;
+}
+
 const Plan &SearchEngine::get_plan() const
 {
     assert(solved);
@@ -50,18 +70,22 @@ const PlanTrace& SearchEngine::get_path() const
 
 void SearchEngine::set_path(const PlanTrace &states)
 {
-    // We need to free the old path as ClosedList::trace_path created new TSSs for us.
     for(PlanTrace::const_iterator it = path.begin(); it != path.end(); it++)
-        delete (*it);
-    path.clear();
+        path_states.release(*it);
     path = states;
 }
 
+void SearchEngine::dump_allocation_statistics() const
+{
+    path_states.dump_statistics("Plan trace states");
+}
+
 enum SearchEngine::status SearchEngine::search()
 {
     status st = IN_PROGRESS;
     while(st == IN_PROGRESS) {
         st = step();
+        INSTRUMENT_POLL(context.instrumentation);
     }
     if (st == FAILED || st == FAILED_TIMEOUT) {
         solved = false;
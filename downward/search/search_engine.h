@@ -2,6 +2,8 @@
 #define SEARCH_ENGINE_H
 
 #include "globals.h"
+#include "object_pool.h"
+#include "state.h"
 
 class SearchEngine
 {
@@ -10,6 +12,7 @@ class SearchEngine
         bool solved_at_least_once;
         Plan plan;
         PlanTrace path;
+        time_t last_stat_time;      ///< when the statistics were printed last
     public:
         enum status
         {
@@ -21,21 +24,49 @@ class SearchEngine
             SOLVED_TIMEOUT          ///< Found a plan, but not explored search space
         };
     protected:
+        const SearchContext &context;   ///< task and parameters this engine searches with
         virtual enum status step() = 0;
 
+        /// The states of the plan traces of this engine.
+        ObjectPool<TimeStampedState> path_states;
+
         void set_plan(const Plan &plan);
+        /// Set the path, its states must be from path_states.
         void set_path(const PlanTrace &states);
+        /// Print the allocation statistics of this engine.
+        virtual void dump_allocation_statistics() const;
+        /// Print the statistics every ten seconds in verbose mode, called by step().
+        void report_statistics(time_t current_time);
     public:
-        SearchEngine();
+        SearchEngine(const SearchContext &context);
         virtual ~SearchEngine();
         virtual void statistics(time_t & current_time) const;
         virtual void initialize() {}
         virtual void dump_everything() const = 0;
+        /// Number of states expanded since the engine was created.
+        virtual int get_number_of_expanded_nodes() const = 0;
         bool found_solution() const;
         bool found_at_least_one_solution() const;
         const Plan &get_plan() const;
         const PlanTrace& get_path() const;
         enum status search();
+        const SearchContext &get_context() const
+        {
+            return context;
+        }
+
+        /// Record that a plan was already found by another engine.
+        /**
+         * Used when this engine continues the search after a different
+         * engine (e.g. enforced hill-climbing) produced the first plan,
+         * so that the "plan found" timeout and the final search status
+         * take that plan into account.
+         */
+        void mark_solution_found_elsewhere();
+
+    public:
+        double bestMakespan;
+        double bestSumOfGoals;
 };
 
 #endif
@@ -28,9 +28,11 @@ void SearchStatistics::finishExpansion()
     for(std::map<int, int>::iterator it = childrenPerOpenList.begin(); it != childrenPerOpenList.end(); it++) {
         std::map<int, Statistics<double> >::iterator statIt = branchingFactors.find(it->first);
         if(statIt == branchingFactors.end()) {
-            char* buf = new char[1024];
+            char buf[64];
             sprintf(buf, "Open List %d", it->first);
-            branchingFactors[it->first] = Statistics<double>(buf);
+            // the statistics keep a pointer to the name
+            const std::string &name = branchingFactorNames[it->first] = buf;
+            branchingFactors[it->first] = Statistics<double>(name.c_str());
         }
         branchingFactors[it->first].addMeasurement(it->second); // count
         numChildren += it->second;
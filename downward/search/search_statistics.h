@@ -3,6 +3,7 @@
 
 #include <time.h>
 #include <map>
+#include <string>
 #include "statistics.h"
 
 class SearchStatistics
@@ -27,6 +28,7 @@ class SearchStatistics
         std::map<int, int> childrenPerOpenList;  ///< openlist -> children in expansion
         
         std::map<int, Statistics<double> > branchingFactors;    ///< openlist -> branching factor
+        std::map<int, std::string> branchingFactorNames;        ///< openlist -> name of its statistics
         Statistics<double> overallBranchingFactor;
 
         /// Closed list size on the last dump call
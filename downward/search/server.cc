@@ -0,0 +1,417 @@
+#include "server.h"
+#include "driver.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <stdint.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+/// Requests larger than this are rejected.
+static const unsigned int MAX_REQUEST_SIZE = 1u << 30;
+
+/// Exit code of a request process that ran out of memory.
+static const int EXIT_OUT_OF_MEMORY = 101;
+
+static volatile sig_atomic_t shutdown_requested = 0;
+
+static void request_shutdown(int)
+{
+    shutdown_requested = 1;
+}
+
+static void ignore_signal(int)
+{
+}
+
+/// Install handler for sig without SA_RESTART, so that blocking calls return EINTR.
+static void set_signal_handler(int sig, void (*handler)(int))
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handler;
+    sigemptyset(&action.sa_mask);
+    sigaction(sig, &action, 0);
+}
+
+static double get_walltime()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static bool write_all(int fd, const char *data, size_t size)
+{
+    while(size > 0) {
+        ssize_t written = write(fd, data, size);
+        if(written < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, char *data, size_t size)
+{
+    while(size > 0) {
+        ssize_t got = read(fd, data, size);
+        if(got < 0 && errno == EINTR)
+            continue;
+        if(got <= 0)
+            return false;
+        data += got;
+        size -= got;
+    }
+    return true;
+}
+
+static bool write_frame(int fd, const string &payload)
+{
+    uint32_t length = htonl(payload.size());
+    return write_all(fd, reinterpret_cast<const char *>(&length), sizeof(length))
+        && write_all(fd, payload.data(), payload.size());
+}
+
+static bool read_frame(int fd, string &payload)
+{
+    uint32_t length;
+    if(!read_all(fd, reinterpret_cast<char *>(&length), sizeof(length)))
+        return false;
+    length = ntohl(length);
+    if(length > MAX_REQUEST_SIZE)
+        return false;
+    payload.resize(length);
+    return length == 0 || read_all(fd, &payload[0], length);
+}
+
+static bool read_file(const string &filename, string &contents)
+{
+    ifstream file(filename.c_str(), ios::in | ios::binary);
+    if(!file)
+        return false;
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+static bool make_address(const string &socket_path, sockaddr_un &address)
+{
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << socket_path << endl;
+        return false;
+    }
+    strcpy(address.sun_path, socket_path.c_str());
+    return true;
+}
+
+static void out_of_memory()
+{
+    const char message[] = "Out of memory.\n";
+    write_all(STDOUT_FILENO, message, sizeof(message) - 1);
+    _exit(EXIT_OUT_OF_MEMORY);
+}
+
+/// Solve the task in the current process (forked for the request) writing to directory.
+static void solve_request(const string &directory, const vector<string> &options,
+        const string &sas_task, const ServerOptions &server_options)
+{
+    if(chdir(directory.c_str()) != 0)
+        _exit(2);
+    int log = open("log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(log < 0)
+        _exit(2);
+    cout.flush();
+    dup2(log, STDOUT_FILENO);
+    dup2(log, STDERR_FILENO);
+    close(log);
+
+    if(server_options.memory_limit > 0) {
+        rlimit limit;
+        limit.rlim_cur = limit.rlim_max =
+            static_cast<rlim_t>(server_options.memory_limit) * 1024 * 1024;
+        setrlimit(RLIMIT_AS, &limit);
+    }
+    set_new_handler(out_of_memory);
+
+    vector<char *> argv;
+    argv.push_back(const_cast<char *>("tfd"));
+    for(int i = 0; i < options.size(); i++)
+        argv.push_back(const_cast<char *>(options[i].c_str()));
+    argv.push_back(const_cast<char *>("p"));
+    argv.push_back(const_cast<char *>("plan"));
+    argv.push_back(0);
+
+    istringstream sas_input(sas_task);
+    int exit_code = run_pipeline(argv.size() - 1, &argv[0], sas_input);
+    cout.flush();
+    fflush(stdout);
+    _exit(exit_code);
+}
+
+/// Plan files written for plan name "plan", ordered by plan number.
+static void collect_plans(const string &directory, vector<string> &plan_files)
+{
+    vector<pair<int, string> > numbered;
+    DIR *dir = opendir(directory.c_str());
+    if(!dir)
+        return;
+    while(dirent *entry = readdir(dir)) {
+        string name = entry->d_name;
+        if(name == "plan")
+            numbered.push_back(make_pair(0, name));
+        else if(name.compare(0, 5, "plan.") == 0
+                && name.find_first_not_of("0123456789", 5) == string::npos)
+            numbered.push_back(make_pair(atoi(name.c_str() + 5), name));
+    }
+    closedir(dir);
+    sort(numbered.begin(), numbered.end());
+    for(int i = 0; i < numbered.size(); i++)
+        plan_files.push_back(numbered[i].second);
+}
+
+static void remove_directory(const string &directory)
+{
+    DIR *dir = opendir(directory.c_str());
+    if(dir) {
+        while(dirent *entry = readdir(dir)) {
+            string name = entry->d_name;
+            if(name != "." && name != "..")
+                unlink((directory + "/" + name).c_str());
+        }
+        closedir(dir);
+    }
+    rmdir(directory.c_str());
+}
+
+/// Handle one connection in a process forked by the server.
+static void handle_connection(int connection, const ServerOptions &server_options)
+{
+    string request;
+    if(!read_frame(connection, request)) {
+        write_frame(connection, "status error 2\nmessage malformed request\n");
+        return;
+    }
+    string::size_type line_end = request.find('\n');
+    if(line_end == string::npos)
+        line_end = request.size();
+    vector<string> options;
+    istringstream option_line(request.substr(0, line_end));
+    string option;
+    while(option_line >> option)
+        options.push_back(option);
+    string sas_task = request.substr(min(line_end + 1, request.size()));
+    request.clear();
+
+    char directory_template[] = "/tmp/tfd-request-XXXXXX";
+    if(!mkdtemp(directory_template)) {
+        write_frame(connection, "status error 2\nmessage could not create request directory\n");
+        return;
+    }
+    string directory = directory_template;
+
+    double start_walltime = get_walltime();
+    pid_t solver = fork();
+    if(solver == 0)
+        solve_request(directory, options, sas_task, server_options);
+
+    bool timed_out = false;
+    int status = 0;
+    if(solver < 0) {
+        status = -1;
+    } else {
+        set_signal_handler(SIGALRM, ignore_signal);
+        if(server_options.time_limit > 0)
+            alarm(server_options.time_limit);
+        while(waitpid(solver, &status, 0) < 0) {
+            if(errno != EINTR) {
+                status = -1;
+                break;
+            }
+            if(!timed_out) {
+                timed_out = true;
+                kill(solver, SIGKILL);
+            }
+        }
+        alarm(0);
+    }
+    double walltime = get_walltime() - start_walltime;
+
+    int exit_code = 2;
+    string status_name = "error";
+    if(timed_out) {
+        exit_code = 137;
+        status_name = "timeout";
+    } else if(status != -1 && WIFEXITED(status)) {
+        exit_code = WEXITSTATUS(status);
+        if(exit_code == 0)
+            status_name = "solved";
+        else if(exit_code == 1)
+            status_name = "unsolved";
+        else if(exit_code == 137)
+            status_name = "timeout";
+        else if(exit_code == EXIT_OUT_OF_MEMORY)
+            status_name = "memout";
+    }
+
+    ostringstream response;
+    response << "status " << status_name << " " << exit_code << "\n";
+    response << "time " << walltime << "\n";
+    vector<string> plan_files;
+    collect_plans(directory, plan_files);
+    response << "plans " << plan_files.size() << "\n";
+    for(int i = 0; i < plan_files.size(); i++) {
+        string plan;
+        read_file(directory + "/" + plan_files[i], plan);
+        response << "plan " << plan.size() << "\n" << plan;
+    }
+    string log;
+    read_file(directory + "/log", log);
+    response << "log " << log.size() << "\n" << log;
+    remove_directory(directory);
+
+    write_frame(connection, response.str());
+}
+
+int run_server(const string &socket_path, const ServerOptions &options)
+{
+    sockaddr_un address;
+    if(!make_address(socket_path, address))
+        return 2;
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0) {
+        perror("socket");
+        return 2;
+    }
+    unlink(socket_path.c_str());
+    if(bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+            || listen(listener, 64) != 0) {
+        perror(socket_path.c_str());
+        close(listener);
+        return 2;
+    }
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+    // The signals are blocked except while waiting for a connection or a
+    // worker, so none of them gets lost between checking for it and
+    // starting to wait. A finished worker (SIGCHLD) ends the wait and is
+    // reaped right away, also while no connection comes in.
+    sigset_t handled_signals, wait_mask;
+    sigemptyset(&handled_signals);
+    sigaddset(&handled_signals, SIGINT);
+    sigaddset(&handled_signals, SIGTERM);
+    sigaddset(&handled_signals, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &handled_signals, &wait_mask);
+    set_signal_handler(SIGINT, request_shutdown);
+    set_signal_handler(SIGTERM, request_shutdown);
+    set_signal_handler(SIGCHLD, ignore_signal);
+    signal(SIGPIPE, SIG_IGN);
+    cout << "Serving on " << socket_path << " with " << options.workers
+        << " worker(s)." << endl;
+
+    int running = 0;
+    while(!shutdown_requested) {
+        while(running > 0 && waitpid(-1, 0, WNOHANG) > 0)
+            running--;
+        if(running >= options.workers) {
+            sigsuspend(&wait_mask);
+            continue;
+        }
+
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(listener, &readable);
+        if(pselect(listener + 1, &readable, 0, 0, 0, &wait_mask) < 0) {
+            if(errno != EINTR)
+                perror("pselect");
+            continue;
+        }
+        int connection = accept(listener, 0, 0);
+        if(connection < 0) {
+            if(errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNABORTED)
+                perror("accept");
+            continue;
+        }
+        cout.flush();
+        pid_t worker = fork();
+        if(worker == 0) {
+            signal(SIGINT, SIG_DFL);
+            signal(SIGTERM, SIG_DFL);
+            signal(SIGCHLD, SIG_DFL);
+            sigprocmask(SIG_SETMASK, &wait_mask, 0);
+            close(listener);
+            handle_connection(connection, options);
+            close(connection);
+            _exit(0);
+        }
+        if(worker < 0)
+            perror("fork");
+        else
+            running++;
+        close(connection);
+    }
+
+    cout << "Shutting down." << endl;
+    close(listener);
+    unlink(socket_path.c_str());
+    while(running > 0 && waitpid(-1, 0, 0) > 0)
+        running--;
+    sigprocmask(SIG_SETMASK, &wait_mask, 0);
+    return 0;
+}
+
+int submit_request(const string &socket_path, const string &options,
+        const string &sas_task)
+{
+    sockaddr_un address;
+    if(!make_address(socket_path, address))
+        return 2;
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(connection < 0
+            || connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        perror(socket_path.c_str());
+        return 2;
+    }
+    string response;
+    if(!write_frame(connection, options + "\n" + sas_task)
+            || !read_frame(connection, response)) {
+        cerr << "No response from " << socket_path << "." << endl;
+        close(connection);
+        return 2;
+    }
+    close(connection);
+    cout << response;
+
+    int exit_code = 2;
+    string status_name;
+    istringstream status_line(response);
+    status_line >> status_name >> status_name >> exit_code;
+    return exit_code;
+}
@@ -0,0 +1,52 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+
+/// Limits of the planner server.
+struct ServerOptions
+{
+    int workers;            ///< maximal number of requests solved in parallel
+    int time_limit;         ///< wall clock seconds per request, 0 for none
+    int memory_limit;       ///< address space MB per request, 0 for none
+
+    ServerOptions() : workers(1), time_limit(0), memory_limit(0)
+    {
+    }
+};
+
+/// Serve planning requests on a Unix domain socket (tfd --server).
+/**
+ * Protocol: each message is a frame consisting of the payload length as
+ * 32 bit unsigned integer in network byte order, followed by the payload.
+ * A client sends one request frame and receives one response frame per
+ * connection.
+ *
+ * Request payload: the search options separated by spaces in the first
+ * line (as on the command line, without "p <plan>"), followed by the
+ * translated task (output.sas).
+ *
+ * Response payload:
+ *   status <solved|unsolved|timeout|memout|error> <exit code>
+ *   time <wall clock seconds>
+ *   plans <number of plans>
+ *   plan <bytes>\n<plan file> (once per plan, the best plan is the last)
+ *   log <bytes>\n<planner output>
+ *
+ * Each request is solved in a process forked from the warm server, not
+ * in a thread on a SearchContext of its own. The search state is per
+ * context, but a request also needs what only a process gives: the
+ * planner output goes to stdout (the log of the response), the memory
+ * limit is a limit of the address space, a request that runs out of
+ * time is killed, and the planner exits on errors in the task. The
+ * server itself only waits for connections, reaps the finished workers
+ * and keeps at most options.workers requests running.
+ * Returns the exit code of tfd.
+ */
+int run_server(const std::string &socket_path, const ServerOptions &options);
+
+/// Send the task and the search options to a server and print its response (tfd --submit).
+int submit_request(const std::string &socket_path, const std::string &options,
+        const std::string &sas_task);
+
+#endif
@@ -2,39 +2,111 @@
 
 #include "axioms.h"
 #include "globals.h"
+#include "instrumentation.h"
 #include "operator.h"
 #include "causal_graph.h"
 #include "plannerParameters.h"
+#include "task_reader.h"
 
 #include <algorithm>
 #include <iostream>
 #include <cassert>
 using namespace std;
 
-TimeStampedState::TimeStampedState(istream &in)
+/// Insert event into the sorted events behind all events that are not greater.
+template<class Event>
+static void insert_event(vector<Event> &events, const Event &event)
 {
+    events.insert(upper_bound(events.begin(), events.end(), event), event);
+}
+
+/// Sort events again after the times of some of them were changed.
+/**
+ * Clamping times to the time stamp can make two times equal. Then the
+ * other fields decide and the events are sorted again.
+ */
+template<class Event>
+static void restore_order(vector<Event> &events)
+{
+    for(int i = 1; i < events.size(); i++) {
+        if(events[i] < events[i - 1]) {
+            sort(events.begin(), events.end());
+            return;
+        }
+    }
+}
+
+/// Drop the events that are due at time, they are a prefix of the sorted events.
+template<class Event>
+static void drop_due_events(vector<Event> &events, double time)
+{
+    int due = 0;
+    while(due < events.size() && events[due].time < time + EPSILON)
+        due++;
+    events.erase(events.begin(), events.begin() + due);
+}
+
+/// Drop the running operators that end at time, keeping the order of the others.
+static void drop_ended_operators(vector<ScheduledOperator> &operators, double time)
+{
+    int kept = 0;
+    for(int i = 0; i < operators.size(); i++) {
+        if(operators[i].time < time + EPSILON)
+            continue;
+        if(kept != i)
+            operators[kept] = operators[i];
+        kept++;
+    }
+    operators.erase(operators.begin() + kept, operators.end());
+}
+
+/// What the progression code for tasks of class tc has to handle.
+template<task_class tc>
+struct TaskClassFeatures
+{
+    static const bool numeric_effects = tc != propositional_task;
+    static const bool conditional_effects = tc != propositional_task;
+    static const bool axioms = tc == general_task;
+};
+
+template<task_class tc>
+inline void TimeStampedState::apply_pre_post(const PrePost &eff, vector<int> &changed_vars)
+{
+    typedef TaskClassFeatures<tc> features;
+    if(!features::numeric_effects)
+        apply_discrete_effect(eff.var, eff.post);
+    else if(!features::axioms)
+        apply_effect(eff.var, eff.fop, eff.var_post, eff.post);
+    else
+        apply_effect(eff.var, eff.fop, eff.var_post, eff.post, changed_vars);
+}
+
+TimeStampedState::TimeStampedState(const SearchContext &c, TaskReader &in) :
+    context(&c)
+{
+    Task &task = c.task;
     check_magic(in, "begin_state");
-    for(int i = 0; i < g_variable_domain.size(); i++) {
+    for(int i = 0; i < task.variable_domain.size(); i++) {
         double var;
-        cin >> var;
+        in >> var;
         state.push_back(var);
     }
     check_magic(in, "end_state");
 
-    g_default_axiom_values = state;
+    task.default_axiom_values = state;
     timestamp = 0.0; // + EPS_TIME;
 
     numberOfEpsInsertions = 0;
 
-    initialize();
+    update_next_happening();
 }
 
 TimeStampedState::TimeStampedState(const TimeStampedState &other) :
         state(other.state), scheduled_effects(other.scheduled_effects),
         conds_over_all(other.conds_over_all), conds_at_end(other.conds_at_end),
-        timestamp(other.timestamp), operators(other.operators), numberOfEpsInsertions(other.numberOfEpsInsertions)
+        timestamp(other.timestamp), operators(other.operators), numberOfEpsInsertions(other.numberOfEpsInsertions),
+        next_happening_time(other.next_happening_time), context(other.context)
 {
-    initialize();
 }
 
 TimeStampedState::TimeStampedState(const TimeStampedState &predecessor,
@@ -43,18 +115,38 @@ TimeStampedState::TimeStampedState(const TimeStampedState &predecessor,
         scheduled_effects(predecessor.scheduled_effects),
         conds_over_all(predecessor.conds_over_all),
         conds_at_end(predecessor.conds_at_end), 
-        operators(predecessor.operators)
+        operators(predecessor.operators), context(predecessor.context)
 {
+    INSTRUMENT_PHASE(context->instrumentation, phase_state_construction);
+    switch(context->task.progression_class) {
+        case propositional_task:
+            start_operator<propositional_task>(predecessor, op);
+            break;
+        case numeric_task:
+            start_operator<numeric_task>(predecessor, op);
+            break;
+        default:
+            start_operator<general_task>(predecessor, op);
+            break;
+    }
+}
+
+template<task_class tc>
+void TimeStampedState::start_operator(const TimeStampedState &predecessor, const Operator &op)
+{
+    typedef TaskClassFeatures<tc> features;
+
 	// FIXME: The effects between now and now + sep can 
     // happen at different timestamps. So, to implement this method 
     // correctly, we have to apply and check the effects in the correct 
     // order (and also check effect conditions in the intermediate steps).
     // This is analogous to the problem in let_time_pass.
 
-    double sep = (g_parameters.epsilonize_internally ? EPS_TIME : 0.0);
+    bool epsilonize_internally = context->parameters.epsilonize_internally;
+    double sep = (epsilonize_internally ? EPS_TIME : 0.0);
 
     numberOfEpsInsertions = predecessor.numberOfEpsInsertions;
-    if(g_parameters.epsilonize_internally) {
+    if(epsilonize_internally) {
         numberOfEpsInsertions++;
     }
 
@@ -62,34 +154,40 @@ TimeStampedState::TimeStampedState(const TimeStampedState &predecessor,
 
     // compute duration
     double duration = op.get_duration(&predecessor);
+    double end_time = predecessor.timestamp + duration;
+
+    // The values of the new state are obtained by applying all
+    // effects scheduled in the predecessor state until the new time
+    // stamp and subsequently applying axioms (only to the variables
+    // changed by the effects, the predecessor is evaluated). The due
+    // effects are a prefix of the sorted scheduled effects.
+    vector<int> changed_vars;
+    int due = 0;
+    while(due < scheduled_effects.size() &&
+            scheduled_effects[due].time + EPSILON < timestamp) {
+        const PrePost &eff = *scheduled_effects[due].effect;
+        if(!features::conditional_effects || satisfies(eff.cond_end))
+            apply_pre_post<tc>(eff, changed_vars);
+        due++;
+    }
+    scheduled_effects.erase(scheduled_effects.begin(), scheduled_effects.begin() + due);
 
     // The scheduled effects of the new state are precisely the
     // scheduled effects of the predecessor state plus those at-end
     // effects of the given operator whose at-start conditions are
-    // satisfied.
-    for(int i = 0; i < op.get_pre_post_end().size(); i++) {
-        const PrePost &eff = op.get_pre_post_end()[i];
-        if(eff.does_fire(predecessor)) {
-            scheduled_effects.push_back(ScheduledEffect(duration, eff));
-        }
-    }
-
-    // The values of the new state are obtained by applying all
-    // effects scheduled in the predecessor state until the new time
-    // stamp and subsequently applying axioms
-    for(int i = 0; i < scheduled_effects.size(); i++) {
-        ScheduledEffect &eff = scheduled_effects[i];
-        if((eff.time_increment + EPSILON < sep) &&
-                         satisfies(eff.cond_end)) {
-            apply_effect(eff.var, eff.fop, eff.var_post, eff.post);
-        }
-        if(eff.time_increment + EPSILON < sep) {
-            scheduled_effects.erase(scheduled_effects.begin() + i);
-            i--;
+    // satisfied (handled after the old ones, as they were added later).
+    for(int i = 0; i < op.get_end_effects().size(); i++) {
+        const PrePost &eff = *op.get_end_effects()[i];
+        if(features::conditional_effects && !eff.does_fire(predecessor))
+            continue;
+        if(duration + EPSILON < sep) {
+            if(!features::conditional_effects || satisfies(eff.cond_end))
+                apply_pre_post<tc>(eff, changed_vars);
         } else {
-            eff.time_increment -= sep;
+            insert_event(scheduled_effects, ScheduledEffect(end_time, &eff));
         }
     }
+
     // Update values affected by an at-start effect of the operator.
     for(int i = 0; i < op.get_pre_post_start().size(); i++) {
         const PrePost &pre_post = op.get_pre_post_start()[i];
@@ -97,66 +195,47 @@ TimeStampedState::TimeStampedState(const TimeStampedState &predecessor,
         // at-start effects may not have any at-end conditions
         assert(pre_post.cond_end.size() == 0);
 
-        if(pre_post.does_fire(predecessor)) {
-            apply_effect(pre_post.var, pre_post.fop, pre_post.var_post,
-                    pre_post.post);
-        }
+        if(!features::conditional_effects || pre_post.does_fire(predecessor))
+            apply_pre_post<tc>(pre_post, changed_vars);
     }
 
-    g_axiom_evaluator->evaluate(*this);
+    if(features::axioms)
+        context->task.axiom_evaluator->evaluate(*this, changed_vars);
 
     // The persistent over-all conditions of the new state are
     // precisely the persistent over-all conditions of the predecessor
-    // state plus the over-all conditions of the newly added operator
+    // state plus the over-all conditions of the newly added operator,
+    // except those that end now
     for(int i = 0; i < op.get_prevail_overall().size(); i++) {
-        conds_over_all.push_back(ScheduledCondition(duration,
+        insert_event(conds_over_all, ScheduledCondition(end_time,
                     op.get_prevail_overall()[i]));
     }
-    for(int i = 0; i < conds_over_all.size(); i++) {
-        ScheduledCondition &cond = conds_over_all[i];
-        double decrement = min(cond.time_increment,sep);
-        cond.time_increment -= decrement;
-        if(double_equals(cond.time_increment, 0.0)) {
-            conds_over_all.erase(conds_over_all.begin() + i);
-            i--;
-        }
-    }
+    drop_due_events(conds_over_all, timestamp);
 
     // The persistent at-end conditions of the new state are
     // precisely the persistent at-end conditions of the predecessor
     // state plus the at-end conditions of the newly added operator
+    // (those that ended before the new time stamp end now)
     for(int i = 0; i < op.get_prevail_end().size(); i++) {
-        conds_at_end.push_back(ScheduledCondition(duration, op.get_prevail_end()[i]));
+        insert_event(conds_at_end, ScheduledCondition(end_time, op.get_prevail_end()[i]));
     }
-    for(int i = 0; i < conds_at_end.size(); i++) {
-        ScheduledCondition &cond = conds_at_end[i];
-        double decrement = min(cond.time_increment,sep);
-        cond.time_increment -= decrement;
-        if(cond.time_increment < 0) {
-            conds_at_end.erase(conds_at_end.begin() + i);
-            i--;
-        }
+    if(sep != 0.0) {
+        for(int i = 0; i < conds_at_end.size() && conds_at_end[i].time < timestamp; i++)
+            conds_at_end[i].time = timestamp;
+        restore_order(conds_at_end);
     }
 
     // The running operators of the new state are precisely
     // the running operators of the predecessor state plus the newly
-    // added operator
-    operators.push_back(ScheduledOperator(duration, op));
-    for(int i = 0; i < operators.size(); i++) {
-        ScheduledOperator &op = operators[i];
-        double decrement = min(op.time_increment,sep);
-        op.time_increment -= decrement;
-        if(double_equals(op.time_increment, 0) || op.time_increment <= 0) {
-            operators.erase(operators.begin() + i);
-            i--;
-        }
-    }
+    // added operator, except those that end now
+    operators.push_back(ScheduledOperator(end_time, op));
+    drop_ended_operators(operators, timestamp);
 
     // timestamp += EPS_TIME;
     // FIXME: time increments aller Komponenten des Zustands anpassen
     // assert(!double_equals(timestamp, next_happening()));
 
-    initialize();
+    update_next_happening();
 }
 
 int TimeStampedState::getNumberOfEpsTimeSteps(double offset) const {
@@ -165,7 +244,7 @@ int TimeStampedState::getNumberOfEpsTimeSteps(double offset) const {
     while(recheck) {
         recheck = false;
         for(unsigned int i = 0; i < operators.size(); ++i) {
-            double increment = operators[i].time_increment-offset;
+            double increment = time_increment(operators[i]) - offset;
             if(double_equals(increment,ret*EPS_TIME+EPS_TIME)) {
                 ret++;
                 recheck = true;
@@ -180,6 +259,25 @@ int TimeStampedState::getNumberOfEpsTimeSteps(double offset) const {
 TimeStampedState TimeStampedState::let_time_pass(
                                                  bool go_to_intermediate_between_now_and_next_happening,
     bool skip_eps_steps) const {
+    INSTRUMENT_PHASE(context->instrumentation, phase_state_construction);
+    switch(context->task.progression_class) {
+        case propositional_task:
+            return pass_time<propositional_task>(
+                    go_to_intermediate_between_now_and_next_happening, skip_eps_steps);
+        case numeric_task:
+            return pass_time<numeric_task>(
+                    go_to_intermediate_between_now_and_next_happening, skip_eps_steps);
+        default:
+            return pass_time<general_task>(
+                    go_to_intermediate_between_now_and_next_happening, skip_eps_steps);
+    }
+}
+
+template<task_class tc>
+TimeStampedState TimeStampedState::pass_time(
+    bool go_to_intermediate_between_now_and_next_happening,
+    bool skip_eps_steps) const {
+    typedef TaskClassFeatures<tc> features;
 
 	// FIXME: If we do not go to the intermediate between now and the 
     // next happening but epsilonize internally, the effects can 
@@ -208,161 +306,165 @@ TimeStampedState TimeStampedState::let_time_pass(
 
     double time_diff = succ.timestamp - timestamp;
 
-    if(skip_eps_steps && g_parameters.epsilonize_internally && !go_to_intermediate_between_now_and_next_happening) {
+    if(skip_eps_steps && context->parameters.epsilonize_internally
+            && !go_to_intermediate_between_now_and_next_happening) {
         double additional_time_diff = (getNumberOfEpsTimeSteps(nh-timestamp)+1) * EPS_TIME;
         time_diff += additional_time_diff;
         succ.timestamp += additional_time_diff;
     }
 
+    // Going to the intermediate time point only moves the time stamp.
     if(!go_to_intermediate_between_now_and_next_happening) {
         // The values of the new state are obtained by applying all
         // effects scheduled in the predecessor state for the new time
-        // stamp and subsequently applying axioms
-        for(int i = 0; i < scheduled_effects.size(); i++) {
-            const ScheduledEffect &eff = scheduled_effects[i];
-            if((eff.time_increment < time_diff+EPSILON) &&
-                succ.satisfies(eff.cond_end)) {
-                succ.apply_effect(eff.var, eff.fop, eff.var_post, eff.post);
-            }
+        // stamp (a prefix of the sorted effects) and subsequently
+        // applying axioms
+        vector<int> changed_vars;
+        for(int i = 0; i < scheduled_effects.size() &&
+                scheduled_effects[i].time < succ.timestamp + EPSILON; i++) {
+            const PrePost &eff = *scheduled_effects[i].effect;
+            if(!features::conditional_effects || succ.satisfies(eff.cond_end))
+                succ.apply_pre_post<tc>(eff, changed_vars);
         }
-        g_axiom_evaluator->evaluate(succ);
-    }
-
-    // The scheduled effects of the new state are precisely the
-    // scheduled effects of the predecessor state minus those
-    // whose scheduled time point has been reached and minus those
-    // whose over-all condition is violated.
-    for(int i = 0; i < succ.scheduled_effects.size(); i++) {
-        succ.scheduled_effects[i].time_increment -= time_diff;
-    }
-    if(!go_to_intermediate_between_now_and_next_happening) {
-        for(int i = 0; i < succ.scheduled_effects.size(); i++) {
-            const ScheduledEffect &eff = succ.scheduled_effects[i];
-            if((eff.time_increment < EPSILON) ||
-                    !succ.satisfies(eff.cond_overall)) {
-                succ.scheduled_effects.erase(succ.scheduled_effects.begin() + i);
-                i--;
+        if(features::axioms)
+            context->task.axiom_evaluator->evaluate(succ, changed_vars);
+
+        // The scheduled effects of the new state are precisely the
+        // scheduled effects of the predecessor state minus those
+        // whose scheduled time point has been reached and minus those
+        // whose over-all condition is violated.
+        drop_due_events(succ.scheduled_effects, succ.timestamp);
+        if(features::conditional_effects) {
+            int kept = 0;
+            for(int i = 0; i < succ.scheduled_effects.size(); i++) {
+                const ScheduledEffect &eff = succ.scheduled_effects[i];
+                if(!succ.satisfies(eff.effect->cond_overall))
+                    continue;
+                if(kept != i)
+                    succ.scheduled_effects[kept] = eff;
+                kept++;
             }
+            succ.scheduled_effects.erase(succ.scheduled_effects.begin() + kept,
+                    succ.scheduled_effects.end());
         }
-    }
 
-    // The persistent over-all conditions of the new state are
-    // precisely those persistent over-all conditions of the predecessor
-    // state whose end time-point is properly in the future (not now)
-    for(int i = 0; i < succ.conds_over_all.size(); i++) {
-        succ.conds_over_all[i].time_increment -= time_diff;
-    }
-    if(!go_to_intermediate_between_now_and_next_happening) {
-        for(int i = 0; i < succ.conds_over_all.size(); i++) {
-            const ScheduledCondition &cond = succ.conds_over_all[i];
-            if((cond.time_increment < EPSILON)) {
-                succ.conds_over_all.erase(succ.conds_over_all.begin() + i);
-                i--;
-            }
-        }
-    }
+        // The persistent over-all conditions of the new state are
+        // precisely those persistent over-all conditions of the predecessor
+        // state whose end time-point is properly in the future (not now)
+        drop_due_events(succ.conds_over_all, succ.timestamp);
 
-    // The persistent at-end conditions of the new state are
-    // precisely those persistent at-end conditions of the predecessor
-    // state whose end time-point is in the future
-    for(int i = 0; i < succ.conds_at_end.size(); i++) {
-        succ.conds_at_end[i].time_increment -= time_diff;
-    }
-    if(!go_to_intermediate_between_now_and_next_happening) {
-        for(int i = 0; i < succ.conds_at_end.size(); i++) {
-            const ScheduledCondition &cond = succ.conds_at_end[i];
-            if(cond.time_increment < EPSILON) {
-                succ.conds_at_end.erase(succ.conds_at_end.begin() + i);
-                i--;
-            }
-        }
-    }
+        // The persistent at-end conditions of the new state are
+        // precisely those persistent at-end conditions of the predecessor
+        // state whose end time-point is in the future
+        drop_due_events(succ.conds_at_end, succ.timestamp);
 
-    // The running operators of the new state are precisely those
-    // running operators of the predecessor state whose end time-point
-    // is in the future
-    for(int i = 0; i < succ.operators.size(); i++) {
-        succ.operators[i].time_increment -= time_diff;
-    }
-    if(!go_to_intermediate_between_now_and_next_happening) {
-        for(int i = 0; i < succ.operators.size(); i++) {
-            const ScheduledOperator &op = succ.operators[i];
-            if((op.time_increment < EPSILON) || op.time_increment <= 0) {
-                succ.operators.erase(succ.operators.begin() + i);
-                i--;
-            }
-            }
+        // The running operators of the new state are precisely those
+        // running operators of the predecessor state whose end time-point
+        // is in the future
+        drop_ended_operators(succ.operators, succ.timestamp);
     }
 
-    succ.initialize();
+    succ.update_next_happening();
 
     return succ;
 }
 
-double TimeStampedState::next_happening() const
+void TimeStampedState::update_next_happening()
 {
     double result = REALLYBIG;
     for(int i = 0; i < operators.size(); i++)
-        if(operators[i].time_increment > 0)
-            result = min(result, operators[i].time_increment);
+        if(operators[i].time > timestamp)
+            result = min(result, operators[i].time);
     if(double_equals(result, REALLYBIG))
-        result = 0.0;
-    return result + timestamp;
+        result = timestamp;
+    next_happening_time = result;
+}
+
+void TimeStampedState::shift_time(double diff)
+{
+    timestamp += diff;
+    next_happening_time += diff;
+    for(int i = 0; i < scheduled_effects.size(); i++)
+        scheduled_effects[i].time += diff;
+    for(int i = 0; i < conds_over_all.size(); i++)
+        conds_over_all[i].time += diff;
+    for(int i = 0; i < conds_at_end.size(); i++)
+        conds_at_end[i].time += diff;
+    for(int i = 0; i < operators.size(); i++)
+        operators[i].time += diff;
 }
 
 void TimeStampedState::dump(bool verbose) const
 {
+    const Task &task = get_task();
     cout << "State (Timestamp: " << timestamp << ")" << endl;
     if(verbose) {
         cout << " logical state:" << endl;
         for(int i = 0; i < state.size(); i++)
-            cout << "  " << g_variable_name[i] << ": " << state[i] << "    " << endl;
+            cout << "  " << task.variable_name[i] << ": " << state[i] << "    " << endl;
         cout << " scheduled effects:" << endl;
         for(int i = 0; i < scheduled_effects.size(); i++) {
-            cout << "  <" << (scheduled_effects[i].time_increment + timestamp) << ",<";
-            for(int j = 0; j < scheduled_effects[i].cond_overall.size(); j++) {
-                cout << g_variable_name[scheduled_effects[i].cond_overall[j].var]
-                    << ": " << scheduled_effects[i].cond_overall[j].prev;
+            const PrePost &eff = *scheduled_effects[i].effect;
+            cout << "  <" << scheduled_effects[i].time << ",<";
+            for(int j = 0; j < eff.cond_overall.size(); j++) {
+                cout << task.variable_name[eff.cond_overall[j].var]
+                    << ": " << eff.cond_overall[j].prev;
             }
             cout << ">,<";
-            for(int j = 0; j < scheduled_effects[i].cond_end.size(); j++) {
-                cout << g_variable_name[scheduled_effects[i].cond_end[j].var]
-                    << ": " << scheduled_effects[i].cond_end[j].prev;
+            for(int j = 0; j < eff.cond_end.size(); j++) {
+                cout << task.variable_name[eff.cond_end[j].var]
+                    << ": " << eff.cond_end[j].prev;
             }
             cout << ">,<";
-            cout << g_variable_name[scheduled_effects[i].var] << " ";
-            if(is_functional(scheduled_effects[i].var)) {
-                cout << scheduled_effects[i].fop << " ";
-                cout << g_variable_name[scheduled_effects[i].var_post] << ">>" << endl;
+            cout << task.variable_name[eff.var] << " ";
+            if(task.is_functional(eff.var)) {
+                cout << eff.fop << " ";
+                cout << task.variable_name[eff.var_post] << ">>" << endl;
             } else {
                 cout << ":= ";
-                cout << scheduled_effects[i].post << ">>" << endl;
+                cout << eff.post << ">>" << endl;
             }
         }
         cout << " persistent over-all conditions:" << endl;
         for(int i = 0; i < conds_over_all.size(); i++) {
-            cout << "  <" << (conds_over_all[i].time_increment + timestamp) << ",<";
-            cout << g_variable_name[conds_over_all[i].var] << ":"
+            cout << "  <" << conds_over_all[i].time << ",<";
+            cout << task.variable_name[conds_over_all[i].var] << ":"
                 << conds_over_all[i].prev << ">>" << endl;
         }
         cout << " persistent at-end conditions:" << endl;
         for(int i = 0; i < conds_at_end.size(); i++) {
-            cout << "  <" << (conds_at_end[i].time_increment + timestamp) << ",<";
-            cout << g_variable_name[conds_at_end[i].var] << ":"
+            cout << "  <" << conds_at_end[i].time << ",<";
+            cout << task.variable_name[conds_at_end[i].var] << ":"
                 << conds_at_end[i].prev << ">>" << endl;
         }
         cout << " running operators:" << endl;
         for(int i = 0; i < operators.size(); i++) {
-            cout << "  <" << (operators[i].time_increment + timestamp) << ",<";
+            cout << "  <" << operators[i].time << ",<";
             cout << operators[i].get_name() << ">>" << endl;
         }
     }
 }
 
+ScheduledEffect::ScheduledEffect(double t, EffectPool &pool, vector<Prevail> &cas,
+        vector<Prevail> &coa, vector<Prevail> &cae, int va, int vi, assignment_op op) :
+    time(t),
+    effect(pool.intern(PrePost(va, -1.0, vi, -1.0, cas, coa, cae, op)))
+{
+}
+
+const PrePost *EffectPool::intern(const PrePost &effect)
+{
+    PrePost sorted(effect);
+    sort(sorted.cond_start.begin(), sorted.cond_start.end());
+    sort(sorted.cond_overall.begin(), sorted.cond_overall.end());
+    sort(sorted.cond_end.begin(), sorted.cond_end.end());
+    // elements of a set are never moved, so the pointer stays valid
+    return &*effects.insert(sorted).first;
+}
+
 void TimeStampedState::scheduleEffect(ScheduledEffect effect)
 {
-    scheduled_effects.push_back(effect);
-    sort(scheduled_effects.begin(), scheduled_effects.end());
+    insert_event(scheduled_effects, effect);
 }
 
 bool TimeStampedState::is_consistent_now() const
@@ -375,7 +477,7 @@ bool TimeStampedState::is_consistent_now() const
     // Persistent at-end conditions must be satisfied
     // if their end time point is now
     for(int i = 0; i < conds_at_end.size(); i++)
-        if(double_equals(conds_at_end[i].time_increment, 0) &&
+        if(double_equals(time_increment(conds_at_end[i]), 0) &&
             !satisfies(conds_at_end[i]))
             return false;
 
@@ -385,6 +487,7 @@ bool TimeStampedState::is_consistent_now() const
 
 bool TimeStampedState::is_consistent_when_progressed(TimedSymbolicStates* timedSymbolicStates) const
 {
+    INSTRUMENT_PHASE(context->instrumentation, phase_consistency_check);
     double last_time = -1.0;
     double current_time = timestamp;
     TimeStampedState current_progression(*this);
@@ -403,7 +506,8 @@ bool TimeStampedState::is_consistent_when_progressed(TimedSymbolicStates* timedS
         if(!go_to_intermediate && timedSymbolicStates != NULL) {
             timedSymbolicStates->push_back(make_pair(vector<double> (), current_progression.timestamp));
             for(int i = 0; i < current_progression.state.size(); ++i) {
-                if(g_variable_types[i] == primitive_functional || g_variable_types[i] == logical) {
+                const variable_type &type = context->task.variable_types[i];
+                if(type == primitive_functional || type == logical) {
                     timedSymbolicStates->back().first.push_back(current_progression.state[i]);
                 }
             }
@@ -418,7 +522,8 @@ TimeStampedState &buildTestState(TimeStampedState &state)
     vector<Prevail> cas;
     vector<Prevail> coa;
     vector<Prevail> cae;
-    state.scheduleEffect(ScheduledEffect(1.0, cas, coa, cae, 11, 0, increase));
-    state.scheduleEffect(ScheduledEffect(1.0, cas, coa, cae, 9, 0, assign));
+    EffectPool &pool = *state.get_task().effect_pool;
+    state.scheduleEffect(ScheduledEffect(1.0, pool, cas, coa, cae, 11, 0, increase));
+    state.scheduleEffect(ScheduledEffect(1.0, pool, cas, coa, cae, 9, 0, assign));
     return state;
 }
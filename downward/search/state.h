@@ -16,7 +16,7 @@ struct Prevail
 {
     int var;
     double prev;
-    Prevail(istream &in);
+    Prevail(TaskReader &in);
     Prevail(int v, double p) :
         var(v), prev(p)
     {
@@ -27,7 +27,7 @@ struct Prevail
 
     bool is_applicable(const TimeStampedState & state) const;
 
-    void dump() const;
+    void dump(const Task &task) const;
 
     bool operator<(const Prevail &other) const {
         if(var < other.var)
@@ -52,7 +52,7 @@ struct PrePost
     PrePost()
     {
     } // Needed for axiom file-reading constructor, unfortunately.
-    PrePost(std::istream &in);
+    PrePost(TaskReader &in, const Task &task);
     PrePost(int v, double pr, int vpo, double po, const std::vector<Prevail> &co_start,
             const std::vector<Prevail> &co_oa,
             const std::vector<Prevail> &co_end, assignment_op fo = assign) :
@@ -72,38 +72,10 @@ struct PrePost
         return true;
     }
 
-    void dump() const;
-};
+    void dump(const Task &task) const;
 
-struct ScheduledEffect : public PrePost
-{
-    double time_increment;
-    ScheduledEffect(double t, vector<Prevail> &cas, vector<Prevail> &coa, vector<Prevail> &cae,
-        int va, int vi, assignment_op op) :
-        PrePost(va, -1.0, vi, -1.0, cas, coa, cae, op), time_increment(t)
-    {
-        initialize();
-    }
-    ScheduledEffect(double t, const PrePost& pp) : PrePost(pp), time_increment(t)
-    {
-        initialize();
-    }
-    void initialize()
+    bool operator<(const PrePost &other) const
     {
-        sort(cond_start.begin(), cond_start.end());
-        sort(cond_overall.begin(), cond_overall.end());
-        sort(cond_end.begin(), cond_end.end());
-    }
-    void dump() const {
-        cout << time_increment << ": ";
-        PrePost::dump();
-    }
-    bool operator<(const ScheduledEffect &other) const
-    {
-        if(time_increment < other.time_increment)
-            return true;
-        if(time_increment > other.time_increment)
-            return false;
         if(var < other.var)
             return true;
         if(var > other.var)
@@ -158,21 +130,62 @@ struct ScheduledEffect : public PrePost
     }
 };
 
+/// Effect of a running operator that is scheduled at the end of the operator.
+/**
+ * The effect and its conditions never change once it is scheduled, so
+ * they are interned once per task in the EffectPool and scheduled effects
+ * only refer to them. Copying a state copies the time and a pointer for
+ * each scheduled effect.
+ */
+struct ScheduledEffect
+{
+    double time;            ///< absolute time point of the effect
+    const PrePost *effect;  ///< interned in the effect_pool of the task
+
+    ScheduledEffect(double t, const PrePost *eff) :
+        time(t), effect(eff)
+    {
+    }
+    ScheduledEffect(double t, EffectPool &pool, vector<Prevail> &cas, vector<Prevail> &coa,
+        vector<Prevail> &cae, int va, int vi, assignment_op op);
+    void dump(const Task &task) const {
+        cout << time << ": ";
+        effect->dump(task);
+    }
+    bool operator<(const ScheduledEffect &other) const
+    {
+        if(time < other.time)
+            return true;
+        if(time > other.time)
+            return false;
+        return effect != other.effect && *effect < *other.effect;
+    }
+};
+
+/// The interned effects of the scheduled effects of a task.
+class EffectPool
+{
+    set<PrePost> effects;
+    public:
+        /// Return the shared copy of effect, with its conditions sorted.
+        const PrePost *intern(const PrePost &effect);
+};
+
 struct ScheduledCondition : public Prevail
 {
-    double time_increment;
+    double time;    ///< absolute end time point of the condition
     ScheduledCondition(double t, int v, double p) :
-        Prevail(v, p), time_increment(t)
+        Prevail(v, p), time(t)
     {
     }
-    ScheduledCondition(double t, const Prevail &prev) : Prevail(prev), time_increment(t)
+    ScheduledCondition(double t, const Prevail &prev) : Prevail(prev), time(t)
     {
     }
     bool operator<(const ScheduledCondition &other) const
     {
-        if(time_increment < other.time_increment)
+        if(time < other.time)
             return true;
-        if(time_increment > other.time_increment)
+        if(time > other.time)
             return false;
         if(var < other.var)
             return true;
@@ -249,32 +262,60 @@ class TimeStampedState
 
         void apply_effect(int lhs, assignment_op op, int rhs, double post)
         {
-            if(is_functional(lhs)) {
+            if(context->task.is_functional(lhs)) {
                 apply_numeric_effect(lhs, op, rhs);
             } else {
                 apply_discrete_effect(lhs, post);
             }
         }
 
-        void initialize()
+        /// Apply the effect and add lhs to changed_vars if its value changes.
+        void apply_effect(int lhs, assignment_op op, int rhs, double post,
+                vector<int> &changed_vars)
         {
-            sort(scheduled_effects.begin(), scheduled_effects.end());
-            sort(conds_over_all.begin(), conds_over_all.end());
-            sort(conds_at_end.begin(), conds_at_end.end());
+            double old_value = state[lhs];
+            apply_effect(lhs, op, rhs, post);
+            if(state[lhs] != old_value)
+                changed_vars.push_back(lhs);
         }
 
+        /// Set next_happening_time from the running operators.
+        void update_next_happening();
+
+        // Progression for tasks of class tc, which the constructor and
+        // let_time_pass select by the class of the task: the code for simpler
+        // classes skips the checks for features the task does not have.
+
+        /// Apply the effect eff, record changed variables for the axioms.
+        template<task_class tc>
+        void apply_pre_post(const PrePost &eff, vector<int> &changed_vars);
+        /// Body of TimeStampedState(predecessor, op).
+        template<task_class tc>
+        void start_operator(const TimeStampedState &predecessor, const Operator &op);
+        /// Body of let_time_pass.
+        template<task_class tc>
+        TimeStampedState pass_time(bool go_to_intermediate_between_now_and_next_happening,
+                bool skip_eps_steps) const;
+
     public:
         vector<double> state;
+        // The scheduled effects and conditions form the timeline of the
+        // state: each vector is kept sorted (by operator<, so by time
+        // first). Events store absolute time points, so letting time pass
+        // only moves the time stamp and drops the due events, which are a
+        // prefix of each vector. Everything that compares schedules of
+        // states (or uses the time left) uses time_increment().
         vector<ScheduledEffect> scheduled_effects;
         vector<ScheduledCondition> conds_over_all;
         vector<ScheduledCondition> conds_at_end;
 
         double timestamp;
-        vector<ScheduledOperator> operators;
+        vector<ScheduledOperator> operators;    ///< running operators in the order they were started
 
         int numberOfEpsInsertions;
 
-        TimeStampedState(istream &in);
+        /// Read the initial state of the task of context.
+        TimeStampedState(const SearchContext &context, TaskReader &in);
         // clone a state
         TimeStampedState(const TimeStampedState &other);
         // apply an operator
@@ -297,7 +338,21 @@ class TimeStampedState
 
         void scheduleEffect(ScheduledEffect effect);
 
-        double next_happening() const;
+        /// Time from the time stamp to the time point of event.
+        template<class Event>
+        double time_increment(const Event &event) const
+        {
+            return event.time - timestamp;
+        }
+
+        /// Move the time stamp and all events by diff.
+        void shift_time(double diff);
+
+        /// Time stamp of the next end of a running operator, the time stamp if none runs.
+        double next_happening() const
+        {
+            return next_happening_time;
+        }
 
         bool is_consistent_now() const;
         bool is_consistent_when_progressed(TimedSymbolicStates* timedSymbolicStates = NULL) const;
@@ -314,6 +369,21 @@ class TimeStampedState
                     return false;
             return true;
         }
+
+        /// The context the task of the state was read in.
+        const SearchContext &get_context() const
+        {
+            return *context;
+        }
+        const Task &get_task() const
+        {
+            return context->task;
+        }
+
+    private:
+        /// Time stamp of the next end of a running operator (see next_happening).
+        double next_happening_time;
+        const SearchContext *context;
 };
 
 TimeStampedState &buildTestState(TimeStampedState &state);
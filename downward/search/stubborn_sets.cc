@@ -0,0 +1,301 @@
+#include "stubborn_sets.h"
+
+#include "axioms.h"
+#include "operator.h"
+#include "state.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+static void sort_unique(vector<int> &vec)
+{
+    sort(vec.begin(), vec.end());
+    vec.erase(unique(vec.begin(), vec.end()), vec.end());
+}
+
+StubbornSets::StubbornSets(const Task &task) :
+        task(task), num_calls(0), num_operators_before(0), num_operators_after(0)
+{
+    int num_vars = task.variable_domain.size();
+    int num_ops = task.operators.size();
+
+    // direct dependencies of derived variables
+    vector<vector<int> > axiom_deps(num_vars);
+    vector<bool> derived(num_vars, false);
+    for(int i = 0; i < task.axioms.size(); ++i) {
+        int var = task.axioms[i]->affected_variable;
+        derived[var] = true;
+        if(task.variable_types[var] == logical) {
+            const LogicAxiom *ax = static_cast<const LogicAxiom *>(task.axioms[i]);
+            for(int j = 0; j < ax->prevail.size(); ++j)
+                axiom_deps[var].push_back(ax->prevail[j].var);
+        } else {
+            const NumericAxiom *ax = static_cast<const NumericAxiom *>(task.axioms[i]);
+            axiom_deps[var].push_back(ax->var_lhs);
+            axiom_deps[var].push_back(ax->var_rhs);
+        }
+    }
+
+    // transitive closure to non-derived variables
+    base_vars.resize(num_vars);
+    for(int var = 0; var < num_vars; ++var) {
+        if(!derived[var]) {
+            base_vars[var].push_back(var);
+            continue;
+        }
+        vector<bool> visited(num_vars, false);
+        vector<int> open(1, var);
+        visited[var] = true;
+        while(!open.empty()) {
+            int current = open.back();
+            open.pop_back();
+            if(!derived[current]) {
+                base_vars[var].push_back(current);
+                continue;
+            }
+            for(int j = 0; j < axiom_deps[current].size(); ++j) {
+                int dep = axiom_deps[current][j];
+                if(dep >= 0 && !visited[dep]) {
+                    visited[dep] = true;
+                    open.push_back(dep);
+                }
+            }
+        }
+        sort_unique(base_vars[var]);
+    }
+
+    reads.resize(num_ops);
+    writes.resize(num_ops);
+    readers_of.resize(num_vars);
+    writers_of.resize(num_vars);
+    achievers.resize(num_vars);
+    for(int var = 0; var < num_vars; ++var) {
+        if(!task.is_functional(var) && task.variable_domain[var] > 0)
+            achievers[var].resize(task.variable_domain[var]);
+    }
+
+    for(int op_no = 0; op_no < num_ops; ++op_no) {
+        const Operator &op = task.operators[op_no];
+        vector<int> &op_reads = reads[op_no];
+        vector<int> &op_writes = writes[op_no];
+
+        const vector<Prevail> *prevails[3] = { &op.get_prevail_start(),
+            &op.get_prevail_overall(), &op.get_prevail_end() };
+        for(int k = 0; k < 3; ++k) {
+            for(int j = 0; j < prevails[k]->size(); ++j)
+                add_var_closure((*prevails[k])[j].var, op_reads);
+        }
+        if(op.get_duration_var() >= 0)
+            add_var_closure(op.get_duration_var(), op_reads);
+
+        const vector<PrePost> *pre_posts[2] = { &op.get_pre_post_start(),
+            &op.get_pre_post_end() };
+        for(int k = 0; k < 2; ++k) {
+            for(int j = 0; j < pre_posts[k]->size(); ++j) {
+                const PrePost &pp = (*pre_posts[k])[j];
+                op_writes.push_back(pp.var);
+                if(pp.pre != -1)
+                    add_var_closure(pp.var, op_reads);
+                if(task.is_functional(pp.var)) {
+                    // numeric effects read their own variable and the argument
+                    add_var_closure(pp.var, op_reads);
+                    if(pp.var_post >= 0)
+                        add_var_closure(pp.var_post, op_reads);
+                } else {
+                    int post = static_cast<int>(pp.post);
+                    if(post >= 0 && post < achievers[pp.var].size())
+                        achievers[pp.var][post].push_back(op_no);
+                }
+                const vector<Prevail> *conds[3] = { &pp.cond_start,
+                    &pp.cond_overall, &pp.cond_end };
+                for(int c = 0; c < 3; ++c) {
+                    for(int l = 0; l < conds[c]->size(); ++l)
+                        add_var_closure((*conds[c])[l].var, op_reads);
+                }
+            }
+        }
+        sort_unique(op_reads);
+        sort_unique(op_writes);
+        for(int j = 0; j < op_reads.size(); ++j)
+            readers_of[op_reads[j]].push_back(op_no);
+        for(int j = 0; j < op_writes.size(); ++j)
+            writers_of[op_writes[j]].push_back(op_no);
+    }
+    for(int var = 0; var < num_vars; ++var) {
+        for(int val = 0; val < achievers[var].size(); ++val)
+            sort_unique(achievers[var][val]);
+    }
+
+    in_stubborn_set.resize(num_ops, false);
+    applicable_mark.resize(num_ops, -1);
+}
+
+void StubbornSets::add_var_closure(int var, vector<int> &vars) const
+{
+    assert(var >= 0 && var < base_vars.size());
+    vars.insert(vars.end(), base_vars[var].begin(), base_vars[var].end());
+}
+
+int StubbornSets::get_op_index(const Operator *op) const
+{
+    int op_no = op - &task.operators[0];
+    assert(op_no >= 0 && op_no < task.operators.size());
+    return op_no;
+}
+
+void StubbornSets::add_to_stubborn_set(int op_no)
+{
+    if(!in_stubborn_set[op_no]) {
+        in_stubborn_set[op_no] = true;
+        queue.push_back(op_no);
+        touched.push_back(op_no);
+    }
+}
+
+void StubbornSets::add_interfering(int op_no)
+{
+    const vector<int> &op_writes = writes[op_no];
+    for(int i = 0; i < op_writes.size(); ++i) {
+        int var = op_writes[i];
+        for(int j = 0; j < readers_of[var].size(); ++j)
+            add_to_stubborn_set(readers_of[var][j]);
+        for(int j = 0; j < writers_of[var].size(); ++j)
+            add_to_stubborn_set(writers_of[var][j]);
+    }
+    const vector<int> &op_reads = reads[op_no];
+    for(int i = 0; i < op_reads.size(); ++i) {
+        int var = op_reads[i];
+        for(int j = 0; j < writers_of[var].size(); ++j)
+            add_to_stubborn_set(writers_of[var][j]);
+    }
+}
+
+void StubbornSets::add_achievers(int var, double value)
+{
+    if(base_vars[var].size() != 1 || base_vars[var][0] != var || task.is_functional(var)) {
+        // derived or numeric: anything writing a variable it depends on
+        for(int i = 0; i < base_vars[var].size(); ++i) {
+            const vector<int> &writers = writers_of[base_vars[var][i]];
+            for(int j = 0; j < writers.size(); ++j)
+                add_to_stubborn_set(writers[j]);
+        }
+        return;
+    }
+    int val = static_cast<int>(value);
+    assert(val >= 0 && val < achievers[var].size());
+    const vector<int> &ops = achievers[var][val];
+    for(int j = 0; j < ops.size(); ++j)
+        add_to_stubborn_set(ops[j]);
+}
+
+bool StubbornSets::find_unsatisfied_condition(int op_no, const TimeStampedState &state,
+        int &var, double &value) const
+{
+    const Operator &op = task.operators[op_no];
+    const vector<Prevail> &prevail_start = op.get_prevail_start();
+    for(int i = 0; i < prevail_start.size(); ++i) {
+        if(!double_equals(state.state[prevail_start[i].var], prevail_start[i].prev)) {
+            var = prevail_start[i].var;
+            value = prevail_start[i].prev;
+            return true;
+        }
+    }
+    const vector<PrePost> &pre_post_start = op.get_pre_post_start();
+    for(int i = 0; i < pre_post_start.size(); ++i) {
+        const PrePost &pp = pre_post_start[i];
+        if(pp.pre != -1 && !double_equals(state.state[pp.var], pp.pre)) {
+            var = pp.var;
+            value = pp.pre;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StubbornSets::prune_operators(const TimeStampedState &state,
+        vector<const Operator *> &applicable_ops)
+{
+    num_calls++;
+    num_operators_before += applicable_ops.size();
+    // Scheduled end effects and conditions of running operators are not
+    // covered by the interference relation: an end effect may destroy the
+    // start condition of a pruned operator before it is started again.
+    if(applicable_ops.size() <= 1 || !state.operators.empty()
+            || !state.scheduled_effects.empty()) {
+        num_operators_after += applicable_ops.size();
+        return;
+    }
+
+    // the stubborn set starts with the achievers of an unsatisfied goal
+    int goal_index = -1;
+    for(int i = 0; i < task.goal.size(); ++i) {
+        if(!double_equals(state.state[task.goal[i].first], task.goal[i].second)) {
+            goal_index = i;
+            break;
+        }
+    }
+    if(goal_index == -1) {
+        num_operators_after += applicable_ops.size();
+        return;
+    }
+
+    candidates.clear();
+    for(int i = 0; i < applicable_ops.size(); ++i) {
+        candidates.push_back(get_op_index(applicable_ops[i]));
+        applicable_mark[candidates.back()] = 0;  // unknown
+    }
+    add_achievers(task.goal[goal_index].first, task.goal[goal_index].second);
+
+    bool prune = true;
+    while(!queue.empty()) {
+        int op_no = queue.back();
+        queue.pop_back();
+        if(applicable_mark[op_no] == 0) {
+            applicable_mark[op_no] = task.operators[op_no].is_applicable(state) ? 1 : -2;
+        }
+        if(applicable_mark[op_no] == 1) {
+            add_interfering(op_no);
+        } else {
+            int var;
+            double value;
+            if(!find_unsatisfied_condition(op_no, state, var, value)) {
+                // inapplicable because of running operators, we can't reason about that
+                prune = false;
+                break;
+            }
+            add_achievers(var, value);
+        }
+    }
+
+    if(prune) {
+        vector<const Operator *> pruned_ops;
+        for(int i = 0; i < applicable_ops.size(); ++i) {
+            if(in_stubborn_set[get_op_index(applicable_ops[i])])
+                pruned_ops.push_back(applicable_ops[i]);
+        }
+        applicable_ops.swap(pruned_ops);
+    }
+    num_operators_after += applicable_ops.size();
+
+    // reset per call data
+    queue.clear();
+    for(int i = 0; i < touched.size(); ++i)
+        in_stubborn_set[touched[i]] = false;
+    touched.clear();
+    for(int i = 0; i < candidates.size(); ++i)
+        applicable_mark[candidates[i]] = -1;
+}
+
+void StubbornSets::dump_statistics() const
+{
+    cout << "Stubborn sets: " << num_calls << " expansion(s), "
+        << num_operators_before << " operator(s) before, "
+        << num_operators_after << " after pruning";
+    if(num_operators_before > 0) {
+        cout << " (" << 100.0 * (num_operators_before - num_operators_after)
+            / num_operators_before << "% pruned)";
+    }
+    cout << endl;
+}
@@ -0,0 +1,71 @@
+#ifndef STUBBORN_SETS_H
+#define STUBBORN_SETS_H
+
+#include <vector>
+#include "globals.h"
+
+class Operator;
+class TimeStampedState;
+
+/// Strong stubborn set pruning for starting operators.
+/**
+ * The interference relation is derived from the variables operators read
+ * (start/overall/end conditions, effect conditions, duration and numeric
+ * effect arguments) and write (start and end effects). Two operators
+ * interfere if one writes a variable the other reads or writes. Conditions
+ * on derived variables are mapped to the non-derived variables they depend
+ * on via the axioms.
+ *
+ * let_time_pass is never pruned, only operator starts are. Pruning is
+ * only done in states without running operators and scheduled effects,
+ * since those change the state independently of the operators started.
+ * If an operator in the stubborn set is inapplicable without an
+ * unsatisfied start condition, no pruning is done either.
+ */
+class StubbornSets
+{
+    private:
+        const Task &task;
+        std::vector<std::vector<int> > base_vars;   ///< non-derived variables each variable depends on
+        std::vector<std::vector<int> > reads;       ///< per operator, sorted base variables read
+        std::vector<std::vector<int> > writes;      ///< per operator, sorted variables written
+        std::vector<std::vector<int> > readers_of;  ///< per variable, operators reading it
+        std::vector<std::vector<int> > writers_of;  ///< per variable, operators writing it
+        std::vector<std::vector<std::vector<int> > > achievers;  ///< [var][val] -> operators setting var to val
+
+        // per call data, kept to avoid reallocations
+        std::vector<bool> in_stubborn_set;
+        std::vector<int> applicable_mark;       ///< 1 applicable, -2 not, 0 unknown, -1 not generated
+        std::vector<int> queue;
+        std::vector<int> touched;               ///< operators added to the stubborn set
+        std::vector<int> candidates;            ///< operators from the successor generator
+
+        unsigned long num_calls;
+        unsigned long num_operators_before;
+        unsigned long num_operators_after;
+
+        int get_op_index(const Operator *op) const;
+        void add_var_closure(int var, std::vector<int> &vars) const;
+        void add_to_stubborn_set(int op_no);
+        void add_interfering(int op_no);
+        /// Add achievers of var = value, for derived variables writers of the base variables.
+        void add_achievers(int var, double value);
+        /// Find an unsatisfied start condition of op_no, false if there is none.
+        bool find_unsatisfied_condition(int op_no, const TimeStampedState &state,
+                int &var, double &value) const;
+
+    public:
+        StubbornSets(const Task &task);
+
+        /// Remove operators from applicable_ops that are not in a stubborn set for state.
+        /**
+         * applicable_ops may be a superset of the applicable operators
+         * (as computed by the successor generator).
+         */
+        void prune_operators(const TimeStampedState &state,
+                std::vector<const Operator *> &applicable_ops);
+
+        void dump_statistics() const;
+};
+
+#endif
@@ -1,102 +1,160 @@
 #include "globals.h"
+#include "instrumentation.h"
 #include "operator.h"
 #include "state.h"
 #include "successor_generator.h"
+#include "task_reader.h"
 
 #include <cstdlib>
 #include <iostream>
 #include <vector>
 using namespace std;
 
-class SuccessorGeneratorSwitch : public SuccessorGenerator
+SuccessorGenerator::SuccessorGenerator(const Task &task, TaskReader &in, bool check_conditions) :
+    task(task), check_start_conditions(check_conditions)
 {
-    int switch_var;
-    SuccessorGenerator *immediate_ops;
-    vector<SuccessorGenerator *> generator_for_value;
-    SuccessorGenerator *default_generator;
-    public:
-        SuccessorGeneratorSwitch(istream &in);
-        virtual void generate_applicable_ops(const TimeStampedState &curr,
-            vector<const Operator *> &ops);
-        virtual void _dump(string indent);
-};
+    Node empty = {-1, 0, 0, 0, EMPTY_NODE};
+    nodes.push_back(empty);
+    condition_offsets.push_back(0);
+    vector<int> path_values(task.variable_domain.size(), -1);
+    root = read_node(in, path_values);
+}
 
-class SuccessorGeneratorGenerate : public SuccessorGenerator
+/// Read a generator statement, return the index of its node.
+/**
+ * path_values contains the value of each variable that the switches
+ * leading to this generator imply (-1 if none).
+ */
+int SuccessorGenerator::read_node(TaskReader &in, vector<int> &path_values)
 {
-    vector<const Operator *> op;
-    public:
-        SuccessorGeneratorGenerate(istream &in);
-        virtual void generate_applicable_ops(const TimeStampedState &curr,
-            vector<const Operator *> &ops);
-        virtual void _dump(string indent);
-};
+    string type;
+    in >> type;
+    if(type == "check") {
+        int ops_begin = op_pool.size();
+        read_operators(in, path_values);
+        if(op_pool.size() == ops_begin)
+            return EMPTY_NODE;
+        Node leaf = {-1, ops_begin, static_cast<int>(op_pool.size()), 0, EMPTY_NODE};
+        nodes.push_back(leaf);
+        return nodes.size() - 1;
+    } else if(type == "switch") {
+        Node node;
+        in >> node.switch_var;
+        check_magic(in, "check");
+        node.ops_begin = op_pool.size();
+        read_operators(in, path_values);
+        node.ops_end = op_pool.size();
 
-SuccessorGeneratorSwitch::SuccessorGeneratorSwitch(istream &in)
-{
-    cin >> switch_var;
-    immediate_ops = read_successor_generator(in);
-    for(int i = 0; i < g_variable_domain[switch_var]; i++)
-        generator_for_value.push_back(read_successor_generator(in));
-    default_generator = read_successor_generator(in);
-}
+        // reserve the children before reading them, their subtrees are
+        // appended behind them
+        int node_no = nodes.size();
+        int num_values = task.variable_domain[node.switch_var];
+        node.first_child = child_pool.size();
+        child_pool.resize(child_pool.size() + num_values);
+        nodes.push_back(node);
 
-void SuccessorGeneratorSwitch::generate_applicable_ops(
-        const TimeStampedState &curr, vector<const Operator *> &ops)
-{
-    immediate_ops->generate_applicable_ops(curr, ops);
-    generator_for_value[static_cast<int>(curr[switch_var])]->generate_applicable_ops(curr, ops);
-    default_generator->generate_applicable_ops(curr, ops);
-}
+        int old_value = path_values[node.switch_var];
+        bool empty = node.ops_begin == node.ops_end;
+        for(int value = 0; value < num_values; value++) {
+            path_values[node.switch_var] = value;
+            int child = read_node(in, path_values);
+            child_pool[node.first_child + value] = child;
+            empty = empty && child == EMPTY_NODE;
+        }
+        path_values[node.switch_var] = old_value;
+        int default_child = read_node(in, path_values);
+        nodes[node_no].default_child = default_child;
+        empty = empty && default_child == EMPTY_NODE;
 
-void SuccessorGeneratorSwitch::_dump(string indent)
-{
-    cout << indent << "switch on " << g_variable_name[switch_var] << endl;
-    cout << indent << "immediately:" << endl;
-    immediate_ops->_dump(indent + "  ");
-    for(int i = 0; i < g_variable_domain[switch_var]; i++) {
-        cout << indent << "case " << i << ":" << endl;
-        generator_for_value[i]->_dump(indent + "  ");
+        // all children were empty, so nothing was appended behind this node
+        if(empty) {
+            assert(nodes.size() == node_no + 1);
+            nodes.pop_back();
+            child_pool.resize(node.first_child);
+            return EMPTY_NODE;
+        }
+        return node_no;
     }
-    cout << indent << "always:" << endl;
-    default_generator->_dump(indent + "  ");
-}
-
-void SuccessorGeneratorGenerate::generate_applicable_ops(
-        const TimeStampedState &, vector<const Operator *> &ops)
-{
-    ops.insert(ops.end(), op.begin(), op.end());
+    cout << "Illegal successor generator statement!" << endl;
+    cout << "Expected 'switch' or 'check', got '" << type << "'." << endl;
+    exit(1);
 }
 
-SuccessorGeneratorGenerate::SuccessorGeneratorGenerate(istream &in)
+/// Read the operators of a "check" statement into op_pool.
+void SuccessorGenerator::read_operators(TaskReader &in, const vector<int> &path_values)
 {
     int count;
-    cin >> count;
+    in >> count;
     for(int i = 0; i < count; i++) {
         int op_index;
         in >> op_index;
-        op.push_back(&g_operators[op_index]);
+        op_pool.push_back(op_index);
+
+        const Operator &op = task.operators[op_index];
+        const vector<Prevail> &prevail = op.get_prevail_start();
+        for(int j = 0; j < prevail.size(); j++)
+            if(path_values[prevail[j].var] != prevail[j].prev)
+                conditions.push_back(prevail[j]);
+        const vector<PrePost> &pre_post = op.get_pre_post_start();
+        for(int j = 0; j < pre_post.size(); j++)
+            if(pre_post[j].pre != -1 && path_values[pre_post[j].var] != pre_post[j].pre)
+                conditions.push_back(Prevail(pre_post[j].var, pre_post[j].pre));
+        condition_offsets.push_back(conditions.size());
     }
 }
 
-void SuccessorGeneratorGenerate::_dump(string indent)
+void SuccessorGenerator::generate_applicable_ops(
+        const TimeStampedState &curr, vector<const Operator *> &ops)
 {
-    for(int i = 0; i < op.size(); i++) {
-        cout << indent;
-        op[i]->dump();
+    INSTRUMENT_PHASE(curr.get_context().instrumentation, phase_successor_generation);
+    // Children are pushed in reverse, so the operators come out in the
+    // order of the recursive tree: immediate, value, default.
+    stack.clear();
+    stack.push_back(root);
+    while(!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+
+        for(int i = node.ops_begin; i < node.ops_end; i++) {
+            if(check_start_conditions) {
+                bool holds = true;
+                for(int j = condition_offsets[i]; holds && j < condition_offsets[i + 1]; j++)
+                    holds = conditions[j].is_applicable(curr);
+                if(!holds)
+                    continue;
+            }
+            ops.push_back(&task.operators[op_pool[i]]);
+            INSTRUMENT_COUNT(curr.get_context().instrumentation, phase_successor_generation, 1);
+        }
+
+        if(node.switch_var != -1) {
+            int value_child = child_pool[node.first_child + static_cast<int>(curr[node.switch_var])];
+            if(node.default_child != EMPTY_NODE)
+                stack.push_back(node.default_child);
+            if(value_child != EMPTY_NODE)
+                stack.push_back(value_child);
+        }
     }
 }
 
-SuccessorGenerator *read_successor_generator(istream &in)
+void SuccessorGenerator::dump_node(int node_no, const string &indent) const
 {
-    string type;
-    in >> type;
-    if(type == "switch") {
-        return new SuccessorGeneratorSwitch(in);
-    } else if(type == "check") {
-        return new SuccessorGeneratorGenerate(in);
+    const Node &node = nodes[node_no];
+    if(node.switch_var != -1) {
+        cout << indent << "switch on " << task.variable_name[node.switch_var] << endl;
+        cout << indent << "immediately:" << endl;
+    }
+    string ops_indent = node.switch_var != -1 ? indent + "  " : indent;
+    for(int i = node.ops_begin; i < node.ops_end; i++) {
+        cout << ops_indent;
+        task.operators[op_pool[i]].dump(task);
+    }
+    if(node.switch_var != -1) {
+        for(int i = 0; i < task.variable_domain[node.switch_var]; i++) {
+            cout << indent << "case " << i << ":" << endl;
+            dump_node(child_pool[node.first_child + i], indent + "  ");
+        }
+        cout << indent << "always:" << endl;
+        dump_node(node.default_child, indent + "  ");
     }
-    cout << "Illegal successor generator statement!" << endl;
-    cout << "Expected 'switch' or 'check', got '" << type << "'." << endl;
-    exit(1);
 }
-
@@ -2,26 +2,79 @@
 #define SUCCESSOR_GENERATOR_H
 
 #include <iostream>
+#include <string>
 #include <vector>
 
+#include "state.h"
+
 class Operator;
-class TimeStampedState;
+class TaskReader;
 
+/// Decision tree of the operators whose start conditions may hold in a state.
+/**
+ * The tree written by the preprocessor is compiled into flat arrays: the
+ * nodes, the children of all switch nodes and a pool of operator ids that
+ * the nodes point into. All empty generators are one shared node and
+ * switches without any operators below them are dropped. Generating the
+ * operators walks the tree iteratively, in the same order as the
+ * preprocessor's tree.
+ *
+ * The tree only switches on the discrete start conditions of the
+ * operators (prevail_start and the preconditions of pre_post_start)
+ * that it can, so it returns a superset of the operators whose start
+ * conditions hold. If start conditions are checked (option c), the start
+ * conditions that are not implied by the path to an operator are checked
+ * as well and only operators whose start conditions hold are returned.
+ */
 class SuccessorGenerator
 {
+    struct Node
+    {
+        int switch_var;     ///< -1 for a leaf
+        int ops_begin;      ///< operators [ops_begin, ops_end) of op_pool
+        int ops_end;
+        int first_child;    ///< children of a switch node: one per value in child_pool
+        int default_child;  ///< generator for all values of switch_var
+    };
+    /// Index of the shared empty generator.
+    static const int EMPTY_NODE = 0;
+
+    const Task &task;
+    std::vector<Node> nodes;
+    std::vector<int> child_pool;
+    std::vector<int> op_pool;
+    /// Start conditions of op_pool[i] not implied by its path:
+    /// [condition_offsets[i], condition_offsets[i + 1]) of conditions.
+    std::vector<int> condition_offsets;
+    std::vector<Prevail> conditions;
+    int root;
+    bool check_start_conditions;
+
+    std::vector<int> stack;
+
+    int read_node(TaskReader &in, std::vector<int> &path_values);
+    void read_operators(TaskReader &in, const std::vector<int> &path_values);
+    void dump_node(int node_no, const std::string &indent) const;
     public:
-        virtual ~SuccessorGenerator()
+        /// Read the preprocessor's tree for the operators of task.
+        /**
+         * Start conditions are checked if check_conditions is set.
+         */
+        SuccessorGenerator(const Task &task, TaskReader &in, bool check_conditions);
+
+        void generate_applicable_ops(const TimeStampedState &curr,
+                std::vector<const Operator *> &ops);
+
+        /// True if all generated operators satisfy their start conditions.
+        bool checks_start_conditions() const
         {
+            return check_start_conditions;
         }
-        virtual void generate_applicable_ops(const TimeStampedState &curr,
-                std::vector<const Operator *> &ops) = 0;
-        void dump()
+
+        void dump() const
         {
-            _dump("  ");
+            dump_node(root, "  ");
         }
-        virtual void _dump(string indent) = 0;
 };
 
-SuccessorGenerator *read_successor_generator(std::istream &in);
-
 #endif
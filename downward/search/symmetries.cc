@@ -0,0 +1,419 @@
+#include "symmetries.h"
+
+#include "axioms.h"
+#include "graph_automorphism.h"
+#include "operator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <set>
+#include <sstream>
+#include <time.h>
+
+using namespace std;
+
+/// Search node limit for the automorphism search
+static const int MAX_AUTOMORPHISM_SEARCH_NODES = 100000;
+
+Symmetries::Symmetries(const Task &task) :
+        task(task), search_limit_reached(false), num_pruned(0)
+{
+    clock_t start_time = clock();
+    ColoredGraph graph;
+    vector<int> op_vertex;
+    build_graph(graph, op_vertex);
+
+    AutomorphismFinder finder(graph, MAX_AUTOMORPHISM_SEARCH_NODES);
+    vector<vector<int> > automorphisms;
+    finder.find_generators(automorphisms);
+    search_limit_reached = finder.reached_limit();
+
+    // translate vertex permutations back to variables, values and operators
+    int num_vertices = graph.get_num_vertices();
+    vector<int> vertex_var(num_vertices, -1);
+    vector<int> vertex_value(num_vertices, -1);
+    vector<int> vertex_op(num_vertices, -1);
+    for(int var = 0; var < var_vertex.size(); ++var) {
+        vertex_var[var_vertex[var]] = var;
+        for(int val = 0; val < value_vertex[var].size(); ++val)
+            vertex_value[value_vertex[var][val]] = val;
+    }
+    for(int op_no = 0; op_no < op_vertex.size(); ++op_no)
+        vertex_op[op_vertex[op_no]] = op_no;
+
+    for(int i = 0; i < automorphisms.size(); ++i) {
+        const vector<int> &perm = automorphisms[i];
+        Generator gen;
+        bool identity = true;
+        gen.var_perm.resize(var_vertex.size());
+        gen.value_perm.resize(var_vertex.size());
+        for(int var = 0; var < var_vertex.size(); ++var) {
+            gen.var_perm[var] = vertex_var[perm[var_vertex[var]]];
+            assert(gen.var_perm[var] >= 0);
+            if(gen.var_perm[var] != var)
+                identity = false;
+            for(int val = 0; val < value_vertex[var].size(); ++val) {
+                int image = vertex_value[perm[value_vertex[var][val]]];
+                assert(image >= 0);
+                gen.value_perm[var].push_back(image);
+                if(image != val)
+                    identity = false;
+            }
+        }
+        gen.op_perm.resize(op_vertex.size());
+        for(int op_no = 0; op_no < op_vertex.size(); ++op_no) {
+            gen.op_perm[op_no] = vertex_op[perm[op_vertex[op_no]]];
+            assert(gen.op_perm[op_no] >= 0);
+            if(gen.op_perm[op_no] != op_no)
+                identity = false;
+        }
+        // only auxiliary vertices are permuted
+        if(!identity) {
+            map_end_effects(gen);
+            generators.push_back(gen);
+        }
+    }
+    color_ids.clear();
+
+    cout << "Symmetries: " << generators.size() << " generator(s) found in "
+        << double(clock() - start_time) / CLOCKS_PER_SEC << " seconds (graph with "
+        << num_vertices << " vertices, " << finder.get_search_nodes() << " search nodes";
+    if(search_limit_reached)
+        cout << ", search limit reached";
+    cout << ")" << endl;
+}
+
+int Symmetries::get_color(const string &key)
+{
+    map<string, int>::iterator it = color_ids.find(key);
+    if(it != color_ids.end())
+        return it->second;
+    int color = color_ids.size();
+    color_ids[key] = color;
+    return color;
+}
+
+void Symmetries::add_labeled_edge(ColoredGraph &graph, int from, int to, const string &label)
+{
+    int edge_vertex = graph.add_vertex(get_color("edge:" + label));
+    graph.add_edge(from, edge_vertex);
+    graph.add_edge(edge_vertex, to);
+}
+
+void Symmetries::add_condition(ColoredGraph &graph, int from, int var, double value,
+        const string &label)
+{
+    assert(var >= 0 && var < var_vertex.size());
+    int val = static_cast<int>(value);
+    if(double_equals(value, val) && val >= 0 && val < value_vertex[var].size()) {
+        add_labeled_edge(graph, from, value_vertex[var][val], label);
+    } else {
+        // values of non-logical variables are never permuted
+        ostringstream key;
+        key << label << "=" << value;
+        add_labeled_edge(graph, from, var_vertex[var], key.str());
+    }
+}
+
+void Symmetries::add_effect(ColoredGraph &graph, int op_vertex, const PrePost &eff,
+        const string &label)
+{
+    ostringstream key;
+    key << label;
+    if(task.is_functional(eff.var))
+        key << ":" << eff.fop;
+    int eff_vertex = graph.add_vertex(get_color(key.str()));
+    graph.add_edge(op_vertex, eff_vertex);
+
+    if(eff.pre != -1)
+        add_condition(graph, eff_vertex, eff.var, eff.pre, "pre");
+    if(task.is_functional(eff.var)) {
+        add_labeled_edge(graph, eff_vertex, var_vertex[eff.var], "lhs");
+        if(eff.var_post >= 0)
+            add_labeled_edge(graph, eff_vertex, var_vertex[eff.var_post], "rhs");
+    } else {
+        add_condition(graph, eff_vertex, eff.var, eff.post, "post");
+    }
+    for(int i = 0; i < eff.cond_start.size(); ++i)
+        add_condition(graph, eff_vertex, eff.cond_start[i].var, eff.cond_start[i].prev, "cond_start");
+    for(int i = 0; i < eff.cond_overall.size(); ++i)
+        add_condition(graph, eff_vertex, eff.cond_overall[i].var, eff.cond_overall[i].prev, "cond_overall");
+    for(int i = 0; i < eff.cond_end.size(); ++i)
+        add_condition(graph, eff_vertex, eff.cond_end[i].var, eff.cond_end[i].prev, "cond_end");
+}
+
+void Symmetries::build_graph(ColoredGraph &graph, vector<int> &op_vertex)
+{
+    int num_vars = task.variable_domain.size();
+    vector<bool> derived(num_vars, false);
+    for(int i = 0; i < task.axioms.size(); ++i)
+        derived[task.axioms[i]->affected_variable] = true;
+    vector<bool> written(num_vars, false);
+    for(int op_no = 0; op_no < task.operators.size(); ++op_no) {
+        const Operator &op = task.operators[op_no];
+        for(int i = 0; i < op.get_pre_post_start().size(); ++i)
+            written[op.get_pre_post_start()[i].var] = true;
+        for(int i = 0; i < op.get_pre_post_end().size(); ++i)
+            written[op.get_pre_post_end()[i].var] = true;
+    }
+    set<pair<int, double> > goals(task.goal.begin(), task.goal.end());
+
+    // variables and values
+    var_vertex.resize(num_vars);
+    value_vertex.resize(num_vars);
+    for(int var = 0; var < num_vars; ++var) {
+        bool has_values = task.variable_types[var] == logical && task.variable_domain[var] > 0;
+        ostringstream key;
+        key << "var:" << task.variable_types[var] << ":" << task.variable_domain[var]
+            << ":" << task.axiom_layers[var];
+        if(derived[var])
+            key << ":default=" << task.default_axiom_values[var];
+        if(task.variable_types[var] == primitive_functional && !derived[var] && !written[var])
+            key << ":const=" << (*task.initial_state)[var];
+        if(!has_values) {
+            for(int i = 0; i < task.goal.size(); ++i) {
+                if(task.goal[i].first == var)
+                    key << ":goal=" << task.goal[i].second;
+            }
+        }
+        var_vertex[var] = graph.add_vertex(get_color(key.str()));
+
+        if(!has_values)
+            continue;
+        for(int val = 0; val < task.variable_domain[var]; ++val) {
+            ostringstream value_key;
+            value_key << "value";
+            // derived variables have fixed default values
+            if(derived[var])
+                value_key << ":" << val;
+            if(goals.count(make_pair(var, double(val))))
+                value_key << ":goal";
+            int vertex = graph.add_vertex(get_color(value_key.str()));
+            value_vertex[var].push_back(vertex);
+            graph.add_edge(var_vertex[var], vertex);
+        }
+    }
+
+    // operators
+    op_vertex.resize(task.operators.size());
+    for(int op_no = 0; op_no < task.operators.size(); ++op_no) {
+        const Operator &op = task.operators[op_no];
+        op_vertex[op_no] = graph.add_vertex(get_color("operator"));
+        int vertex = op_vertex[op_no];
+        if(op.get_duration_var() >= 0)
+            add_labeled_edge(graph, vertex, var_vertex[op.get_duration_var()], "duration");
+        for(int i = 0; i < op.get_prevail_start().size(); ++i)
+            add_condition(graph, vertex, op.get_prevail_start()[i].var,
+                    op.get_prevail_start()[i].prev, "prevail_start");
+        for(int i = 0; i < op.get_prevail_overall().size(); ++i)
+            add_condition(graph, vertex, op.get_prevail_overall()[i].var,
+                    op.get_prevail_overall()[i].prev, "prevail_overall");
+        for(int i = 0; i < op.get_prevail_end().size(); ++i)
+            add_condition(graph, vertex, op.get_prevail_end()[i].var,
+                    op.get_prevail_end()[i].prev, "prevail_end");
+        for(int i = 0; i < op.get_pre_post_start().size(); ++i)
+            add_effect(graph, vertex, op.get_pre_post_start()[i], "effect_start");
+        for(int i = 0; i < op.get_pre_post_end().size(); ++i)
+            add_effect(graph, vertex, op.get_pre_post_end()[i], "effect_end");
+    }
+
+    // axioms
+    for(int i = 0; i < task.axioms.size(); ++i) {
+        int var = task.axioms[i]->affected_variable;
+        if(task.variable_types[var] == logical) {
+            const LogicAxiom *axiom = static_cast<const LogicAxiom *>(task.axioms[i]);
+            int vertex = graph.add_vertex(get_color("logic_axiom"));
+            for(int j = 0; j < axiom->prevail.size(); ++j)
+                add_condition(graph, vertex, axiom->prevail[j].var, axiom->prevail[j].prev, "axiom_pre");
+            if(axiom->old_value != -1)
+                add_condition(graph, vertex, var, axiom->old_value, "axiom_old");
+            add_condition(graph, vertex, var, axiom->new_value, "axiom_new");
+        } else {
+            const NumericAxiom *axiom = static_cast<const NumericAxiom *>(task.axioms[i]);
+            ostringstream key;
+            key << "numeric_axiom:" << axiom->op;
+            int vertex = graph.add_vertex(get_color(key.str()));
+            add_labeled_edge(graph, vertex, var_vertex[var], "axiom_result");
+            if(axiom->var_lhs >= 0)
+                add_labeled_edge(graph, vertex, var_vertex[axiom->var_lhs], "axiom_lhs");
+            if(axiom->var_rhs >= 0)
+                add_labeled_edge(graph, vertex, var_vertex[axiom->var_rhs], "axiom_rhs");
+        }
+    }
+    graph.finalize();
+}
+
+double Symmetries::map_value(const Generator &gen, int var, double value) const
+{
+    const vector<int> &perm = gen.value_perm[var];
+    int val = static_cast<int>(value);
+    if(perm.empty() || !double_equals(value, val) || val < 0 || val >= perm.size())
+        return value;
+    return perm[val];
+}
+
+Prevail Symmetries::map_prevail(const Generator &gen, const Prevail &prev) const
+{
+    return Prevail(gen.var_perm[prev.var], map_value(gen, prev.var, prev.prev));
+}
+
+PrePost Symmetries::map_effect(const Generator &gen, const PrePost &eff) const
+{
+    PrePost mapped(eff);
+    mapped.var = gen.var_perm[eff.var];
+    if(eff.pre != -1)
+        mapped.pre = map_value(gen, eff.var, eff.pre);
+    if(task.is_functional(eff.var)) {
+        if(eff.var_post >= 0)
+            mapped.var_post = gen.var_perm[eff.var_post];
+    } else {
+        mapped.post = map_value(gen, eff.var, eff.post);
+    }
+    for(int j = 0; j < eff.cond_start.size(); ++j)
+        mapped.cond_start[j] = map_prevail(gen, eff.cond_start[j]);
+    for(int j = 0; j < eff.cond_overall.size(); ++j)
+        mapped.cond_overall[j] = map_prevail(gen, eff.cond_overall[j]);
+    for(int j = 0; j < eff.cond_end.size(); ++j)
+        mapped.cond_end[j] = map_prevail(gen, eff.cond_end[j]);
+    return mapped;
+}
+
+/// Intern the image of every scheduled effect there can be, once per generator.
+void Symmetries::map_end_effects(Generator &gen) const
+{
+    for(int op_no = 0; op_no < task.operators.size(); ++op_no) {
+        const vector<const PrePost *> &effects = task.operators[op_no].get_end_effects();
+        for(int i = 0; i < effects.size(); ++i) {
+            if(!gen.effect_perm.count(effects[i]))
+                gen.effect_perm[effects[i]] = task.effect_pool->intern(map_effect(gen, *effects[i]));
+        }
+    }
+}
+
+void Symmetries::apply(const Generator &gen, const TimeStampedState &state,
+        TimeStampedState &result) const
+{
+    result.state.resize(state.state.size());
+    for(int var = 0; var < state.state.size(); ++var)
+        result.state[gen.var_perm[var]] = map_value(gen, var, state.state[var]);
+
+    result.scheduled_effects.clear();
+    for(int i = 0; i < state.scheduled_effects.size(); ++i) {
+        const PrePost *eff = state.scheduled_effects[i].effect;
+        std::tr1::unordered_map<const PrePost *, const PrePost *>::const_iterator image =
+            gen.effect_perm.find(eff);
+        // all scheduled effects are end effects of operators
+        assert(image != gen.effect_perm.end());
+        result.scheduled_effects.push_back(ScheduledEffect(
+                    state.scheduled_effects[i].time, image->second));
+    }
+    sort(result.scheduled_effects.begin(), result.scheduled_effects.end());
+
+    result.conds_over_all.clear();
+    for(int i = 0; i < state.conds_over_all.size(); ++i) {
+        const ScheduledCondition &cond = state.conds_over_all[i];
+        result.conds_over_all.push_back(ScheduledCondition(cond.time,
+                    map_prevail(gen, cond)));
+    }
+    sort(result.conds_over_all.begin(), result.conds_over_all.end());
+
+    result.conds_at_end.clear();
+    for(int i = 0; i < state.conds_at_end.size(); ++i) {
+        const ScheduledCondition &cond = state.conds_at_end[i];
+        result.conds_at_end.push_back(ScheduledCondition(cond.time,
+                    map_prevail(gen, cond)));
+    }
+    sort(result.conds_at_end.begin(), result.conds_at_end.end());
+
+    result.operators.clear();
+    for(int i = 0; i < state.operators.size(); ++i) {
+        const ScheduledOperator &op = state.operators[i];
+        if(op.get_id() < 0) {
+            result.operators.push_back(op);
+        } else {
+            result.operators.push_back(ScheduledOperator(op.time,
+                        task.operators[gen.op_perm[op.get_id()]]));
+        }
+    }
+
+    result.timestamp = state.timestamp;
+    result.numberOfEpsInsertions = state.numberOfEpsInsertions;
+}
+
+bool Symmetries::is_smaller(const TimeStampedState &state1, const TimeStampedState &state2) const
+{
+    // only the variables compared by TssEquals
+    for(int var = 0; var < state1.state.size(); ++var) {
+        if(!(task.variable_types[var] == primitive_functional || task.variable_types[var] == logical))
+            continue;
+        if(!double_equals(state1.state[var], state2.state[var]))
+            return state1.state[var] < state2.state[var];
+    }
+    if(lexicographical_compare(state1.scheduled_effects.begin(), state1.scheduled_effects.end(),
+                state2.scheduled_effects.begin(), state2.scheduled_effects.end()))
+        return true;
+    if(lexicographical_compare(state2.scheduled_effects.begin(), state2.scheduled_effects.end(),
+                state1.scheduled_effects.begin(), state1.scheduled_effects.end()))
+        return false;
+    if(lexicographical_compare(state1.conds_over_all.begin(), state1.conds_over_all.end(),
+                state2.conds_over_all.begin(), state2.conds_over_all.end()))
+        return true;
+    if(lexicographical_compare(state2.conds_over_all.begin(), state2.conds_over_all.end(),
+                state1.conds_over_all.begin(), state1.conds_over_all.end()))
+        return false;
+    return lexicographical_compare(state1.conds_at_end.begin(), state1.conds_at_end.end(),
+            state2.conds_at_end.begin(), state2.conds_at_end.end());
+}
+
+void Symmetries::canonicalize(TimeStampedState &state) const
+{
+    if(generators.empty())
+        return;
+    TimeStampedState candidate(state);
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(int i = 0; i < generators.size(); ++i) {
+            apply(generators[i], state, candidate);
+            if(is_smaller(candidate, state)) {
+                swap(state, candidate);
+                changed = true;
+            }
+        }
+    }
+}
+
+bool Symmetries::is_symmetric_duplicate(const TimeStampedState &state)
+{
+    if(generators.empty())
+        return false;
+    TimeStampedState canonical(state);
+    canonicalize(canonical);
+    // running operators are not compared by TssEquals
+    canonical.operators.clear();
+
+    CanonicalClosedList::iterator it = canonical_closed.find(canonical);
+    if(it == canonical_closed.end()) {
+        canonical_closed.insert(make_pair(canonical, state.timestamp));
+        return false;
+    }
+    // same test as ClosedList::contains
+    if(!(state.timestamp - it->second + EPSILON < 0)) {
+        num_pruned++;
+        return true;
+    }
+    it->second = state.timestamp;
+    return false;
+}
+
+void Symmetries::clear()
+{
+    canonical_closed.clear();
+}
+
+void Symmetries::dump_statistics() const
+{
+    cout << "Symmetries: " << generators.size() << " generator(s), "
+        << num_pruned << " symmetric state(s) pruned, "
+        << canonical_closed.size() << " canonical state(s) stored" << endl;
+}
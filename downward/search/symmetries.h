@@ -0,0 +1,84 @@
+#ifndef SYMMETRIES_H
+#define SYMMETRIES_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+#include "closed_list.h"
+#include "state.h"
+#include "globals.h"
+
+class ColoredGraph;
+
+/// Structural symmetries of the task used for duplicate pruning.
+/**
+ * The problem description graph has vertices for variables, values of
+ * logical variables, operators, their effects and the axioms. Goals and
+ * numeric variables that are never changed (constants) are part of the
+ * vertex colors. Each automorphism of that graph permutes variables,
+ * values and operators such that the task is mapped to itself.
+ *
+ * States (including scheduled effects, conditions and running operators)
+ * are mapped to a canonical representative of their orbit by greedily
+ * applying generators while the state gets lexicographically smaller.
+ */
+class Symmetries
+{
+    private:
+        struct Generator
+        {
+            std::vector<int> var_perm;
+            std::vector<std::vector<int> > value_perm;  ///< empty if values are not permuted
+            std::vector<int> op_perm;
+            /// Images of the interned end effects of all operators.
+            std::tr1::unordered_map<const PrePost *, const PrePost *> effect_perm;
+        };
+
+        const Task &task;
+        std::vector<Generator> generators;
+        bool search_limit_reached;
+
+        typedef std::tr1::unordered_map<TimeStampedState, double, TssHash, TssEquals> CanonicalClosedList;
+        CanonicalClosedList canonical_closed; ///< canonical state -> min. timestamp
+
+        unsigned long num_pruned;
+
+        // graph construction
+        std::map<std::string, int> color_ids;
+        std::vector<int> var_vertex;
+        std::vector<std::vector<int> > value_vertex;
+        int get_color(const std::string &key);
+        void add_labeled_edge(ColoredGraph &graph, int from, int to, const std::string &label);
+        void add_condition(ColoredGraph &graph, int from, int var, double value, const std::string &label);
+        void add_effect(ColoredGraph &graph, int op_vertex, const PrePost &eff, const std::string &label);
+        void build_graph(ColoredGraph &graph, std::vector<int> &op_vertex);
+
+        double map_value(const Generator &gen, int var, double value) const;
+        Prevail map_prevail(const Generator &gen, const Prevail &prev) const;
+        PrePost map_effect(const Generator &gen, const PrePost &eff) const;
+        void map_end_effects(Generator &gen) const;
+        void apply(const Generator &gen, const TimeStampedState &state, TimeStampedState &result) const;
+        /// Compare by state variables first, then by scheduled effects and conditions.
+        bool is_smaller(const TimeStampedState &state1, const TimeStampedState &state2) const;
+
+    public:
+        Symmetries(const Task &task);
+
+        int get_num_generators() const { return generators.size(); }
+
+        /// Replace state by the canonical representative of its orbit.
+        void canonicalize(TimeStampedState &state) const;
+
+        /// Check whether a symmetric state has been seen with an earlier or equal timestamp.
+        /**
+         * Otherwise the canonical state is recorded and false is returned.
+         */
+        bool is_symmetric_duplicate(const TimeStampedState &state);
+
+        void clear();
+
+        void dump_statistics() const;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "task_reader.h"
+
+#include <climits>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const size_t READ_BLOCK_SIZE = 1 << 20;
+
+TaskBuffer::TaskBuffer(istream &in, int fd) :
+    data(0), size(0), mapped(false), owns_data(true)
+{
+    struct stat file_stat;
+    if(fd >= 0 && fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode)
+            && file_stat.st_size > 0) {
+        void *mapping = mmap(0, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED) {
+            data = static_cast<const char *>(mapping);
+            size = file_stat.st_size;
+            mapped = true;
+            return;
+        }
+    }
+    size_t capacity = READ_BLOCK_SIZE;
+    char *buffer = static_cast<char *>(malloc(capacity));
+    streambuf *input = in.rdbuf();
+    while(buffer) {
+        size += input->sgetn(buffer + size, capacity - size);
+        if(size < capacity)
+            break;
+        capacity *= 2;
+        buffer = static_cast<char *>(realloc(buffer, capacity));
+    }
+    if(!buffer) {
+        cout << "Could not allocate memory for the task." << endl;
+        exit(1);
+    }
+    data = buffer;
+}
+
+TaskBuffer::TaskBuffer(const char *buffer, size_t buffer_size) :
+    data(buffer), size(buffer_size), mapped(false), owns_data(false)
+{
+}
+
+TaskBuffer::~TaskBuffer()
+{
+    if(mapped)
+        munmap(const_cast<char *>(data), size);
+    else if(owns_data)
+        free(const_cast<char *>(data));
+}
+
+/// Powers of ten that are exact doubles.
+static const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MAX_EXACT_POWER = 22;
+/// Mantissas with at most that many digits are exact doubles.
+static const int MAX_EXACT_DIGITS = 15;
+
+static inline bool is_space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool parse_int(const char *begin, const char *end, int &value)
+{
+    const char *p = begin;
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if(p == end)
+        return false;
+    unsigned int limit = negative ? static_cast<unsigned int>(INT_MAX) + 1 : INT_MAX;
+    unsigned int result = 0;
+    for(; p != end; p++) {
+        if(!is_digit(*p))
+            return false;
+        unsigned int digit = *p - '0';
+        if(result > (limit - digit) / 10)
+            return false;
+        result = result * 10 + digit;
+    }
+    value = static_cast<int>(negative ? 0u - result : result);
+    return true;
+}
+
+bool parse_double(const char *begin, const char *end, double &value)
+{
+    const char *p = begin;
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    double mantissa = 0;    // exact while it has at most MAX_EXACT_DIGITS digits
+    int digits = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    for(; p != end && is_digit(*p); p++) {
+        if(mantissa != 0 || *p != '0')
+            digits++;
+        mantissa = mantissa * 10 + (*p - '0');
+        any_digit = true;
+        if(digits > MAX_EXACT_DIGITS)
+            return false;
+    }
+    if(p != end && *p == '.') {
+        for(p++; p != end && is_digit(*p); p++) {
+            if(mantissa != 0 || *p != '0')
+                digits++;
+            mantissa = mantissa * 10 + (*p - '0');
+            exponent--;
+            any_digit = true;
+            if(digits > MAX_EXACT_DIGITS)
+                return false;
+        }
+    }
+    if(!any_digit)
+        return false;
+    if(p != end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negative_exponent = false;
+        if(p != end && (*p == '-' || *p == '+')) {
+            negative_exponent = *p == '-';
+            p++;
+        }
+        if(p == end)
+            return false;
+        int explicit_exponent = 0;
+        for(; p != end; p++) {
+            if(!is_digit(*p) || explicit_exponent > 1000)
+                return false;
+            explicit_exponent = explicit_exponent * 10 + (*p - '0');
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+    if(p != end || exponent < -MAX_EXACT_POWER || exponent > MAX_EXACT_POWER)
+        return false;
+    double result = mantissa;
+    if(exponent < 0)
+        result /= POWERS_OF_TEN[-exponent];
+    else
+        result *= POWERS_OF_TEN[exponent];
+    value = negative ? -result : result;
+    return true;
+}
+
+TextTaskReader::TextTaskReader(istream &in, int fd) :
+    buffer(in, fd), data(buffer.get_data()), size(buffer.get_size()), pos(0)
+{
+}
+
+TextTaskReader::TextTaskReader(const char *task, size_t task_size) :
+    buffer(task, task_size), data(buffer.get_data()), size(buffer.get_size()), pos(0)
+{
+}
+
+void TextTaskReader::skip_whitespace()
+{
+    while(pos < size && is_space(data[pos]))
+        pos++;
+}
+
+void TextTaskReader::next_word(const char *&word, size_t &length)
+{
+    skip_whitespace();
+    if(pos == size) {
+        cout << "Unexpected end of task." << endl;
+        exit(1);
+    }
+    size_t start = pos;
+    while(pos < size && !is_space(data[pos]))
+        pos++;
+    word = data + start;
+    length = pos - start;
+}
+
+void TextTaskReader::syntax_error(const char *expected, const char *word, size_t length)
+{
+    cout << "Expected " << expected << " in task, got '" << string(word, length) << "'." << endl;
+    exit(1);
+}
+
+int TextTaskReader::read_int()
+{
+    const char *word;
+    size_t length;
+    next_word(word, length);
+    int value;
+    if(parse_int(word, word + length, value))
+        return value;
+    // values written as doubles are converted
+    double double_value;
+    if(parse_double(word, word + length, double_value))
+        return static_cast<int>(double_value);
+    syntax_error("an integer", word, length);
+    return 0;
+}
+
+double TextTaskReader::read_double()
+{
+    const char *word;
+    size_t length;
+    next_word(word, length);
+    double value;
+    if(parse_double(word, word + length, value))
+        return value;
+    string copy(word, length);
+    char *end;
+    value = strtod(copy.c_str(), &end);
+    if(end == copy.c_str() || *end != '\0')
+        syntax_error("a number", word, length);
+    return value;
+}
+
+string TextTaskReader::read_string()
+{
+    const char *word;
+    size_t length;
+    next_word(word, length);
+    return string(word, length);
+}
+
+string TextTaskReader::read_line()
+{
+    skip_whitespace();
+    size_t start = pos;
+    while(pos < size && data[pos] != '\n')
+        pos++;
+    string line(data + start, pos - start);
+    if(pos < size)
+        pos++;
+    return line;
+}
@@ -0,0 +1,111 @@
+#ifndef TASK_READER_H
+#define TASK_READER_H
+
+#include <iostream>
+#include <string>
+
+/// Input of the preprocessed task for the search.
+/**
+ * All readers (read_everything and the constructors taking a TaskReader)
+ * take their input from this interface, so they do not depend on where
+ * the task comes from.
+ */
+class TaskReader
+{
+    public:
+        virtual ~TaskReader()
+        {
+        }
+        virtual int read_int() = 0;
+        virtual double read_double() = 0;
+        /// Next whitespace separated word.
+        virtual std::string read_string() = 0;
+        /// Rest of the current line that may contain spaces (operator names).
+        virtual std::string read_line() = 0;
+
+        TaskReader &operator>>(int &value)
+        {
+            value = read_int();
+            return *this;
+        }
+        TaskReader &operator>>(double &value)
+        {
+            value = read_double();
+            return *this;
+        }
+        TaskReader &operator>>(bool &value)
+        {
+            value = read_int() != 0;
+            return *this;
+        }
+        TaskReader &operator>>(std::string &value)
+        {
+            value = read_string();
+            return *this;
+        }
+};
+
+/// The whole task input in memory.
+/**
+ * Regular files are mapped into memory, other inputs (pipes) are read in
+ * large blocks once.
+ */
+class TaskBuffer
+{
+    const char *data;
+    size_t size;
+    bool mapped;
+    bool owns_data;
+    public:
+        /// Map the regular file fd, or read everything from in if that is not possible.
+        TaskBuffer(std::istream &in, int fd);
+        /// Use a buffer owned by the caller that outlives this object.
+        TaskBuffer(const char *buffer, size_t buffer_size);
+        ~TaskBuffer();
+        const char *get_data() const
+        {
+            return data;
+        }
+        size_t get_size() const
+        {
+            return size;
+        }
+};
+
+/// Classic whitespace separated text format.
+/**
+ * Words are found in the TaskBuffer without copying and numbers are parsed
+ * by hand, which is much faster than istream >> with its locale handling
+ * and per-character virtual calls.
+ */
+class TextTaskReader : public TaskReader
+{
+    TaskBuffer buffer;
+    const char *data;
+    size_t size;
+    size_t pos;
+
+    void skip_whitespace();
+    /// Next word, exits at the end of the input.
+    void next_word(const char *&word, size_t &length);
+    void syntax_error(const char *expected, const char *word, size_t length);
+    public:
+        /// Map the regular file fd, or read everything from in if that is not possible.
+        TextTaskReader(std::istream &in, int fd);
+        /// Read from a buffer owned by the caller that outlives the reader.
+        TextTaskReader(const char *buffer, size_t buffer_size);
+        virtual int read_int();
+        virtual double read_double();
+        virtual std::string read_string();
+        virtual std::string read_line();
+};
+
+/// Hand-written number parsing of the word [begin, end).
+/**
+ * Returns false if the word is not a number. parse_double is exact: words
+ * it cannot convert exactly with double arithmetic are left to strtod.
+ */
+bool parse_int(const char *begin, const char *end, int &value);
+bool parse_double(const char *begin, const char *end, double &value);
+
+#endif
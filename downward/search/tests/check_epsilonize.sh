@@ -0,0 +1,41 @@
+#! /bin/bash
+# Compare the in-process epsilonization (epsilonize.cc) with
+# epsilonize_plan.py on the plans in epsilonize/. Both have to fail on the
+# same plans and write the same output for all others.
+#
+# usage: check_epsilonize.sh <epsilonize-check binary>
+
+CHECK="$1"
+TESTS_DIR="$(cd "$(dirname "$0")" && pwd)"
+SCRIPT="$TESTS_DIR/../epsilonize_plan.py"
+PYTHON="${PYTHON:-python}"
+TEMP_DIR="$(mktemp -d)"
+trap 'rm -rf "$TEMP_DIR"' EXIT
+
+failures=0
+for plan in "$TESTS_DIR"/epsilonize/*.plan; do
+    name="$(basename "$plan")"
+    "$PYTHON" "$SCRIPT" "$plan" > "$TEMP_DIR/expected" 2> /dev/null
+    expected_status=$?
+    "$CHECK" "$plan" > "$TEMP_DIR/actual"
+    actual_status=$?
+    if [ $expected_status -ne 0 ] || [ $actual_status -ne 0 ]; then
+        if [ $expected_status -ne 0 ] && [ $actual_status -ne 0 ]; then
+            echo "ok   $name (rejected by both)"
+        else
+            echo "FAIL $name: exit code $actual_status, epsilonize_plan.py $expected_status"
+            failures=$((failures + 1))
+        fi
+    elif diff -u "$TEMP_DIR/expected" "$TEMP_DIR/actual"; then
+        echo "ok   $name"
+    else
+        echo "FAIL $name: output differs from epsilonize_plan.py"
+        failures=$((failures + 1))
+    fi
+done
+
+if [ $failures -ne 0 ]; then
+    echo "$failures plan(s) failed."
+    exit 1
+fi
+echo "All plans passed."
@@ -0,0 +1,38 @@
+#! /bin/bash
+# Translate and preprocess the PDDL tasks in stubborn_sets/ and search them
+# with stubborn set pruning. All of them are solvable, so pruning must not
+# lose the plans.
+#
+# usage: check_stubborn_sets.sh <search binary> <preprocess binary>
+
+SEARCH="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+PREPROCESS="$(cd "$(dirname "$2")" && pwd)/$(basename "$2")"
+TESTS_DIR="$(cd "$(dirname "$0")" && pwd)"
+TRANSLATE="$TESTS_DIR/../../translate/translate.py"
+PYTHON="${PYTHON:-python}"
+OPTIONS="y Y e r O 1 C 1 P"
+TEMP_DIR="$(mktemp -d)"
+trap 'rm -rf "$TEMP_DIR"' EXIT
+
+failures=0
+for dir in "$TESTS_DIR"/stubborn_sets/*/; do
+    name="$(basename "$dir")"
+    mkdir "$TEMP_DIR/$name"
+    if ! (cd "$TEMP_DIR/$name" &&
+          PYTHONHASHSEED=0 "$PYTHON" "$TRANSLATE" \
+              "$dir/domain.pddl" "$dir/problem.pddl" &&
+          "$PREPROCESS" < output.sas &&
+          "$SEARCH" $OPTIONS p plan < output) > "$TEMP_DIR/$name.log" 2>&1; then
+        tail -20 "$TEMP_DIR/$name.log"
+        echo "FAIL $name: no plan found"
+        failures=$((failures + 1))
+    else
+        echo "ok   $name"
+    fi
+done
+
+if [ $failures -ne 0 ]; then
+    echo "$failures task(s) failed."
+    exit 1
+fi
+echo "All tasks passed."
@@ -0,0 +1,126 @@
+// Run several tasks in one process, for check_contexts.sh.
+//
+// Every task gets a SearchContext of its own. All tasks are loaded and
+// their heuristics created before the first search starts, then the tasks
+// are searched in reverse order, so data shared between the tasks would
+// change the output of a task compared to running it alone.
+//
+// The output of each task is enclosed in "Searching <task>" and
+// "Finished <task>" lines. Run with a single task, it is the output of
+// that task alone in a process.
+
+#include "../cyclic_cg_heuristic.h"
+#include "../event_stream.h"
+#include "../instrumentation.h"
+#include "../no_heuristic.h"
+#include "../planner.h"
+#include "../plannerParameters.h"
+#include "../state.h"
+#include "../task_reader.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct TaskRun
+{
+    string name;
+    Task task;
+    PlannerParameters parameters;
+    EventStream events;
+    Instrumentation instrumentation;
+    SearchContext context;
+    PlannerHeuristics heuristics;
+
+    TaskRun() :
+        context(task, parameters, events, instrumentation)
+    {
+    }
+};
+
+static string base_name(const string &path)
+{
+    string::size_type slash = path.rfind('/');
+    return slash == string::npos ? path : path.substr(slash + 1);
+}
+
+static bool load(TaskRun &run, const string &file, const string &plan_dir,
+        const vector<string> &options)
+{
+    ifstream in(file.c_str());
+    if(!in) {
+        cerr << "Could not open " << file << "." << endl;
+        return false;
+    }
+    vector<string> args(1, "context-check");
+    args.insert(args.end(), options.begin(), options.end());
+    args.push_back("p");
+    args.push_back(plan_dir + "/" + run.name);
+    vector<char *> argv;
+    for(int i = 0; i < args.size(); i++)
+        argv.push_back(const_cast<char *>(args[i].c_str()));
+
+    if(!load_task(run.context, argv.size(), &argv[0], new TextTaskReader(in, -1)))
+        return false;
+    create_heuristics(run.context, run.heuristics);
+    return true;
+}
+
+static void print_initial_estimate(const char *name, Heuristic *heuristic,
+        const TimeStampedState &state)
+{
+    if(!heuristic)
+        return;
+    double value = heuristic->evaluate(state);
+    cout << "Initial " << name << ": ";
+    if(heuristic->is_dead_end())
+        cout << "dead end" << endl;
+    else
+        cout << value << endl;
+}
+
+int main(int argc, char **argv)
+{
+    vector<string> files;
+    vector<string> options;
+    int i = 2;
+    for(; i < argc && string(argv[i]) != "--"; i++)
+        files.push_back(argv[i]);
+    for(i++; i < argc; i++)
+        options.push_back(argv[i]);
+    if(argc < 3 || files.empty()) {
+        cerr << "usage: " << argv[0] << " <plan directory> <task>... [-- <search options>]" << endl;
+        return 2;
+    }
+
+    vector<TaskRun *> runs;
+    for(int j = 0; j < files.size(); j++) {
+        runs.push_back(new TaskRun);
+        runs[j]->name = base_name(files[j]);
+        if(!load(*runs[j], files[j], argv[1], options))
+            return 2;
+    }
+
+    int exit_code = 0;
+    for(int j = runs.size() - 1; j >= 0; j--) {
+        TaskRun &run = *runs[j];
+        cout << "Searching " << run.name << endl;
+        const TimeStampedState &initial_state = *run.task.initial_state;
+        print_initial_estimate("makespan estimate", run.heuristics.makespan_heuristic,
+                initial_state);
+        print_initial_estimate("cost estimate", run.heuristics.cea_heuristic,
+                initial_state);
+        Plan best_plan;
+        int run_exit_code = run_search(run.context, run.heuristics, Plan(), best_plan);
+        cout << "Finished " << run.name << " with exit code " << run_exit_code << endl;
+        if(run_exit_code != 0)
+            exit_code = 1;
+    }
+
+    for(int j = 0; j < runs.size(); j++)
+        delete runs[j];
+    return exit_code;
+}
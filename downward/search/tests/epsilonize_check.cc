@@ -0,0 +1,22 @@
+// Epsilonize a plan file with epsilonize_plan_file, for check_epsilonize.sh.
+
+#include "../epsilonize.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    if(argc != 2) {
+        cerr << "usage: " << argv[0] << " <plan file>" << endl;
+        return 2;
+    }
+    ifstream in(argv[1]);
+    if(!in) {
+        cerr << "Could not open " << argv[1] << "." << endl;
+        return 2;
+    }
+    return epsilonize_plan_file(in, stdout) ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include "driver.h"
+#include "server.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+static int usage()
+{
+    cerr << "Usage: tfd [-i <output.sas>] <search options>" << endl
+        << "       tfd --server <socket> [--workers <n>] [--time-limit <seconds>]"
+        << " [--memory-limit <MB>]" << endl
+        << "       tfd --submit <socket> [-i <output.sas>] <search options>" << endl
+        << "       tfd --replan <requests> [-i <output.sas>] <search options>" << endl;
+    return 2;
+}
+
+/// Driver that runs preprocessing and search in one process.
+/**
+ * Reads the translated task from the given file or stdin. With --server,
+ * planning requests are served on a Unix domain socket instead (see
+ * server.h); --submit sends a task to such a server. With --replan, the
+ * task is loaded once and solved for each request (changes of the initial
+ * state and goal, see replanner.h) read from the given file or "-" for stdin.
+ */
+int main(int argc, char **argv)
+{
+    if(argc > 2 && strcmp(argv[1], "--server") == 0) {
+        string socket_path = argv[2];
+        ServerOptions options;
+        for(int i = 3; i < argc; i += 2) {
+            if(i + 1 >= argc)
+                return usage();
+            if(strcmp(argv[i], "--workers") == 0)
+                options.workers = atoi(argv[i + 1]);
+            else if(strcmp(argv[i], "--time-limit") == 0)
+                options.time_limit = atoi(argv[i + 1]);
+            else if(strcmp(argv[i], "--memory-limit") == 0)
+                options.memory_limit = atoi(argv[i + 1]);
+            else
+                return usage();
+        }
+        if(options.workers < 1)
+            return usage();
+        return run_server(socket_path, options);
+    }
+
+    string submit_socket;
+    if(argc > 2 && strcmp(argv[1], "--submit") == 0) {
+        submit_socket = argv[2];
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    string requests_name;
+    if(argc > 2 && strcmp(argv[1], "--replan") == 0) {
+        requests_name = argv[2];
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    ifstream file;
+    istream *sas_input = &cin;
+    if(argc > 2 && strcmp(argv[1], "-i") == 0) {
+        file.open(argv[2]);
+        if(!file) {
+            cerr << "Could not open " << argv[2] << ".\n";
+            return 2;
+        }
+        sas_input = &file;
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    if(!submit_socket.empty()) {
+        string options;
+        for(int i = 1; i < argc; i++)
+            options += string(i > 1 ? " " : "") + argv[i];
+        ostringstream sas_task;
+        sas_task << sas_input->rdbuf();
+        return submit_request(submit_socket, options, sas_task.str());
+    }
+
+    if(!requests_name.empty()) {
+        ifstream requests_file;
+        istream *requests = &cin;
+        if(requests_name != "-") {
+            requests_file.open(requests_name.c_str());
+            if(!requests_file) {
+                cerr << "Could not open " << requests_name << ".\n";
+                return 2;
+            }
+            requests = &requests_file;
+        } else if(sas_input == &cin) {
+            cerr << "The task must be given with -i when requests are read from stdin.\n";
+            return 2;
+        }
+        return run_replanning_pipeline(argc, argv, *sas_input, *requests);
+    }
+
+    return run_pipeline(argc, argv, *sas_input);
+}
@@ -0,0 +1,164 @@
+"""On-disk cache of translated tasks.
+
+Entries are keyed by a hash of the domain and problem files, the
+translator options and the translator itself (all translator sources,
+including the pddl package), so a changed translator never reuses stale
+results. Each entry is a directory holding the cached files.
+
+The cache can be shared by several planner processes on the same host:
+- entries are written to a private temporary directory and published by
+  an atomic rename, so readers never see partial entries;
+- readers copy the files of an entry and treat every failure (e.g. an
+  entry evicted meanwhile) as a miss;
+- eviction holds an exclusive lock on the cache and first renames the
+  entry out of the way, so it disappears atomically for readers.
+The least recently used entries are evicted once the cache is larger
+than its size limit.
+"""
+
+from __future__ import print_function
+
+import errno
+import fcntl
+import hashlib
+import os
+import shutil
+import tempfile
+import time
+
+CACHE_FORMAT = "1"
+LOCK_NAME = "lock"
+ENTRY_PREFIX = "task-"
+TEMP_PREFIX = "tmp-"
+# temporary directories older than this are left over by killed processes
+STALE_TEMP_SECONDS = 3600
+
+
+class TaskCache(object):
+    def __init__(self, directory, max_size):
+        self.directory = directory
+        self.max_size = max_size
+        try:
+            os.makedirs(directory)
+        except OSError as e:
+            if e.errno != errno.EEXIST:
+                raise
+
+    @staticmethod
+    def from_environment():
+        """Cache configured by TFD_CACHE_DIR and TFD_CACHE_MAX_MB, None if unset."""
+        directory = os.environ.get("TFD_CACHE_DIR")
+        if not directory:
+            return None
+        max_mb = int(os.environ.get("TFD_CACHE_MAX_MB", "1024"))
+        return TaskCache(directory, max_mb * 1024 * 1024)
+
+    def key(self, input_files, options, planner_files):
+        """Hash of the contents of all files and of the options."""
+        digest = hashlib.sha256()
+        digest.update(CACHE_FORMAT.encode())
+        for group in (input_files, planner_files):
+            for name in group:
+                _hash_file(digest, name)
+        for option in options:
+            digest.update(b"\0" + option.encode())
+        return digest.hexdigest()
+
+    def _entry(self, key):
+        return os.path.join(self.directory, ENTRY_PREFIX + key)
+
+    def fetch(self, key, file_names, target_dir="."):
+        """Copy the cached files to target_dir. Returns False on a miss."""
+        entry = self._entry(key)
+        try:
+            for name in file_names:
+                shutil.copyfile(os.path.join(entry, name),
+                                os.path.join(target_dir, name))
+        except (IOError, OSError):
+            return False
+        try:
+            # the entry mtime orders entries for eviction
+            os.utime(entry, None)
+        except OSError:
+            pass
+        return True
+
+    def store(self, key, file_names, source_dir="."):
+        """Add the files to the cache unless another process already did."""
+        entry = self._entry(key)
+        if os.path.isdir(entry):
+            return
+        temp = tempfile.mkdtemp(prefix=TEMP_PREFIX, dir=self.directory)
+        try:
+            for name in file_names:
+                shutil.copyfile(os.path.join(source_dir, name),
+                                os.path.join(temp, name))
+            os.chmod(temp, 0o755)
+            try:
+                os.rename(temp, entry)
+            except OSError as e:
+                # entry published by a concurrent process (non-empty target)
+                if e.errno not in (errno.EEXIST, errno.ENOTEMPTY):
+                    raise
+        finally:
+            if os.path.isdir(temp):
+                shutil.rmtree(temp, ignore_errors=True)
+        self.evict()
+
+    def evict(self):
+        """Remove least recently used entries until the cache fits its size limit."""
+        with open(os.path.join(self.directory, LOCK_NAME), "a") as lock:
+            fcntl.flock(lock, fcntl.LOCK_EX)
+            entries = []
+            total_size = 0
+            now = time.time()
+            for name in os.listdir(self.directory):
+                path = os.path.join(self.directory, name)
+                try:
+                    mtime = os.stat(path).st_mtime
+                    if name.startswith(TEMP_PREFIX):
+                        if now - mtime > STALE_TEMP_SECONDS:
+                            shutil.rmtree(path, ignore_errors=True)
+                        continue
+                    if not name.startswith(ENTRY_PREFIX):
+                        continue
+                    size = _directory_size(path)
+                except OSError:
+                    continue
+                entries.append((mtime, size, name))
+                total_size += size
+            entries.sort()
+            for mtime, size, name in entries:
+                if total_size <= self.max_size:
+                    break
+                path = os.path.join(self.directory, name)
+                trash = tempfile.mkdtemp(prefix=TEMP_PREFIX, dir=self.directory)
+                try:
+                    os.rename(path, os.path.join(trash, name))
+                except OSError:
+                    pass
+                shutil.rmtree(trash, ignore_errors=True)
+                total_size -= size
+
+
+def source_files(directory, extension=".py"):
+    """All files with extension below directory, in a stable order."""
+    result = []
+    for root, dirs, files in os.walk(directory):
+        dirs.sort()
+        for name in sorted(files):
+            if name.endswith(extension):
+                result.append(os.path.join(root, name))
+    return result
+
+
+def _hash_file(digest, name):
+    with open(name, "rb") as f:
+        content = f.read()
+    digest.update(b"\0" + str(len(content)).encode() + b"\0")
+    digest.update(content)
+
+
+def _directory_size(path):
+    return sum(os.path.getsize(os.path.join(path, name))
+               for name in os.listdir(path))
@@ -5,6 +5,7 @@ from collections import defaultdict
 
 import build_model
 import normalize  # because of "get_function_predicate"
+import pddl
 import pddl_to_prolog
 
 
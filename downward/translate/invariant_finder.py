@@ -6,6 +6,7 @@ import time
 from collections import deque, defaultdict
 
 import invariants
+import pddl
 import timers
 
 
@@ -117,10 +118,10 @@ def find_invariants(task, safe, reachable_action_params):
             candidates.append(invariant)
             seen_candidates.add(invariant)
 
-    start_time = time.clock()
+    start_time = time.process_time()
     while candidates:
         candidate = candidates.popleft()
-        if time.clock() - start_time > MAX_TIME:
+        if time.process_time() - start_time > MAX_TIME:
             print("Time limit reached, aborting invariant generation")
             return
         if candidate.check_balance(balance_checker, enqueue_func):
@@ -151,7 +152,6 @@ def useful_groups(invariants, initial_facts):
 def get_groups(task, safe=True, reachable_action_params=None):
     with timers.timing("Finding invariants"):
         invariants = list(find_invariants(task, safe, reachable_action_params))
-    invariants = sorted(invariants)
     with timers.timing("Checking invariant weight"):
         result = list(useful_groups(invariants, task.init))
     return result
@@ -112,6 +112,12 @@ class PropositionalNumericAxiom(object):
     def __str__(self):
         return self.name
 
+    def __lt__(self, other):
+        return (self.__class__.__name__, self.name) < (other.__class__.__name__, other.name)
+
+    def __eq__(self, other):
+        return (self.__class__, self.name) == (other.__class__, other.name)
+
     def __cmp__(self, other):
         return cmp((self.__class__, self.name), (other.__class__, other.name))
 
@@ -351,6 +351,9 @@ class QuantifiedCondition(Condition):
         self.parts = tuple(parts)
         self.hash = hash((self.__class__, self.parameters, self.parts))
 
+    def __hash__(self):
+        return self.hash
+
     def __eq__(self, other):
         # Compare hash first for speed reasons.
         return (self.hash == other.hash and
@@ -433,6 +436,10 @@ class Literal(Condition):
     def __hash__(self):
         return self.hash
 
+    def __lt__(self, other):
+        return (self.__class__.__name__, str(self.predicate), tuple(map(str, self.args))) < \
+            (other.__class__.__name__, str(other.predicate), tuple(map(str, other.args)))
+
     def __str__(self):
         return "%s %s(%s)" % (self.__class__.__name__, self.predicate,
                               ", ".join(map(str, self.args)))
@@ -525,6 +532,9 @@ class FunctionComparison(Condition):  # comparing numerical functions
     def _dump(self, indent="  "):
         return "%s %s" % (self.__class__.__name__, self.comparator)
 
+    def __hash__(self):
+        return self.hash
+
     def __eq__(self, other):
         # Compare hash first for speed reasons.
         return (self.hash == other.hash and
@@ -591,6 +601,9 @@ class Term(object):
     def _dump(self):
         return self.__class__.__name__
 
+    # objects are hashed by identity (only subclasses define a hash)
+    __hash__ = object.__hash__
+
     def __eq__(self, other):
         return (self.__class__ is other.__class__ and
                 self.args == other.args)
@@ -666,6 +679,9 @@ class Variable(Term):
         return (self.__class__ is other.__class__ and
                 self.name == other.name)
 
+    def __lt__(self, other):
+        return self.name < other.name
+
     def __cmp__(self, other):
         return cmp(self.name, other.name)
 
@@ -696,6 +712,9 @@ class ObjectTerm(Term):
         return (self.__class__ is other.__class__ and
                 self.name == other.name)
 
+    def __lt__(self, other):
+        return self.name < other.name
+
     def __cmp__(self, other):
         return cmp(self.name, other.name)
 
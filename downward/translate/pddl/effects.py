@@ -128,6 +128,8 @@ class Effect(object):
         self.condition = condition
         self.peffect = peffect  # literal or function assignment
 
+    __hash__ = object.__hash__
+
     def __eq__(self, other):
         return (self.__class__ is other.__class__ and
                 self.parameters == other.parameters and
@@ -121,6 +121,9 @@ class FunctionalExpression(object):
 
 
 class ArithmeticExpression(FunctionalExpression):
+    def __hash__(self):
+        return self.hash
+
     def __eq__(self, other):
         return (self.hash == other.hash and
                 self.__class__ == other.__class__ and
@@ -269,6 +272,9 @@ class PrimitiveNumericExpression(FunctionalExpression):
                 self.symbol == other.symbol and
                 self.args == other.args)
 
+    def __lt__(self, other):
+        return str(self) < str(other)
+
     def dump(self, indent="  "):
         print("%s%s" % (indent, self._dump()))
         for arg in self.args:
@@ -334,6 +340,9 @@ class FunctionAssignment(object):
     def __str__(self):
         return "%s %s %s" % (self.__class__.__name__, self.fluent, self.expression)
 
+    def __hash__(self):
+        return self.hash
+
     def __eq__(self, other):
         return (self.__class__ is other.__class__ and
                 self.hash == other.hash and
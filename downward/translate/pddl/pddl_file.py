@@ -1,6 +1,7 @@
 #! /usr/bin/env python
 # -*- coding: utf-8 -*-
 
+import builtins  # the open() of this module hides the builtin one
 import os.path
 import re
 import sys
@@ -12,7 +13,7 @@ from . import tasks
 def parse_pddl_file(type, filename):
     try:
         # return parser.parse_nested_list(file(filename))
-        return parser.parse_nested_list(open(filename))
+        return parser.parse_nested_list(builtins.open(filename))
     except IOError as e:
         raise SystemExit("Error: Could not read file: %s\nReason: %s." %
                          (e.filename, e))
@@ -38,8 +38,18 @@ class Task(object):
         return axiom
 
     def parse(domain_pddl, task_pddl):
+        return Task.from_domain(tuple(parse_domain(domain_pddl)), task_pddl)
+
+    parse = staticmethod(parse)
+
+    def from_domain(domain, task_pddl):
+        """Task for a domain parsed with parse_domain and a problem.
+
+        The domain objects become part of the task and are modified during
+        translation, so a parsed domain can only be used for one task per
+        process (plan_batch.py forks a process per problem)."""
         domain_name, requirements, constants, predicates, types, functions, actions, durative_actions, axioms \
-            = parse_domain(domain_pddl)
+            = domain
         task_name, task_domain_name, objects, init, goal = parse_task(task_pddl)
 
         assert domain_name == task_domain_name
@@ -49,7 +59,7 @@ class Task(object):
         return Task(domain_name, task_name, requirements, types, objects,
                     predicates, init, goal, actions, durative_actions, axioms, Task.FUNCTION_SYMBOLS)
 
-    parse = staticmethod(parse)
+    from_domain = staticmethod(from_domain)
 
     def dump(self):
         print("Problem %s: %s [%s]" % (self.domain_name, self.task_name,
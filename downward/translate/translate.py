@@ -10,6 +10,7 @@ import axiom_rules
 import fact_groups
 import instantiate
 import numeric_axiom_rules
+import pddl
 import sas_tasks
 import simplify
 
@@ -52,7 +53,11 @@ def strips_to_sas_dictionary(groups, num_axioms, num_axiom_map, num_fluents):
             dictionary.setdefault(axiom.effect, []).append((num_ax_count + len(groups), -2))
             num_ax_count += 1
     for axiom_effect in redundant_axioms:
-        dictionary[axiom_effect] = dictionary[num_axiom_map[axiom_effect].effect]
+        # the axiom replacing a redundant one can be redundant itself
+        target = num_axiom_map[axiom_effect].effect
+        while target in num_axiom_map:
+            target = num_axiom_map[target].effect
+        dictionary[axiom_effect] = dictionary[target]
 
     ranges = [len(group) + 1 for group in groups] + [-1] * num_ax_count
 
@@ -893,16 +898,11 @@ def write_mutex_key(mutex_key):
     invariants_file.close()
 
 
-if __name__ == "__main__":
-    # pr = cProfile.Profile()
-    # pr.enable()
-    import pddl
-
-    print("Parsing...")
+def translate(task):
+    """Translate the parsed task, writing output.sas and the .groups files."""
+    global ALLOW_CONFLICTING_EFFECTS
     import builtins
 
-    builtins.containsQuantifiedConditions = False
-    task = pddl.open()
     if task.domain_name in ["protocol", "rover"]:
         # This is, of course, a HACK HACK HACK!
         # The real issue is that ALLOW_CONFLICTING_EFFECTS = True
@@ -927,6 +927,17 @@ if __name__ == "__main__":
     out_file = open("output.sas", "a")
     out_file.write("%d\n" % containsQuantifiedConditions)
     out_file.close()
+
+
+if __name__ == "__main__":
+    # pr = cProfile.Profile()
+    # pr.enable()
+    print("Parsing...")
+    import builtins
+
+    builtins.containsQuantifiedConditions = False
+    task = pddl.open()
+    translate(task)
     # pr.disable()
     # pstats.Stats(pr).sort_stats('tottime').print_stats(25) # cumtime | tottime
 